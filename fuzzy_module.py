@@ -333,6 +333,81 @@ _quality_sim = ctrl.ControlSystemSimulation(quality_system)
 # MAIN COMPUTATION FUNCTION (Called from C++)
 # --------------------------------------------------------------------------
 
+def estimate_power(cpu_load, temp, gpu_load, vram_usage):
+    """
+    Estimate power consumption (W) from the 4 input metrics using fuzzy membership.
+    
+    Shared by compute_quality and compute_budget.
+    """
+    # First, determine fuzzy membership for each input
+    cpu_low_mem = fuzz.gaussmf(cpu_load, gmm_params['cpu_load'][0][0], gmm_params['cpu_load'][0][1] * 0.5)
+    cpu_med_mem = fuzz.gaussmf(cpu_load, gmm_params['cpu_load'][1][0], gmm_params['cpu_load'][1][1] * 0.5)
+    cpu_high_mem = fuzz.gaussmf(cpu_load, gmm_params['cpu_load'][2][0], gmm_params['cpu_load'][2][1] * 0.5)
+    
+    temp_low_mem = fuzz.gaussmf(temp, gmm_params['temperature'][0][0], gmm_params['temperature'][0][1] * 0.5)
+    temp_med_mem = fuzz.gaussmf(temp, gmm_params['temperature'][1][0], gmm_params['temperature'][1][1] * 0.5)
+    temp_high_mem = fuzz.gaussmf(temp, gmm_params['temperature'][2][0], gmm_params['temperature'][2][1] * 0.5)
+    
+    gpu_low_mem = fuzz.gaussmf(gpu_load, gmm_params['gpu_load'][0][0], gmm_params['gpu_load'][0][1] * 0.5)
+    gpu_med_mem = fuzz.gaussmf(gpu_load, gmm_params['gpu_load'][1][0], gmm_params['gpu_load'][1][1] * 0.5)
+    gpu_high_mem = fuzz.gaussmf(gpu_load, gmm_params['gpu_load'][2][0], gmm_params['gpu_load'][2][1] * 0.5)
+    
+    vram_low_mem = fuzz.gaussmf(vram_usage, gmm_params['vram_usage'][0][0], gmm_params['vram_usage'][0][1] * 0.5)
+    vram_med_mem = fuzz.gaussmf(vram_usage, gmm_params['vram_usage'][1][0], gmm_params['vram_usage'][1][1] * 0.5)
+    vram_high_mem = fuzz.gaussmf(vram_usage, gmm_params['vram_usage'][2][0], gmm_params['vram_usage'][2][1] * 0.5)
+    
+    # Calculate overall "low/medium/high" score for the system
+    # Use minimum (AND) for low (all must be low), maximum (OR) for high (any high)
+    overall_low = min(cpu_low_mem, temp_low_mem, gpu_low_mem, vram_low_mem)
+    overall_high = max(cpu_high_mem, temp_high_mem, gpu_high_mem, vram_high_mem)
+    overall_med = (cpu_med_mem + temp_med_mem + gpu_med_mem + vram_med_mem) / 4.0
+    
+    # Map to power consumption using GMM means
+    # Use dominant membership approach to avoid skewing from extreme values
+    power_low = gmm_params['power_consumption'][0][0]  # ~70W
+    power_med = gmm_params['power_consumption'][1][0]  # ~92W
+    power_high = gmm_params['power_consumption'][2][0]  # ~645W
+    
+    # Find dominant membership (highest value)
+    max_mem = max(overall_low, overall_med, overall_high)
+    
+    # Check if inputs are clearly below/above GMM means (even if membership is low)
+    cpu_below_low_mean = cpu_load < gmm_params['cpu_load'][0][0]
+    temp_below_low_mean = temp < gmm_params['temperature'][0][0]
+    gpu_below_low_mean = gpu_load < gmm_params['gpu_load'][0][0]
+    vram_below_low_mean = vram_usage < gmm_params['vram_usage'][0][0]
+    all_below_low = cpu_below_low_mean and temp_below_low_mean and gpu_below_low_mean and vram_below_low_mean
+    
+    cpu_above_high_mean = cpu_load > gmm_params['cpu_load'][2][0]
+    temp_above_high_mean = temp > gmm_params['temperature'][2][0]
+    gpu_above_high_mean = gpu_load > gmm_params['gpu_load'][2][0]
+    vram_above_high_mean = vram_usage > gmm_params['vram_usage'][2][0]
+    most_above_high = (cpu_above_high_mean and temp_above_high_mean) or (cpu_above_high_mean and gpu_above_high_mean)
+    
+    if all_below_low or (overall_low > 0.6):
+        # Clearly low - use low power
+        calculated_power = power_low
+    elif most_above_high or (overall_high > 0.8):
+        # Clearly high - use high power
+        calculated_power = power_high
+    elif overall_med > 0.4 and overall_high < 0.6:
+        # Clearly medium (medium membership is strong and high is not dominant)
+        calculated_power = power_med
+    else:
+        # Mixed case - use weighted interpolation
+        if overall_low > overall_high and overall_low > 0.3:
+            # Leaning low
+            calculated_power = power_low + (power_med - power_low) * (1 - overall_low)
+        elif overall_high > overall_low and overall_high > 0.5:
+            # Leaning high
+            calculated_power = power_med + (power_high - power_med) * overall_high
+        else:
+            # Balanced or unclear - use medium
+            calculated_power = power_med
+    
+    return calculated_power
+
+
 def compute_quality(cpu_load, temp, gpu_load, vram_usage, motion_intensity):
     """
     Compute fuzzy quality score based on 4 input metrics.
@@ -355,71 +430,7 @@ def compute_quality(cpu_load, temp, gpu_load, vram_usage, motion_intensity):
     
     try:
         # Step 1: Calculate power consumption using fuzzy membership and weighted combination
-        # First, determine fuzzy membership for each input
-        cpu_low_mem = fuzz.gaussmf(cpu_load, gmm_params['cpu_load'][0][0], gmm_params['cpu_load'][0][1] * 0.5)
-        cpu_med_mem = fuzz.gaussmf(cpu_load, gmm_params['cpu_load'][1][0], gmm_params['cpu_load'][1][1] * 0.5)
-        cpu_high_mem = fuzz.gaussmf(cpu_load, gmm_params['cpu_load'][2][0], gmm_params['cpu_load'][2][1] * 0.5)
-        
-        temp_low_mem = fuzz.gaussmf(temp, gmm_params['temperature'][0][0], gmm_params['temperature'][0][1] * 0.5)
-        temp_med_mem = fuzz.gaussmf(temp, gmm_params['temperature'][1][0], gmm_params['temperature'][1][1] * 0.5)
-        temp_high_mem = fuzz.gaussmf(temp, gmm_params['temperature'][2][0], gmm_params['temperature'][2][1] * 0.5)
-        
-        gpu_low_mem = fuzz.gaussmf(gpu_load, gmm_params['gpu_load'][0][0], gmm_params['gpu_load'][0][1] * 0.5)
-        gpu_med_mem = fuzz.gaussmf(gpu_load, gmm_params['gpu_load'][1][0], gmm_params['gpu_load'][1][1] * 0.5)
-        gpu_high_mem = fuzz.gaussmf(gpu_load, gmm_params['gpu_load'][2][0], gmm_params['gpu_load'][2][1] * 0.5)
-        
-        vram_low_mem = fuzz.gaussmf(vram_usage, gmm_params['vram_usage'][0][0], gmm_params['vram_usage'][0][1] * 0.5)
-        vram_med_mem = fuzz.gaussmf(vram_usage, gmm_params['vram_usage'][1][0], gmm_params['vram_usage'][1][1] * 0.5)
-        vram_high_mem = fuzz.gaussmf(vram_usage, gmm_params['vram_usage'][2][0], gmm_params['vram_usage'][2][1] * 0.5)
-        
-        # Calculate overall "low/medium/high" score for the system
-        # Use minimum (AND) for low (all must be low), maximum (OR) for high (any high)
-        overall_low = min(cpu_low_mem, temp_low_mem, gpu_low_mem, vram_low_mem)
-        overall_high = max(cpu_high_mem, temp_high_mem, gpu_high_mem, vram_high_mem)
-        overall_med = (cpu_med_mem + temp_med_mem + gpu_med_mem + vram_med_mem) / 4.0
-        
-        # Map to power consumption using GMM means
-        # Use dominant membership approach to avoid skewing from extreme values
-        power_low = gmm_params['power_consumption'][0][0]  # ~70W
-        power_med = gmm_params['power_consumption'][1][0]  # ~92W
-        power_high = gmm_params['power_consumption'][2][0]  # ~645W
-        
-        # Find dominant membership (highest value)
-        max_mem = max(overall_low, overall_med, overall_high)
-        
-        # Check if inputs are clearly below/above GMM means (even if membership is low)
-        cpu_below_low_mean = cpu_load < gmm_params['cpu_load'][0][0]
-        temp_below_low_mean = temp < gmm_params['temperature'][0][0]
-        gpu_below_low_mean = gpu_load < gmm_params['gpu_load'][0][0]
-        vram_below_low_mean = vram_usage < gmm_params['vram_usage'][0][0]
-        all_below_low = cpu_below_low_mean and temp_below_low_mean and gpu_below_low_mean and vram_below_low_mean
-        
-        cpu_above_high_mean = cpu_load > gmm_params['cpu_load'][2][0]
-        temp_above_high_mean = temp > gmm_params['temperature'][2][0]
-        gpu_above_high_mean = gpu_load > gmm_params['gpu_load'][2][0]
-        vram_above_high_mean = vram_usage > gmm_params['vram_usage'][2][0]
-        most_above_high = (cpu_above_high_mean and temp_above_high_mean) or (cpu_above_high_mean and gpu_above_high_mean)
-        
-        if all_below_low or (overall_low > 0.6):
-            # Clearly low - use low power
-            calculated_power = power_low
-        elif most_above_high or (overall_high > 0.8):
-            # Clearly high - use high power
-            calculated_power = power_high
-        elif overall_med > 0.4 and overall_high < 0.6:
-            # Clearly medium (medium membership is strong and high is not dominant)
-            calculated_power = power_med
-        else:
-            # Mixed case - use weighted interpolation
-            if overall_low > overall_high and overall_low > 0.3:
-                # Leaning low
-                calculated_power = power_low + (power_med - power_low) * (1 - overall_low)
-            elif overall_high > overall_low and overall_high > 0.5:
-                # Leaning high
-                calculated_power = power_med + (power_high - power_med) * overall_high
-            else:
-                # Balanced or unclear - use medium
-                calculated_power = power_med
+        calculated_power = estimate_power(cpu_load, temp, gpu_load, vram_usage)
         
         # Step 2: Calculate quality from power consumption
         # Use threshold-based approach for clearer boundaries
@@ -443,3 +454,59 @@ def compute_quality(cpu_load, temp, gpu_load, vram_usage, motion_intensity):
         import traceback
         traceback.print_exc()
         return 1  # Default to medium quality on error
+
+
+# Budgets matching the three quality levels; keep in step with QualitySolver::kTierBudgets
+# and the budgets in quality_tiers.cfg
+BUDGET_LOW = 0.1
+BUDGET_MEDIUM = 0.4
+BUDGET_HIGH = 1.0
+
+
+def compute_budget(cpu_load, temp, gpu_load, vram_usage):
+    """
+    Continuous counterpart of compute_quality for the quality-vector solver.
+    
+    The estimated power is interpolated between the GMM power means: at or below
+    the low mean the full budget is available, at the medium mean the medium
+    budget, and at or above the high mean the low budget. A temperature above its
+    high GMM mean throttles that further, down to 0 one sigma above it, which is
+    what selects a tier below the low one (such as the ultra-low wireframe tier).
+    
+    Args:
+        cpu_load (float): CPU load percentage
+        temp (float): Temperature in degrees
+        gpu_load (float): GPU load percentage
+        vram_usage (float): VRAM usage percentage
+    
+    Returns:
+        float: Fraction of the full-quality rendering cost to spend (0.0 - 1.0)
+    """
+    try:
+        power = estimate_power(cpu_load, temp, gpu_load, vram_usage)
+        power_low = gmm_params['power_consumption'][0][0]
+        power_med = gmm_params['power_consumption'][1][0]
+        power_high = gmm_params['power_consumption'][2][0]
+        
+        if power <= power_low:
+            budget = BUDGET_HIGH
+        elif power <= power_med:
+            t = (power - power_low) / max(power_med - power_low, 1e-6)
+            budget = BUDGET_HIGH + (BUDGET_MEDIUM - BUDGET_HIGH) * t
+        elif power < power_high:
+            t = (power - power_med) / max(power_high - power_med, 1e-6)
+            budget = BUDGET_MEDIUM + (BUDGET_LOW - BUDGET_MEDIUM) * t
+        else:
+            budget = BUDGET_LOW
+        
+        # Thermal throttling
+        temp_high_mean, temp_high_sigma = gmm_params['temperature'][2]
+        if temp > temp_high_mean:
+            budget *= max(0.0, 1.0 - (temp - temp_high_mean) / max(temp_high_sigma, 1e-6))
+        return budget
+        
+    except Exception as e:
+        print(f"[fuzzy_module] Error in compute_budget: {e}")
+        import traceback
+        traceback.print_exc()
+        return BUDGET_MEDIUM  # Default to the medium budget on error
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Asynchronous frame capture. capture() issues glReadPixels into the next pixel pack
+// buffer of a small ring and fences it; later frames map a buffer only once its fence has
+// signalled, copy the pixels out and queue them for encoder threads that write a PNG
+// sequence or a Y4M stream. The render thread never waits: a ring slot still in flight or
+// a full encoder queue drops the frame and counts it.
+class FrameCapture {
+public:
+    enum class Format : int { PNG = 0, Y4M = 1 };
+    static const int kPresented = -1;  // Source: the default framebuffer (before the UI)
+    static const int kRingSize = 4;
+
+private:
+    struct Readback {
+        GLuint buffer = 0;
+        GLsync fence = nullptr;
+        int width = 0, height = 0;
+        unsigned long long frame = 0;
+    };
+    struct Job {
+        std::vector<uint8_t> pixels;  // RGBA, bottom-up
+        int width, height;
+        unsigned long long frame;
+        unsigned long long sequence;  // Order in the Y4M stream
+    };
+
+    Readback ring[kRingSize];
+    int ringHead = 0;
+    bool active = false;
+    Format format = Format::PNG;
+    int source = kPresented;
+    std::string outputPath;  // Directory (PNG) or file (Y4M)
+    int streamWidth = 0, streamHeight = 0, streamFps = 60;
+
+    // Encoder side
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable jobCondition;
+    std::condition_variable writeCondition;  // Y4M frames are written in sequence order
+    std::deque<Job> jobs;
+    std::vector<std::vector<uint8_t>> freeBuffers;  // Recycled pixel storage
+    size_t maxQueuedJobs = 8;
+    bool stopping = false;
+    FILE* stream = nullptr;
+    unsigned long long nextSequence = 0, nextWrite = 0;
+
+    // Statistics
+    unsigned long long capturedFrames = 0, droppedFrames = 0, encodedFrames = 0;
+
+    void collect(bool wait);  // Queues every readback whose fence has signalled
+    void workerLoop();
+    void encode(Job& job);
+
+public:
+    ~FrameCapture() { stop(); }
+
+    // path: directory for PNG frames, or a .y4m file; source: kPresented or a quality tier
+    bool start(const std::string& path, Format format, int source, int fps, int encoderThreads = 0);
+    // Flushes outstanding readbacks and queued frames, then joins the encoders
+    void stop();
+    bool isActive() const { return active; }
+    int getSource() const { return source; }
+
+    // Reads back 'framebuffer' (0 = default back buffer); call once per frame
+    void capture(GLuint framebuffer, int width, int height, unsigned long long frame);
+
+    unsigned long long getCapturedFrames() const { return capturedFrames; }
+    unsigned long long getDroppedFrames() const { return droppedFrames; }
+    unsigned long long getEncodedFrames();
+};
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <GLFW/glfw3.h>
+#include <chrono>
+#include <vector>
+
+// Paces the main loop to a target frame rate. The wait sleeps until shortly before the
+// deadline and spins (yielding) for the remainder, with the sleep margin tracking how late
+// the OS actually wakes us, so deadlines are hit precisely without burning a core. Swap
+// interval is managed here too: off (the limiter paces), vsync, or adaptive vsync (-1,
+// tears instead of stalling a late frame) where the platform exposes swap_control_tear.
+class FramePacer {
+public:
+    enum class SwapMode : int { Off = 0, VSync = 1, Adaptive = 2 };
+
+private:
+    using Clock = std::chrono::steady_clock;
+    static const int kHistoryFrames = 120;
+
+    SwapMode swapMode = SwapMode::Off;
+    bool adaptiveSupported = false;
+    float targetFps = 60.0f;      // 0 = unlimited
+    float controllerCapFps = 0.0f;  // Extra cap from the quality tier (0 = none)
+
+    Clock::time_point deadline;
+    Clock::time_point lastFrameEnd;
+    bool started = false;
+    double sleepMarginMs = 1.0;   // Spin this long before the deadline
+    double oversleepMs = 0.5;     // Smoothed lateness of sleep_for wake-ups
+
+    std::vector<float> frameTimesMs;  // Ring of the last kHistoryFrames intervals
+    int frameTimeCursor = 0;
+
+public:
+    // Both apply to the current context, which must be the paced window's
+    void initialize();
+    void setSwapMode(SwapMode mode);
+    SwapMode getSwapMode() const { return swapMode; }
+    bool isAdaptiveSupported() const { return adaptiveSupported; }
+
+    void setTargetFps(float fps) { targetFps = fps; }
+    float getTargetFps() const { return targetFps; }
+    void setControllerCap(float fps) { controllerCapFps = fps; }
+    float getEffectiveFps() const;  // min(target, controller cap), 0 = unlimited
+
+    // Call once per frame after the buffer swap: waits for the next deadline and records
+    // the frame interval
+    void waitForNextFrame();
+    // Starts a fresh schedule (after idling), so the gap is not counted as a frame
+    void resetSchedule() { started = false; }
+
+    // Statistics over the last kHistoryFrames frames
+    float getAverageFrameMs() const;
+    float getJitterMs() const;      // Standard deviation of the frame interval
+    float getWorstFrameMs() const;
+    float getSleepMarginMs() const { return (float)sleepMarginMs; }
+};
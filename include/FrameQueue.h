@@ -0,0 +1,65 @@
+#pragma once
+
+#include <GL/glew.h>
+
+// Explicit frames-in-flight management. Every frame gets a slot; endFrame() fences it, and
+// beginFrame() only blocks when the slot about to be reused is still on the GPU, so the
+// CPU can record up to 'depth' frames ahead. Anything the CPU rewrites every frame
+// (uniform ring ranges, timestamp queries, readback buffers) is indexed by getSlot() and
+// is therefore never touched while the GPU may still read it. A deeper queue smooths
+// throughput; depth 1 gives the lowest latency.
+class FrameQueue {
+public:
+    static const int kMaxFramesInFlight = 4;
+
+private:
+    struct Slot {
+        GLsync fence = nullptr;
+        GLuint timestampQueries[2] = {0, 0};  // Frame start / end
+        bool timestampsPending = false;
+    };
+    Slot slots[kMaxFramesInFlight];
+    int depth = 2;
+    int slot = 0;
+    unsigned long long frameIndex = 0;
+    bool timestampsSupported = false;
+    float lastGpuFrameMs = 0.0f;
+    float lastFenceWaitMs = 0.0f;  // CPU time blocked in beginFrame()
+
+    void retire(Slot& retired);
+
+public:
+    bool initialize(int framesInFlight);
+    // Waits for every queued frame, then uses the new depth (1..kMaxFramesInFlight)
+    void setDepth(int framesInFlight);
+    int getDepth() const { return depth; }
+
+    void beginFrame();  // Waits for this slot's previous frame, then starts timing
+    void endFrame();    // Call after the swap: fences the frame and advances the slot
+    void waitIdle();
+
+    int getSlot() const { return slot; }
+    unsigned long long getFrameIndex() const { return frameIndex; }
+    // GPU time of the last retired frame (lags by up to 'depth' frames, never stalls)
+    float getLastGpuFrameMs() const { return lastGpuFrameMs; }
+    float getLastFenceWaitMs() const { return lastFenceWaitMs; }
+    void cleanup();
+};
+
+// Uniform buffer holding one copy of a block per frame slot. Each frame writes its own
+// range unsynchronized (FrameQueue guarantees the GPU is done with it) and binds just that
+// range, so uploads never wait on or orphan storage the previous frames are reading.
+class UniformRing {
+private:
+    GLuint buffer = 0;
+    GLuint bindingPoint = 0;
+    GLsizeiptr blockSize = 0;
+    GLsizeiptr stride = 0;  // blockSize rounded up to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+
+public:
+    bool initialize(GLuint binding, GLsizeiptr size);
+    // Maps this slot's range for writing and binds it to the binding point
+    void* map(int slot);
+    void unmap();
+    void cleanup();
+};
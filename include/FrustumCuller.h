@@ -0,0 +1,98 @@
+#pragma once
+
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <new>
+#include "InstanceData.h"
+
+class ThreadPool;
+
+// Minimal allocator that keeps SoA streams 32-byte aligned for AVX2 loads
+template <typename T, size_t Alignment = 32>
+struct AlignedAllocator {
+    using value_type = T;
+    template <typename U> struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() = default;
+    template <typename U> AlignedAllocator(const AlignedAllocator<U, Alignment>&) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+    void deallocate(T* p, size_t) {
+        ::operator delete(p, std::align_val_t(Alignment));
+    }
+    template <typename U> bool operator==(const AlignedAllocator<U, Alignment>&) const { return true; }
+    template <typename U> bool operator!=(const AlignedAllocator<U, Alignment>&) const { return false; }
+};
+
+using AlignedFloats = std::vector<float, AlignedAllocator<float>>;
+
+// View frustum as 6 normalized planes (a, b, c, d) with normals pointing inwards:
+// a point p is inside a plane when a*p.x + b*p.y + c*p.z + d >= 0
+struct Frustum {
+    float planes[6][4];
+
+    // Gribb/Hartmann extraction from a clip matrix (projection * view [* model]).
+    // The resulting planes live in whatever space the matrix maps from.
+    static Frustum fromMatrix(const glm::mat4& clip);
+};
+
+// Per-instance world-space bounds in structure-of-arrays layout
+struct InstanceBoundsSoA {
+    AlignedFloats centerX, centerY, centerZ, radius;   // Bounding spheres
+    AlignedFloats minX, minY, minZ, maxX, maxY, maxZ;   // Axis-aligned boxes
+    size_t count = 0;
+
+    void resize(size_t n);
+    void set(size_t i, const glm::vec3& boxMin, const glm::vec3& boxMax);
+};
+
+// CPU visibility stage for instanced rendering. Tests instance bounds against the
+// frustum (8 at a time with AVX2 when the CPU has it) and compacts the instance data
+// of the survivors into the instance buffer, split across the worker pool.
+class FrustumCuller {
+private:
+    InstanceBoundsSoA bounds;
+    std::vector<InstanceData> instances;      // Source instances (AoS, what the GPU consumes)
+    std::vector<std::vector<uint32_t>> threadSurvivors;
+    std::vector<size_t> threadOffsets;
+    ThreadPool* pool = nullptr;
+    bool useAVX2 = false;
+
+    size_t lastVisibleCount = 0;
+    float lastCullTimeMs = 0.0f;
+
+public:
+    FrustumCuller();
+
+    // Instances whose transforms map the local box [localMin, localMax]; also computes
+    // their normal matrices
+    void setInstances(const std::vector<glm::mat4>& instanceTransforms,
+        const glm::vec3& localMin, const glm::vec3& localMax);
+    void setThreadPool(ThreadPool* threadPool) { pool = threadPool; }
+    void setUseAVX2(bool enable);
+    bool isUsingAVX2() const { return useAVX2; }
+
+    // Cull against the frustum and write surviving instances densely to 'out'
+    // (capacity >= getInstanceCount()). Returns the number of survivors.
+    size_t cull(const Frustum& frustum, InstanceData* out);
+
+    size_t getInstanceCount() const { return bounds.count; }
+    const InstanceBoundsSoA& getBounds() const { return bounds; }
+    const std::vector<InstanceData>& getInstances() const { return instances; }
+    size_t getLastVisibleCount() const { return lastVisibleCount; }
+    float getLastCullTimeMs() const { return lastCullTimeMs; }
+
+    // Range kernels: write indices of visible instances in [begin, end) to outIndices
+    static size_t cullRangeScalar(const InstanceBoundsSoA& bounds, const Frustum& frustum,
+        size_t begin, size_t end, uint32_t* outIndices);
+    static size_t cullRangeAVX2(const InstanceBoundsSoA& bounds, const Frustum& frustum,
+        size_t begin, size_t end, uint32_t* outIndices);
+    static bool cpuSupportsAVX2();
+
+    // Instances/sec microbenchmark for the scalar and AVX2 kernels, single and multi-threaded
+    static int runBenchmark(const std::vector<glm::mat4>& instanceTransforms);
+};
@@ -13,6 +13,28 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <vector>
+#include <map>
+#include <memory>
+#include <atomic>
+#include "ThreadPool.h"
+#include "FrustumCuller.h"
+#include "GpuCuller.h"
+#include "Mesh.h"
+#include "VertexFormat.h"
+#include "ShaderHotReload.h"
+#include "ShaderPermutations.h"
+#include "Upscaler.h"
+#include "FramePacer.h"
+#include "FrameQueue.h"
+#include "FrameCapture.h"
+#include "ImageDiff.h"
+#include "QualitySolver.h"
+#include "QualityTiers.h"
+#include "ShadowMap.h"
+#include "RenderGraph.h"
+#include "PostChain.h"
+#include "ResourceLoader.h"
 
 // Global verbose flag for debug output
 extern bool g_verbose;
@@ -22,6 +44,15 @@ void GLAPIENTRY glDebugCallback(GLenum source, GLenum type, GLuint id, GLenum se
     GLsizei length, const GLchar* message, const void* userParam);
 void checkGLError(const char* operation);
 
+// Creates a window + context, preferring GL 4.3 core (compute, indirect draws) and falling
+// back to 3.3 core when 4.3 is unavailable or preferGL43 is false. Makes the context current.
+GLFWwindow* createGLWindow(int width, int height, const char* title, bool visible, bool preferGL43,
+    GLFWwindow* shareWith = nullptr);
+
+// Unique sibling of 'path' to write and then rename over it: the process id and a counter
+// keep concurrent writers (other launches, the loader and render threads) apart
+std::string makeTempPath(const std::string& path);
+
 // Forward declarations
 class CubeRenderer;
 class ShaderManager;
@@ -34,38 +65,92 @@ namespace CubeData {
     extern float simpleCubeVertices [];
     extern float cubeVertices [];
     extern float screenQuadVertices [];
+    extern float groundPlaneVertices [];
+
+    // Deterministic field of randomly rotated/scaled cubes for the instanced scene
+    std::vector<glm::mat4> generateInstanceField(int count, unsigned int seed);
 }
 
 // Shader management class
 class ShaderManager {
+private:
+    // On-disk program binary cache (glGetProgramBinary/glProgramBinary)
+    static bool programCacheEnabled;
+    static std::atomic<int> programCacheHits, programCacheMisses;  // The resource loader builds programs too
+
+    static std::string programCacheKey(const std::vector<std::string>& sources);
+    static GLuint loadCachedProgram(const std::string& key, const std::string& programName);
+    static void storeCachedProgram(GLuint program, const std::string& key);
+
 public:
+    static const char* const kProgramCacheDirectory;
+
     static std::string loadShaderSource(const std::string& filePath);
-    static GLuint compileShader(GLenum type, const std::string& source, const std::string& shaderName);
-    static GLuint createShaderProgram(const std::string& vertexPath, const std::string& fragmentPath);
+    // Failures exit the application, unless 'errors' is given: the message is then appended
+    // to it and 0 returned (the resource loader's thread must not exit; it reports on the
+    // render thread instead)
+    static GLuint compileShader(GLenum type, const std::string& source, const std::string& shaderName,
+        std::string* errors = nullptr);
+    // 'defines' (e.g. "#define FEATURE_X\n") is inserted after each stage's #version line
+    static GLuint createShaderProgram(const std::string& vertexPath, const std::string& fragmentPath,
+        const std::string& defines = "", std::string* errors = nullptr);
+    static std::string injectDefines(const std::string& source, const std::string& defines);
+    static GLuint createComputeProgram(const std::string& computePath);
     static GLuint reloadShaderProgram(GLuint oldProgram, const std::string& vertexPath, const std::string& fragmentPath);
     static bool validateProgram(GLuint program, const std::string& programName);
+
+    static void setProgramCacheEnabled(bool enabled) { programCacheEnabled = enabled; }
+    static bool isProgramCacheSupported();  // GL 4.1 / ARB_get_program_binary with at least one format
+    static void clearProgramCache();
+    static void resetProgramCacheStats() { programCacheHits = programCacheMisses = 0; }
+    static int getProgramCacheHits() { return programCacheHits; }
+    static int getProgramCacheMisses() { return programCacheMisses; }
 };
 
 // Structure to hold FBO resources for a single quality level
 struct QualityFBO {
     GLuint framebuffer;
     GLuint textureColorbuffer;
+    GLuint velocityTexture;  // RG16F motion vectors at attachment 1 (temporal upsampling)
     GLuint rbo;
     int width, height;
+    // Multisampled target drawn instead of the textures above when samples > 0, then
+    // resolved into them with glBlitFramebuffer
+    GLuint msaaFramebuffer;
+    GLuint msaaColor, msaaVelocity, msaaDepthStencil;  // Renderbuffers
+    int samples;
+    int msaaAllocated;  // Samples of the multisampled target, kept while MSAA is toggled off
 };
 
 // Framebuffer management class
 class FramebufferManager {
 private:
-    QualityFBO fbos[3];  // One FBO per quality level (low=0, medium=1, high=2)
+    std::vector<QualityFBO> fbos;  // One FBO per quality tier, at the tier's render scale
     int currentBoundQuality = -1;
+    int maxSamples = 0;
+
+    void destroyMultisampleTarget(QualityFBO& fbo);
 
 public:
-    FramebufferManager();
-    bool initialize();  // Creates all 3 FBOs with appropriate resolutions
-    void bind(int quality);  // Bind FBO for specific quality level
+    bool initialize(const QualityTierRegistry& tiers);  // Creates every tier's FBO up front
+    void bind(int quality);  // Bind FBO for specific quality level (the multisampled one if enabled)
     void unbind();
+    // 0 (off), 2, 4 or 8, clamped to GL_MAX_SAMPLES; returns true when the drawn target changed.
+    // Only a new sample count reallocates: turning MSAA off keeps the multisampled target.
+    bool setSamples(int quality, int samples);
+    int getSamples(int quality) const { return fbos[quality].samples; }
+    int getMaxSamples() const { return maxSamples; }
+    // Blits the multisampled colour (and velocity) into the tier's textures; no-op without MSAA
+    void resolve(int quality, bool velocity);
+    // Route fragment output 1 (velocity) of the bound FBO to its velocity texture
+    void setVelocityOutput(bool enabled);
     GLuint getTexture(int quality) const;
+    // Framebuffer the scene is drawn into, and the single-sample one holding the textures
+    GLuint getFramebuffer(int quality) const {
+        return fbos[quality].samples ? fbos[quality].msaaFramebuffer : fbos[quality].framebuffer;
+    }
+    GLuint getResolvedFramebuffer(int quality) const { return fbos[quality].framebuffer; }
+    GLuint getVelocityTexture(int quality) const { return fbos[quality].velocityTexture; }
     int getWidth(int quality) const { return fbos[quality].width; }
     int getHeight(int quality) const { return fbos[quality].height; }
     void cleanup();
@@ -77,12 +162,26 @@ private:
     GLuint cubeVAO, cubeVBO, cubeEBO;  // Full cube with indexed geometry
     GLuint simpleCubeVAO, simpleCubeVBO;  // Simple cube (no indexing for low quality)
     GLuint quadVAO, quadVBO;  // Screen quad for post-processing
+    GLuint groundVAO, groundVBO;  // Shadow-receiving plane under the single object
+    GLuint instanceVBO;  // Per-instance InstanceData (attributes 3-9), shared by both cube VAOs
+    GLuint simpleCubeEBO = 0;  // Sequential indices so the simple cube can be drawn indirectly
+    size_t instanceCapacity = 0;
 
 public:
     bool initialize();
     void renderCube(GLuint program, int indexCount);
     void renderSimpleCube(GLuint program);
+    void renderCubeInstanced(GLuint program, int indexCount, int instanceCount);
+    void renderSimpleCubeInstanced(GLuint program, int instanceCount);
+    void renderGroundPlane(GLuint program);
     void renderScreenQuad();
+    void setInstanceCapacity(size_t capacity);
+    InstanceData* mapInstanceBuffer();  // Orphans and maps the instance buffer for writing
+    void unmapInstanceBuffer();
+    // Indexed cube VAO (the simple cube gets a 0..35 index buffer) whose instance
+    // attributes read from an external buffer, e.g. the GPU culler's survivors
+    GLuint createInstancedVAO(bool simple, GLuint instanceBuffer);
+    void destroyInstancedVAO(GLuint vao);
     void cleanup();
     GLuint getSimpleVAO() const { return simpleCubeVAO; }
     GLuint getFullVAO() const { return cubeVAO; }
@@ -94,7 +193,39 @@ public:
     static bool initialize(GLFWwindow* window);
     static void renderUI(float& cpuLoad, float& temp, float& gpuLoad, float& vramUsage,
         float& cameraDistance, float& rotationX, float& rotationY,
-        int quality, bool isManualOverride);
+        const QualityTierRegistry& tiers, int quality, bool isManualOverride);
+    static void renderSceneUI(bool& instancedScene, int& instanceCount, bool& useAVX2,
+        bool& useGPUCulling, bool gpuCullingSupported, size_t visibleCount, float cullTimeMs);
+    static void renderMeshUI(bool& meshScene, int& lodSelectionMode, float& maxPixelError,
+        int currentLOD, const MeshLODChain& meshChain);
+    // Returns true when Recalibrate was pressed
+    static bool renderQualityVectorUI(bool& enabled, int& budgetMode, float budget, const QualityVector& vector,
+        float renderScale, float estimatedMs, float score, float gpuFrameMs, bool calibrated);
+    // Edits the tiers' sample counts
+    static void renderMsaaUI(bool& enabled, QualityTierRegistry& tiers, int maxSamples, float sceneTimeMs,
+        float resolveTimeMs);
+    // Edits the tiers' shadow map sizes and PCF radii
+    static void renderShadowUI(bool& enabled, QualityTierRegistry& tiers, int mapSize, float shadowTimeMs);
+    // Edits the tiers' post effects and the chain's parameters; 'active' is what the current
+    // frame runs after stripping
+    static void renderPostUI(bool& enabled, QualityTierRegistry& tiers, PostChain& chain, uint32_t active,
+        const RenderGraph& graph);
+    // Edits the tiers' temporal upsampling toggles
+    static void renderPresentUI(int& presentMode, float& sharpness, float upscaleTimeMs,
+        QualityTierRegistry& tiers, float temporalTimeMs, bool& checkerboard, float checkerboardTimeMs,
+        float sceneTimeMs);
+    static void renderPacingUI(float& targetFps, int& swapMode, bool adaptiveSupported,
+        bool& controllerCap, float effectiveFps, float averageMs, float jitterMs, float worstMs,
+        bool& renderOnDemand, float& idleWakeRate, int idleWakes, int& framesInFlight,
+        float fenceWaitMs, float gpuFrameMs);
+    // Returns true when Start/Stop was pressed
+    static bool renderCaptureUI(int& format, int& source, const QualityTierRegistry& tiers, bool active,
+        unsigned long long captured,
+        unsigned long long encoded, unsigned long long dropped);
+    // Live and culled passes with their GPU times, and the transient target pool
+    static void renderGraphUI(const RenderGraph& graph);
+    // Loader progress and the sample texture it uploaded (0 while it loads)
+    static void renderLoaderUI(const ResourceLoader& loader, GLuint texture);
     static void shutdown();
 };
 
@@ -103,25 +234,42 @@ class PythonManager {
 private:
     PyObject* pModule;
     PyObject* pFunc;
+    PyObject* pBudgetFunc = nullptr;  // Optional compute_budget
     PyObject* pSimClass;  // ControlSystemSimulation class
     PyObject* pSim;       // Cached simulation object
 
 public:
     bool initialize();
     int getQuality(float cpuLoad, float temp, float gpuLoad, float vramUsage);
+    // Fraction of the full-quality cost the system can afford (QualitySolver budget);
+    // derived from getQuality when the module has no compute_budget
+    float getBudget(float cpuLoad, float temp, float gpuLoad, float vramUsage);
     void cleanup();
 };
 
 // Quality settings structure
 struct QualitySettings {
     int renderWidth, renderHeight;
+    uint32_t shaderFeatures;  // ShaderFeature bits of the cube über-shader variant
     GLuint cubeProgram;
     GLuint cubeVAO;
     int indexCount;  // Number of indices to draw (for indexed geometry) or vertex count
+    bool simpleGeometry;  // Non-indexed cube (cubeVAO is the simple one)
+    bool wireframe;  // Edges only
     float pixelSize;
+    int meshLOD;  // Level of the LOD mesh drawn at this tier (0 = full detail)
+    bool checkerboard;  // Shade half the pixels per frame and reconstruct the rest
+    int msaaSamples;  // Samples of the tier's FBO while MSAA is enabled (0 = single-sample)
+    int shadowMapSize;  // 0 = no shadow pass (shaderFeatures then lacks Shadows)
+    int shadowPCF;  // PCF kernel radius
+    float fpsCap;  // Frame rate cap applied by the pacer at this tier (0 = uncapped)
 
-    static QualitySettings getSettings(int quality, GLuint simpleProgram, GLuint mediumProgram,
-        GLuint highProgram, GLuint simpleVAO, GLuint fullVAO);
+    static QualitySettings getSettings(const QualityTier& tier, ShaderPermutations& cubeShaders,
+        GLuint simpleVAO, GLuint fullVAO);
+    // The scale tier's preset (resolution, geometry, pixel size) with the vector's knobs applied
+    static QualitySettings fromVector(const QualityVector& vector, const QualityTierRegistry& tiers,
+        ShaderPermutations& cubeShaders, GLuint simpleVAO, GLuint fullVAO);
+    static uint32_t shadingFeatures(ShadingModel shading);
 };
 
 // Main application class
@@ -134,26 +282,242 @@ private:
     ImGuiManager imguiManager;
     PythonManager pythonManager;
 
-    // Shader programs
-    GLuint cubeSimpleProgram, cubeMediumProgram, cubeHighProgram, pixelateProgram;
+    // Shader programs: cube variants are permutations of one über-shader
+    ShaderPermutations cubeShaders{"shaders/cube.vert", "shaders/cube.frag"};
+    GLuint pixelateProgram;
+    std::map<std::string, GLuint> presentPrograms;  // Tiers' other present shaders, by name
+
+    // Quality tiers from the config file (the built-in low/medium/high without one)
+    QualityTierRegistry qualityTiers;
+    std::string tiersPath = QualityTierRegistry::kDefaultPath;
 
     // Uniform Buffer Objects
-    GLuint matricesUBO;  // For MVP matrices
+    UniformRing matricesRing;  // MVP matrices, one range per frame slot
     GLuint lightingUBO;  // For lighting parameters
 
-    // GPU profiling
-    GLuint queryIDs[2];  // Timer queries for GPU profiling
-    bool enableGPUTimers = false;
+    // Frames in flight: fences per frame slot; also times each frame on the GPU
+    FrameQueue frameQueue;
+    int framesInFlight = 2;
+
+    // The frame's passes, declared every frame; culls, times and pools their targets
+    RenderGraph renderGraph;
+
+    // Asynchronous capture of the presented frame or one quality tier's FBO
+    FrameCapture frameCapture;
+    std::string capturePath;  // Set from the command line: capture from the first frame
+    int captureFormat = (int)FrameCapture::Format::PNG;
+    int captureSource = FrameCapture::kPresented;
+    std::string captureSourceName;  // From the command line; a tier name, resolved once tiers load
+
+    // Golden-image tests: hidden window, no UI overlay in the frame
+    bool headless = false;
+    // Headless frames present into this 1200x800 target instead of the hidden window, whose
+    // back buffer fails the pixel-ownership test and reads back undefined
+    GLuint offscreenFramebuffer = 0, offscreenTexture = 0;
+    bool drawUI = true;
 
     // UI state (defaults based on CSV data medians)
     float cpuLoad = 56.0f, temp = 64.0f, gpuLoad = 3.0f, vramUsage = 6.0f;
     float cameraDistance = 3.0f, rotationX = 0.0f, rotationY = 0.0f;
 
     // Manual override state
-    int manualQuality = -1; // -1 means use fuzzy logic
-    bool msaaEnabled = false;  // MSAA toggle
+    int manualQuality = -1; // Tier index; -1 means use fuzzy logic
+    bool msaaEnabled = false;  // MSAA toggle (each tier's msaaSamples)
+
+    // Quality vector: independent knobs chosen by the solver within the controller's budget,
+    // instead of the tier presets (the manual override picks that tier's budget)
+    QualitySolver qualitySolver;
+    bool qualityVectorMode = false;
+    int budgetMode = (int)BudgetMode::Power;
+    float qualityBudget = 1.0f;
+    float controllerBudget = 1.0f;  // Fuzzy controller's budget, sampled once per main-loop iteration
+    QualityVector qualityVector = {};
+    bool qualityVectorSolved = false;
+    float solvedBudget = 0.0f, solvedTargetFps = 0.0f;
+    int solvedBudgetMode = 0;
+    bool qualityVectorPinned = false;  // Calibration draws fixed vectors
+
+    // Knob costs measured on this GPU (quality_costs.txt), else the solver's defaults
+    bool costsCalibrated = false;
+    bool calibrateOnStartup = false;
+    bool calibrationRequested = false;  // From the UI; runs between frames
+
+    // Startup warm-up: each combination of tier, scene, MSAA and present path is drawn once
+    // offscreen so the driver's deferred compiles and first-use FBO work happen before the
+    // controller first switches to it
+    struct PipelineState {
+        int tier;
+        int scene;  // 0 = cube, 1 = LOD mesh, 2 = instanced field
+        bool msaa;
+        bool spatialUpscale;
+        bool temporal;
+        int vectorShading;  // ShadingModel of a solved vector in the tier's FBO; -1 = the tier's preset
+    };
+    bool prewarm = true;
+    bool prewarmPending = false;  // Runs from the main loop once the resource loader is idle
+
+    // Everything calibration and the warm-up change to draw their fixed frames, put back
+    // (with the temporal and checkerboard history dropped) when it goes out of scope
+    class RenderStateGuard {
+    private:
+        FuzzyCubeApp& app;
+        int manualQuality, lodSelectionMode, swapMode, presentMode;
+        bool meshScene, instancedScene, msaaEnabled, checkerboardRendering, postEnabled;
+        bool qualityVectorMode, drawUI, controllerFpsCap;
+        float rotationX, rotationY, cameraDistance;
+        QualityVector qualityVector;
+        unsigned int checkerboardFrame;  // Same parity afterwards
+        std::vector<bool> temporal;      // Per tier
+
+    public:
+        explicit RenderStateGuard(FuzzyCubeApp& app);
+        ~RenderStateGuard();
+        RenderStateGuard(const RenderStateGuard&) = delete;
+        RenderStateGuard& operator=(const RenderStateGuard&) = delete;
+    };
+
+    // Instanced scene with CPU frustum culling
+    std::unique_ptr<ThreadPool> threadPool;
+    FrustumCuller frustumCuller;
+    bool instancedScene = false;
+    bool cullAVX2 = true;
+    int instanceCount = 20000;
+    int builtInstanceCount = 0;
+
+    // GPU-driven culling (GL 4.3 contexts only; otherwise the CPU culler above is used)
+    GpuCuller gpuCuller;
+    bool gpuCulling = true;
+    bool preferGL43 = true;
+    GLuint gpuCubeVAO = 0, gpuSimpleCubeVAO = 0;
+    float gpuSubmitTimeMs = 0.0f;
+
+    // High-poly mesh with a simplified LOD chain (single-object view)
+    MeshLODChain meshChain;
+    GLuint sampleTexture = 0;  // Decoded and uploaded by the resource loader
+    std::string meshPath;  // OBJ to load; empty generates the rounded cube
+    bool meshScene = false;
+    int lodSelectionMode = 0;  // 0 = per quality tier, 1 = screen-space error
+    float lodPixelError = 1.0f;
+    int currentLOD = 0;
+
+    // Present path from the quality FBO to the window
+    SpatialUpscaler spatialUpscaler;
+    int presentMode = (int)PresentMode::Pixelate;
+    float upscaleSharpness = 0.5f;
+    
+    // Temporal upsampling, enabled per quality tier; replaces the present mode on those tiers
+    TemporalUpsampler temporalUpsampler;
+    bool temporalBelowFull = false;  // Command line: every tier below full resolution
+    glm::mat4 previousModel = glm::mat4(1.0f);
+    glm::mat4 previousViewProjection = glm::mat4(1.0f);
+    glm::mat4 unjitteredViewProjection = glm::mat4(1.0f);
+    bool hasPreviousFrame = false;
+    
+    // Checkerboard rendering on tiers whose settings ask for it; off while the
+    // tier is temporally upsampled
+    CheckerboardRenderer checkerboardRenderer;
+    bool checkerboardRendering = true;
+
+    // Shadow map from the scene light, sized per tier; cube and mesh views only
+    static const int kShadowTextureUnit = 4;
+    ShadowMapRenderer shadowMap;
+    bool shadowsEnabled = true;
+    int shadowPcfRadius = 0;  // Of the tier being drawn
+    glm::vec3 lightPos = glm::vec3(-2.0f, 3.0f, 2.0f);
+
+    // Post-processing on the presented image; the tier's effects, minus the most expensive
+    // ones while the controller's budget is below the tier's
+    PostChain postChain;
+    bool postEnabled = true;
+
+    // Frame pacing: target FPS limiter and swap interval; the tier's fpsCap lowers the
+    // target further when controllerFpsCap is on
+    FramePacer framePacer;
+    float targetFps = 60.0f;
+    int swapMode = (int)FramePacer::SwapMode::Off;
+    bool controllerFpsCap = true;
+
+    // Render on demand: wait for events (or the controller's wake-up) and skip the frame
+    // unless input arrived or the redraw state changed
+    struct RedrawState {
+        int quality;
+        float budget;
+        float cpuLoad, temp, gpuLoad, vramUsage;
+        float cameraDistance, rotationX, rotationY;
+        bool operator!=(const RedrawState& other) const;
+    };
+    bool renderOnDemand = false;
+    float idleWakeRate = 4.0f;   // Controller updates per second while idle
+    bool inputPending = true;    // Set by the GLFW input callbacks
+    int settleFrames = 0;        // Frames still to draw after the last change
+    int idleWakes = 0;           // Wake-ups that skipped rendering
+    RedrawState lastRedrawState = {};
+
+    // Rebuilds the programs above in the background when files in shaders/ change
+    ShaderHotReloader shaderReloader;
+    bool shaderHotReload = true;
+
+    // Builds the LOD chain and the cube variants on a shared context while frames are drawn;
+    // what a frame needs before it is ready is waited for individually
+    ResourceLoader resourceLoader;
+    std::chrono::steady_clock::time_point loadStart;
+    bool loadReported = false;
+
+    // With a loader, the cube variants are built on its thread and the call does not wait
+    bool createPrograms(ResourceLoader* loader = nullptr);
+    void deletePrograms();
+    int selectQuality();  // Manual override, else the fuzzy controller
+    // One Python round trip per iteration, read by selectQuality() however often it runs
+    void sampleControllerBudget();
+    void updateQualityVector();  // Re-solves when the budget, its mode or the target FPS changed
+    uint32_t stripPostEffects(const QualityTier& tier) const;  // The tier's effects that fit qualityBudget
+    RedrawState captureRedrawState();
+    void installInputCallbacks();
+    static void markInputPending(GLFWwindow* window);
+    void rebuildInstanceField();
+    void applyCubeUniforms(GLuint program, uint32_t features, const glm::mat4& model,
+        const glm::mat4& view, const glm::mat4& projection);
+    std::vector<PipelineState> enumeratePipelineStates() const;
+    void applyPipelineState(const PipelineState& state);
+    std::string describePipelineState(const PipelineState& state) const;
 
 public:
+    void setPreferGL43(bool prefer) { preferGL43 = prefer; }
+    void setMeshPath(const std::string& path) { meshPath = path; }
+    void setShaderHotReload(bool enabled) { shaderHotReload = enabled; }
+    void setPresentMode(PresentMode mode) { presentMode = (int)mode; }
+    void setTiersPath(const std::string& path) { tiersPath = path; }
+    void setTemporalUpsampling(bool belowFullResolution) { temporalBelowFull = belowFullResolution; }
+    void setCheckerboardRendering(bool enabled) { checkerboardRendering = enabled; }
+    void setMsaaEnabled(bool enabled) { msaaEnabled = enabled; }
+    void setShadows(bool enabled) { shadowsEnabled = enabled; }
+    void setPostEffects(bool enabled) { postEnabled = enabled; }
+    void setQualityVector(bool enabled, BudgetMode mode) { qualityVectorMode = enabled; budgetMode = (int)mode; }
+    void setTargetFps(float fps) { targetFps = fps; }
+    void setSwapMode(FramePacer::SwapMode mode) { swapMode = (int)mode; }
+    void setRenderOnDemand(bool enabled, float wakeRate) { renderOnDemand = enabled; idleWakeRate = wakeRate; }
+    void setFramesInFlight(int frames) { framesInFlight = frames; }
+    // A path ending in .y4m records a Y4M stream, anything else a directory of PNGs
+    void setCapturePath(const std::string& path) { capturePath = path; }
+    void setCaptureSource(const std::string& tierName) { captureSourceName = tierName; }
+    // Startup program creation with the cache off, cold and warm (hidden window, then exits)
+    static int runShaderCacheBenchmark();
+    void setHeadless(bool enabled) { headless = enabled; }
+    void setCalibrateOnStartup(bool enabled) { calibrateOnStartup = enabled; }
+    void setPrewarm(bool enabled) { prewarm = enabled; }
+    // Draws every pipeline state once without presenting and waits on the frame fences;
+    // returns the milliseconds it took
+    float prewarmPipelines();
+    // Worst frame-time spike on forced tier transitions with freshly created programs and
+    // FBOs, without and then with the warm-up (run with prewarm off); returns the exit code
+    int runTierSwitchBenchmark();
+    // Renders short bursts at each render scale, shading model, MSAA level, mesh LOD and
+    // effect, times them with GPU queries and fits the solver's cost table, which is saved
+    // under this GL_RENDERER in QualitySolver::kCostTablePath
+    bool calibrateQualityCosts();
+    // Renders the fixed scenarios and compares them with the PNGs in 'directory' (writing
+    // them instead when 'update' is set or one is missing); returns the number of failures
+    int runGoldenTests(const std::string& directory, bool update);
     bool initialize();
     void handleInput();
     void render();
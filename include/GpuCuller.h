@@ -0,0 +1,56 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include "FrustumCuller.h"
+
+// Layout of one glMultiDrawElementsIndirect record (matches the GL spec)
+struct DrawElementsIndirectCommand {
+    GLuint count;
+    GLuint instanceCount;
+    GLuint firstIndex;
+    GLint baseVertex;
+    GLuint baseInstance;
+};
+
+// GPU-driven companion to FrustumCuller for GL 4.3 contexts. A compute shader tests
+// every instance's bounds against the frustum, appends survivors to a transform buffer
+// that doubles as the instance vertex buffer, and bumps instanceCount in an indirect
+// draw command, so the CPU cost per frame does not depend on the instance count.
+class GpuCuller {
+private:
+    GLuint cullProgram = 0;
+    GLuint boundsSSBO = 0;            // vec4 sphere, vec4 boxMin, vec4 boxMax per instance
+    GLuint sourceTransformsSSBO = 0;  // All InstanceData records
+    GLuint visibleTransformsBuffer = 0;  // Compacted survivors, read as per-instance attributes
+    GLuint visibleIdsSSBO = 0;        // Source index of each survivor (for validation)
+    GLuint indirectBuffer = 0;        // One DrawElementsIndirectCommand
+    GLint planesLocation = -1;
+    GLint instanceCountLocation = -1;
+    size_t instanceCount = 0;
+    bool supported = false;
+
+public:
+    static const GLuint kWorkgroupSize = 64;
+
+    static bool isContextCapable();  // GL 4.3 or the equivalent ARB extensions
+    bool initialize();               // Returns false (and stays disabled) on 3.3 contexts
+    bool isSupported() const { return supported; }
+
+    void setInstances(const InstanceBoundsSoA& bounds, const std::vector<InstanceData>& instances);
+    size_t getInstanceCount() const { return instanceCount; }
+    GLuint getVisibleTransformBuffer() const { return visibleTransformsBuffer; }
+
+    // Dispatch the cull for this frame; indexCount is written into the indirect command
+    void cull(const Frustum& frustum, GLuint indexCount);
+    // Issue the indirect draw with a VAO whose instance attributes source getVisibleTransformBuffer()
+    void draw(GLuint program, GLuint vao);
+    // Synchronous readback of the survivors (validation only; stalls the pipeline)
+    std::vector<GLuint> readVisibleIds();
+
+    void cleanup();
+
+    // Headless comparison against the CPU culler; works on Mesa llvmpipe (LIBGL_ALWAYS_SOFTWARE=1)
+    static int runSelfTest(int instanceCount);
+};
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <functional>
+
+// GL setup shared by the headless benchmarks and self-tests: a hidden window whose context
+// (4.3 core when available) is current, an optional offscreen colour + depth/stencil target,
+// and blocking GPU timing of a draw. destroy() (or the destructor) releases everything and
+// terminates GLFW.
+class HeadlessContext {
+private:
+    GLFWwindow* window = nullptr;
+    GLuint framebuffer = 0, colorBuffer = 0, depthBuffer = 0;
+    GLuint query = 0;
+
+public:
+    ~HeadlessContext() { destroy(); }
+
+    // Initializes GLFW and GLEW; prints the renderer after 'tag' (e.g. "[BENCH]")
+    bool create(const char* title, const char* tag);
+    // A size x size RGBA8 target, left bound with its viewport and depth testing enabled
+    void createTarget(int size);
+    // Median GPU time of 'frames' calls of 'draw' after 'warmupFrames' untimed ones; each
+    // call is waited for, so the numbers are per draw rather than pipelined
+    double timeMedianMs(const std::function<void()>& draw, int warmupFrames, int frames);
+    void destroy();
+};
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class ThreadPool;
+
+// Result of comparing two RGBA8 images of the same size (alpha is ignored)
+struct ImageDiffResult {
+    double meanAbsError = 0.0;    // Per colour channel, 0-255
+    int maxError = 0;             // Largest single-channel difference
+    size_t differingPixels = 0;   // Pixels with any channel above the threshold
+    double ssim = 1.0;            // Mean SSIM of the 8x8 luma blocks
+    size_t pixelCount = 0;
+
+    double differingFraction() const { return pixelCount ? (double)differingPixels / pixelCount : 0.0; }
+};
+
+// Image comparison for the golden-image tests. Rows are processed in bands of 8 (one
+// SSIM block row) split across the worker pool; within a band, AVX2 handles 8 pixels per
+// instruction for both the per-pixel error and the SSIM moments.
+namespace ImageDiff {
+    bool cpuSupportsAVX2();
+
+    // 'pool' may be null (single-threaded). 'threshold' is clamped to [0, 254], the range in
+    // which a byte difference can exceed it (and the AVX2 kernel agrees with the scalar one).
+    ImageDiffResult compare(const uint8_t* a, const uint8_t* b, int width, int height,
+        int threshold, ThreadPool* pool, bool useAVX2);
+
+    // Synthetic throughput test: 'count' comparisons per variant at 1200x800, then a check
+    // that every variant agrees with the scalar one at the edge thresholds; 1 on a mismatch
+    int runBenchmark(int count);
+}
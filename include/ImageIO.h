@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Minimal image codecs for frame capture and the golden-image tests. Pixels are 8-bit,
+// rows top to bottom unless a flip is requested (GL readbacks are bottom-up).
+namespace ImageIO {
+    // RGB (3) or RGBA (4) channels; zlib 'level' 1 favours speed over size
+    bool writePNG(const std::string& path, int width, int height, int channels,
+        const uint8_t* pixels, bool flipY, int level = 1);
+    // Non-interlaced 8-bit gray/gray+alpha/RGB/RGBA PNGs, expanded to RGBA
+    bool readPNG(const std::string& path, int& width, int& height, std::vector<uint8_t>& rgba);
+
+    // RGBA to planar 4:2:0 (BT.601 studio range) as stored in a Y4M FRAME
+    void convertRGBAToI420(const uint8_t* rgba, int width, int height, bool flipY,
+        std::vector<uint8_t>& out);
+    std::string y4mHeader(int width, int height, int fps);
+}
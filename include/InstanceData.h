@@ -0,0 +1,32 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstddef>
+
+// One instance as the GPU consumes it: instance attributes 3-9 of the instanced VAOs and
+// a std430 struct in cull_instances.comp. The normal matrix is computed once on the CPU
+// when the field is built, so the vertex shader never inverts a matrix.
+struct InstanceData {
+    glm::mat4 model;              // Attributes 3-6
+    glm::vec4 normalMatrix[3];    // Attributes 7-9: columns of inverse-transpose(mat3(model)), w unused
+};
+static_assert(sizeof(InstanceData) == 112, "InstanceData must match the std430 layout in cull_instances.comp");
+
+namespace InstanceTransforms {
+    // Inverse-transpose of the upper 3x3 via cross products of its columns
+    glm::mat3 normalMatrix(const glm::mat4& model);
+
+    // Batch kernels over AoS matrices: fill out[i].model and out[i].normalMatrix
+    void computeScalar(const glm::mat4* models, size_t count, InstanceData* out);
+    void computeAVX2(const glm::mat4* models, size_t count, InstanceData* out);  // 8 per iteration
+    std::vector<InstanceData> build(const std::vector<glm::mat4>& models, bool useAVX2);
+
+    // Points attributes 3-9 of the bound VAO at the bound GL_ARRAY_BUFFER (divisor 1)
+    void setupAttributes();
+
+    // CPU batch throughput, plus GPU time of the instanced high-poly mesh with the normal
+    // matrix inverted per vertex vs supplied per instance (hidden window, then exits)
+    int runBenchmark(int instanceCount);
+}
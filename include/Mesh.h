@@ -0,0 +1,83 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+// Interleaved vertex with the cube layout (position, normal, color at locations 0-2)
+struct MeshVertex {
+    glm::vec3 position;
+    glm::vec3 normal;
+    glm::vec3 color;
+};
+
+// Indexed triangle list
+struct MeshData {
+    std::vector<MeshVertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+// Sources of high-poly geometry
+namespace MeshBuilder {
+    // Welded cube with bevelled edges: 'segments' quads along each face edge, edges rounded
+    // by 'edgeRadius' (fraction of the half extent). Fits [-0.5, 0.5]^3 like the cube.
+    MeshData generateRoundedCube(int segments, float edgeRadius);
+    // Minimal Wavefront OBJ loader (v/vn/f, polygons are fanned), recentred and scaled
+    // to fit [-0.5, 0.5]^3. Missing normals are rebuilt as smooth normals.
+    bool loadOBJ(const std::string& path, MeshData& mesh);
+    // Cube face colors blended by normal direction
+    glm::vec3 paletteColor(const glm::vec3& normal);
+}
+
+// Mesh processing used while building a LOD chain
+namespace MeshOptimizer {
+    // Quadric error simplification (Garland-Heckbert) by half-edge collapses, so the result
+    // only references existing vertices and all LODs can share one vertex buffer. Open
+    // borders and attribute seams are locked. resultError receives the largest RMS distance
+    // (object units) a collapse introduced.
+    std::vector<uint32_t> simplify(const std::vector<MeshVertex>& vertices, const std::vector<uint32_t>& indices,
+        size_t targetIndexCount, float* resultError);
+    // Forsyth's linear-speed post-transform vertex cache ordering
+    void optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount);
+    // Splits the cache-ordered triangles into clusters and draws outward-facing clusters first.
+    // threshold bounds the cache efficiency traded for it (1.05 = up to 5% worse ACMR)
+    void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<MeshVertex>& vertices, float threshold);
+    // Average cache miss ratio (vertex shader invocations per triangle) for a FIFO cache
+    float computeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize);
+}
+
+struct MeshLOD {
+    GLuint firstIndex;   // Offset into the shared element buffer
+    GLsizei indexCount;
+    float error;         // Object-space geometric error relative to LOD 0
+};
+
+// LOD chain built at load time. Every level lives in one VAO: a shared vertex buffer
+// ordered by first use from the coarsest level down, and the index ranges back to back.
+class MeshLODChain {
+private:
+    MeshData combined;  // CPU copy until upload()
+    std::vector<MeshLOD> lods;
+    float boundingRadius = 0.0f;
+    GLuint vao = 0, vbo = 0, ebo = 0;
+
+public:
+    // Simplify and optimize (CPU only); each level keeps ~reductionPerLevel of the previous triangles
+    void build(const MeshData& source, int lodCount, float reductionPerLevel);
+    bool upload();  // uploadBuffers() + createVertexArray(); needs a current context
+    // The vertex and index buffers (any context sharing objects with the one that draws)
+    bool uploadBuffers();
+    // The VAO over the uploaded buffers, in the context that draws: VAOs are not shared
+    bool createVertexArray();
+    void draw(GLuint program, int lod) const;
+    // Coarsest level whose error projects to at most maxPixelError pixels at this camera distance
+    int selectLOD(float distance, float fovY, int viewportHeight, float maxPixelError) const;
+    int getLODCount() const { return (int)lods.size(); }
+    bool isUploaded() const { return vao != 0; }
+    const MeshLOD& getLOD(int lod) const { return lods[lod]; }
+    float getBoundingRadius() const { return boundingRadius; }
+    void cleanup();
+};
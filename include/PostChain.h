@@ -0,0 +1,61 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <string>
+#include <vector>
+#include "RenderGraph.h"
+
+class CubeRenderer;
+class ShaderHotReloader;
+
+// Post-processing on the presented image, one render graph pass (or group of passes) per
+// QualityEffect post bit, run in bit order: bloom, tone mapping, colour grading, vignette.
+// Bloom blurs a thresholded copy down a chain of kBloomLevels half-resolution targets
+// (separable Gaussian, the horizontal pass doing the downsample) and adds each level back
+// onto the next finer one on the way up before compositing. Every intermediate image is a
+// transient of the graph and the last enabled effect draws into the output, so disabled
+// effects cost nothing and each effect's GPU time is read back per pass.
+class PostChain {
+private:
+    GLuint blurProgram = 0;
+    GLuint upsampleProgram = 0;
+    GLuint compositeProgram = 0;
+    GLuint toneMapProgram = 0;
+    GLuint colorGradeProgram = 0;
+    GLuint vignetteProgram = 0;
+    int width = 0, height = 0;
+
+    RenderTargetDesc getBloomDesc(int level) const;
+    void declareBloom(RenderGraph& graph, RenderGraph::Resource source, RenderGraph::Resource output,
+        CubeRenderer& renderer);
+    void drawQuad(GLuint program, GLuint texture, CubeRenderer& renderer);
+
+public:
+    static const int kBloomLevels = 4;  // 1/2 down to 1/16 resolution
+
+    float bloomThreshold = 0.6f;   // Brightness where the glow starts
+    float bloomKnee = 0.2f;        // Soft transition around the threshold
+    float bloomIntensity = 0.6f;
+    float exposure = 1.0f;
+    float saturation = 1.15f;
+    float contrast = 1.08f;
+    glm::vec3 colorBalance = glm::vec3(1.04f, 1.0f, 0.95f);  // Slightly warm
+    float vignetteIntensity = 0.35f;
+    float vignetteRadius = 0.75f;
+    float vignetteSoftness = 0.45f;
+
+    bool initialize(int width, int height);
+    // Description of the image the chain reads (the presented frame at the output resolution)
+    RenderTargetDesc getTargetDesc() const;
+    // Adds the passes of the post bits in 'effects' reading 'source' and ending in 'output';
+    // with no post bits nothing is added
+    void declare(RenderGraph& graph, uint32_t effects, RenderGraph::Resource source, RenderGraph::Resource output,
+        CubeRenderer& renderer);
+    // Names of the graph passes that make up one post effect bit
+    static std::vector<std::string> getPassNames(uint32_t effect);
+    // Summed GPU time of the post effects in 'effects' in the graph's last retired frame
+    static float getEffectMs(const RenderGraph& graph, uint32_t effects);
+    void watch(ShaderHotReloader& reloader);
+    void cleanup();
+};
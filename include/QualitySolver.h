@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Lighting model of the cube über-shader variant (see ShaderFeature)
+enum class ShadingModel : int {
+    Unlit = 0,    // Vertex colours only
+    Lambert = 1,  // + diffuse
+    Phong = 2,    // + specular highlight and distance attenuation
+};
+
+// Optional passes around the scene render; at most one of the present paths is set. The
+// post effects run on the presented image, in bit order (see PostChain).
+namespace QualityEffect {
+    enum : uint32_t {
+        SpatialUpscale   = 1u << 0,  // Edge-adaptive upscale + CAS instead of the pixelate present
+        TemporalUpsample = 1u << 1,  // Jittered render accumulated at full resolution
+        Checkerboard     = 1u << 2,  // Shade half the pixels per frame (cheaper, slightly worse)
+        Bloom            = 1u << 3,  // Thresholded glow blurred down a mip chain
+        ToneMap          = 1u << 4,  // Exposure + filmic curve
+        ColorGrade       = 1u << 5,  // Contrast, saturation and colour balance
+        Vignette         = 1u << 6,  // Darkened corners
+    };
+    const int kCount = 7;
+    const int kFirstPost = 3;  // Bits from here on are post effects
+    const uint32_t kPost = Bloom | ToneMap | ColorGrade | Vignette;
+
+    std::string toString(uint32_t effects);  // "SPATIAL|CHECKERBOARD", for logs and the UI
+    bool fromString(const std::string& names, uint32_t& effects);  // Inverse of toString ("NONE" = 0)
+}
+
+// One independent setting per knob, replacing the single low/medium/high level
+struct QualityVector {
+    int scaleTier;        // Render scale as the quality tier (and FBO) it draws into
+    int msaaSamples;      // 0, 2 or 4
+    ShadingModel shading;
+    int meshLOD;          // 0 = full detail ... 3 = coarsest
+    float fpsCap;         // 0 = uncapped (the user's target only)
+    uint32_t effects;     // QualityEffect bits
+
+    bool operator==(const QualityVector& other) const;
+    bool operator!=(const QualityVector& other) const { return !(*this == other); }
+};
+
+// Estimated GPU cost of each knob in ms per frame at the full 1200x800 output. Pixel costs
+// scale with the render scale's pixel count; effect costs are paid at the output resolution.
+// The defaults are rough figures for a mid-range discrete GPU.
+struct QualityCostTable {
+    float baseMs = 0.3f;                          // Clear, present and UI
+    float shadingMs[3] = {0.6f, 0.8f, 1.1f};      // Scene pass per ShadingModel
+    float msaaMs[3] = {0.0f, 0.5f, 1.0f};         // Extra for 0/2/4 samples, resolve included
+    float meshLodMs[4] = {1.2f, 0.5f, 0.2f, 0.08f};
+    float effectMs[QualityEffect::kCount] = {0.35f, 0.45f, 0.25f, 0.4f, 0.15f, 0.15f, 0.1f};
+    float checkerboardShadingScale = 0.55f;       // Fraction of the shading cost still paid
+
+    // Sections of the cost file are keyed by GL_RENDERER, so one file serves several GPUs.
+    // load returns false (leaving the table untouched) when the renderer has no section.
+    bool load(const std::string& path, const std::string& renderer);
+    bool save(const std::string& path, const std::string& renderer) const;  // Replaces its section
+    void print(std::ostream& out) const;
+};
+
+// What the fuzzy controller's budget limits
+enum class BudgetMode : int {
+    Power = 0,      // GPU work per second: frame cost x frame rate
+    FrameTime = 1,  // GPU work per frame
+};
+
+// Picks the quality vector with the highest perceptual score whose estimated cost fits the
+// budget. The budget is a fraction of the cost of the best vector (1 = everything at maximum),
+// so it is independent of the machine; the per-knob cost table converts vectors to ms, and
+// every candidate must also fit its own frame interval. The knobs other than the post effects
+// are enumerated exhaustively (3456 vectors with four tiers); post effects add cost and score
+// independently of them, so each takes the best of the 16 post subsets that still fits
+// rather than multiplying the search to ~55k. About 0.1 ms per solve, which runs on every
+// budget change.
+class QualitySolver {
+private:
+    QualityCostTable costs;
+    int maxSamples = 4;
+    std::vector<float> renderScales = {0.5f, 0.75f, 1.0f};  // Per scale tier
+
+    float frameRate(const QualityVector& vector, float targetFps) const;
+
+public:
+    static const float kFpsCaps[3];  // Candidate caps; 0 = the user's target
+    static const float kTierBudgets[3];  // Budget of compute_quality's low/medium/high levels
+    static const char* const kCostTablePath;  // Calibrated cost tables, one section per GPU
+
+    void setCostTable(const QualityCostTable& table) { costs = table; }
+    const QualityCostTable& getCostTable() const { return costs; }
+    void setMaxSamples(int samples) { maxSamples = samples; }
+    // One per quality tier, indexed by QualityVector::scaleTier
+    void setRenderScales(const std::vector<float>& scales) { renderScales = scales; }
+    int getScaleTierCount() const { return (int)renderScales.size(); }
+    float getRenderScale(int scaleTier) const { return renderScales[scaleTier]; }
+
+    float estimateFrameMs(const QualityVector& vector) const;
+    // In the budget's units: ms per frame, or GPU ms per second of the vector's frame rate
+    float estimateCost(const QualityVector& vector, BudgetMode mode, float targetFps) const;
+    float score(const QualityVector& vector, float targetFps) const;
+
+    QualityVector maximum() const;  // Every knob at its best
+    QualityVector minimum() const;  // Every knob at its cheapest
+    QualityVector solve(BudgetMode mode, float budget, float targetFps) const;
+
+    std::string toString(const QualityVector& vector) const;
+};
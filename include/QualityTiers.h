@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One rendering preset of the tier-based controller. A tier's index in its registry is what
+// the controller outputs, what the manual override keys select and which FBO it draws into.
+struct QualityTier {
+    std::string name;
+    float renderScale = 1.0f;           // Of the 1200x800 output, per axis
+    std::string program = "smooth";     // unlit, wireframe, flat, smooth, or FEATURE names joined by '|'
+    uint32_t shaderFeatures = 0;        // ShaderFeature bits resolved from 'program'
+    bool wireframe = false;             // Draw edges only (glPolygonMode GL_LINE)
+    bool simpleGeometry = false;        // Non-indexed 36-vertex cube instead of the indexed one
+    float pixelSize = 200.0f;           // Grid of the pixelate present pass (larger = finer)
+    std::string present = "pixelate";   // Or a fragment shader in shaders/, drawn over screen.vert
+    int meshLOD = 0;                    // Level of the LOD mesh (0 = full detail)
+    bool checkerboard = false;          // Shade half the pixels per frame and reconstruct the rest
+    int msaaSamples = 0;                // Samples of the tier's FBO while MSAA is enabled
+    int shadowMapSize = 0;              // Shadow map resolution (0 = no shadows; lit programs only)
+    int shadowPCF = 0;                  // PCF kernel radius: (2r+1)^2 shadow taps
+    uint32_t postEffects = 0;           // QualityEffect post bits on the presented image
+    float fpsCap = 0.0f;                // Frame rate cap at this tier (0 = uncapped)
+    float budget = 1.0f;                // Controller budget (QualitySolver units) the tier stands for
+    bool temporal = false;              // Temporal upsampling; set at run time, not from the file
+
+    int renderWidth() const;
+    int renderHeight() const;
+};
+
+// The tiers, cheapest first, read from a config file of sections like
+//
+//     [Medium]
+//     scale 0.75
+//     program flat
+//     geometry indexed
+//     ...
+//
+// (see quality_tiers.cfg for every key). The controller's budget selects the tier whose own
+// budget is nearest, so any number of tiers can be added without touching the code.
+class QualityTierRegistry {
+private:
+    std::vector<QualityTier> tiers;
+
+    static bool resolveProgram(QualityTier& tier);
+
+public:
+    static const char* const kDefaultPath;
+    static const int kOutputWidth = 1200, kOutputHeight = 800;
+    static const int kMaxTiers = 9;  // Keys 1-9 select them
+
+    QualityTierRegistry();  // The built-in low/medium/high tiers
+    // Replaces the tiers with the file's; a missing or invalid file keeps the current ones
+    bool load(const std::string& path);
+
+    int size() const { return (int)tiers.size(); }
+    QualityTier& operator[](int index) { return tiers[index]; }
+    const QualityTier& operator[](int index) const { return tiers[index]; }
+    int find(const std::string& name) const;  // Case-insensitive; -1 when there is none
+    // Sets the Shadows feature from shadowMapSize, or zeroes the size on unlit programs
+    static void resolveShadows(QualityTier& tier);
+    int clamp(int index) const;
+    int selectForBudget(float budget) const;  // Nearest budget; ties go to the better tier
+    int highest() const;  // Largest render scale (the solver's maximum)
+    std::vector<float> getRenderScales() const;
+};
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+// Size and format of a transient render target; targets with equal descriptions can share
+// one pooled texture
+struct RenderTargetDesc {
+    int width = 0, height = 0;
+    GLenum format = GL_RGBA8;
+    GLenum filter = GL_LINEAR;
+    bool operator==(const RenderTargetDesc& other) const;
+};
+
+// Declarative frame: every frame the passes are declared in execution order with the
+// resources they read and write. compile() culls each pass that neither writes a resource
+// something live reads (or an output) nor has side effects, and finds the first and last
+// live pass touching each transient target. execute() then draws the live passes, taking
+// transient targets from a pool when their lifetime starts and returning them when it
+// ends, so targets whose lifetimes do not overlap alias one texture. Each pass is
+// bracketed by GL_TIMESTAMP queries kept per frame slot and read back once FrameQueue has
+// retired that slot, so the timing never stalls. It is the only per-pass GPU timing.
+class RenderGraph {
+public:
+    typedef int Resource;  // Valid until the next reset()
+    static const Resource kNone = -1;
+
+    struct PassInfo {
+        std::string name;
+        bool culled;
+        float gpuMs;  // Of the last timed frame that ran it
+    };
+
+private:
+    struct ResourceNode {
+        std::string name;
+        bool transient;
+        RenderTargetDesc desc;
+        GLuint texture, framebuffer;  // Imported: as given; transient: while acquired
+        bool output;
+        int readers;  // Live readers (+1 for outputs) while compiling
+        int firstPass, lastPass;
+        int poolEntry;
+    };
+    struct PassNode {
+        std::string name;
+        std::vector<Resource> reads, writes;
+        std::function<void()> execute;
+        bool sideEffect;
+        int liveWrites;  // Written resources still read while compiling
+        bool culled;
+    };
+    struct PoolEntry {
+        RenderTargetDesc desc;
+        GLuint texture = 0, framebuffer = 0;
+        bool inUse = false;
+        unsigned long long lastUsedFrame = 0;
+    };
+    struct TimingSlot {
+        std::vector<GLuint> queries;  // Begin/end timestamp pair per executed pass
+        std::vector<std::string> passNames;
+        int issued = 0;
+    };
+    static const unsigned long long kPoolRetainFrames = 300;  // Unused this long: freed
+
+    std::vector<ResourceNode> resources;
+    std::vector<PassNode> passes;
+    std::vector<PoolEntry> pool;
+    std::vector<TimingSlot> timingSlots;
+    std::map<std::string, float> passMs;
+    std::map<std::string, float> lastKnownMs;  // Survives frames where a pass is culled
+    unsigned long long frame = 0;
+    bool timestampsSupported = false;
+    int aliasedTargets = 0;
+
+    int acquire(const RenderTargetDesc& desc);
+    void collectTimings(TimingSlot& slot);
+    void trimPool();
+
+public:
+    void initialize();
+    // Starts declaring a new frame; pooled targets are kept
+    void reset();
+    // An existing texture and/or framebuffer (0 for the default framebuffer)
+    Resource importTarget(const std::string& name, GLuint texture, GLuint framebuffer);
+    // A target that only lives between its first and last live pass this frame
+    Resource createTarget(const std::string& name, const RenderTargetDesc& desc);
+    // Keeps every pass that contributes to the resource
+    void markOutput(Resource resource);
+    // kNone entries in reads/writes are ignored, so optional inputs can be passed as-is
+    void addPass(const std::string& name, const std::vector<Resource>& reads, const std::vector<Resource>& writes,
+        std::function<void()> execute, bool sideEffect = false);
+    void compile();
+    // Runs the live passes in declaration order; slot is FrameQueue::getSlot()
+    void execute(int slot);
+
+    // Valid inside the pass callbacks (transient targets only while acquired)
+    GLuint getTexture(Resource resource) const { return resources[resource].texture; }
+    GLuint getFramebuffer(Resource resource) const { return resources[resource].framebuffer; }
+
+    // GPU time of the pass in the last retired frame, 0 when it did not run there
+    float getPassMs(const std::string& name) const;
+    std::vector<PassInfo> describe() const;  // This frame's passes, culled ones included
+    int getPoolSize() const { return (int)pool.size(); }
+    size_t getPoolBytes() const;
+    int getAliasedTargets() const { return aliasedTargets; }  // Last frame's targets sharing a texture
+    void cleanup();
+};
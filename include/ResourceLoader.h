@@ -0,0 +1,90 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <string>
+#include <deque>
+#include <set>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+// Creates GL resources off the render thread. A loader thread owns a hidden context sharing
+// objects with the main one and runs each job's load step there: the CPU work plus the
+// buffers, textures and programs it needs, followed by a fence. The job's finish step runs
+// on the render thread in update() once that fence has signalled, so a frame never sees a
+// half-uploaded object. Container objects (VAOs, FBOs) are not shared between contexts and
+// belong in the finish step. Without a shared context, update() runs one queued job per
+// frame on the render thread instead.
+class ResourceLoader {
+public:
+    enum class Mode { Synchronous, LoaderThread };
+    typedef unsigned long long Ticket;
+    // Runs on the loader thread with its context current; false on failure
+    typedef std::function<bool()> LoadStep;
+    // Runs on the render thread with the load step's result
+    typedef std::function<void(bool)> FinishStep;
+
+private:
+    struct Job {
+        Ticket ticket;
+        std::string name;
+        LoadStep load;
+        FinishStep finish;
+    };
+    // Load step done, waiting for its fence before the finish step
+    struct LoadedJob {
+        Ticket ticket;
+        std::string name;
+        FinishStep finish;
+        bool success;
+        GLsync fence;
+        float loadMs;
+    };
+
+    Mode mode = Mode::Synchronous;
+    std::thread loaderThread;
+    bool running = false;
+    GLFWwindow* loaderContext = nullptr;  // Hidden window sharing objects with the main context
+
+    std::mutex mutex;
+    std::condition_variable loaderWake, jobLoaded;
+    std::deque<Job> queued;         // Submitted (render thread -> loader)
+    std::deque<LoadedJob> loaded;   // Load step done (loader -> render thread)
+    Ticket nextTicket = 1;
+    std::set<Ticket> unfinished;    // Render thread only
+    int finishedJobs = 0;
+
+    void loaderLoop();
+    LoadedJob runLoad(Job& job);
+    void finish(LoadedJob& job);
+
+public:
+    ~ResourceLoader() { stop(); }
+
+    // Creates the loader context and thread. Must be called on the render thread with the
+    // main context current; on failure the loader stays synchronous.
+    bool start(GLFWwindow* mainWindow);
+    // Joins the thread: jobs already loaded are finished, queued ones are finished with false
+    void stop();
+    Mode getMode() const { return mode; }
+    static const char* getModeName(Mode mode);
+
+    // Queues a job (render thread only); the ticket identifies it to wait() and isFinished()
+    Ticket submit(const std::string& name, LoadStep load, FinishStep finish);
+    // Queues a PNG/JPEG/... decode and its mipmapped RGBA8 upload. 'texture' is set when the
+    // job finishes and must outlive it; it stays unchanged if the image cannot be read.
+    Ticket loadTexture(const std::string& path, GLuint& texture);
+    // Call once per frame: runs the finish step of every job whose fence has signalled.
+    // Never blocks. Returns the number finished.
+    int update();
+    // Blocks until the job has finished, moving it to the front of the queue if the loader
+    // has not started it, so a frame that needs one asset does not wait for the others
+    void wait(Ticket ticket);
+    void waitIdle();
+    bool isFinished(Ticket ticket) const { return unfinished.count(ticket) == 0; }
+    bool isIdle() const { return unfinished.empty(); }
+    int getPendingCount() const { return (int)unfinished.size(); }
+    int getFinishedCount() const { return finishedJobs; }
+};
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <GLFW/glfw3.h>
+#include <string>
+#include <vector>
+#include <set>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+
+// Rebuilds programs whose sources change on disk without stalling the render thread.
+// An inotify thread watches the shader directory; changed programs are compiled either
+// with KHR/ARB_parallel_shader_compile (issued on the render thread, polled without
+// blocking) or on a loader thread that owns a hidden context sharing objects with the
+// main one. Finished programs are swapped into the owner's handle at the start of a
+// frame, once their fence has signalled, so a frame never sees a half-built program.
+class ShaderHotReloader {
+public:
+    enum class Mode { Disabled, ParallelCompile, LoaderThread };
+
+private:
+    struct WatchedProgram {
+        GLuint* handle;  // Owner's handle, replaced at a frame boundary; null once unwatched
+        std::string vertexPath, fragmentPath;
+        std::string defines;  // Inserted after #version (über-shader variants)
+        std::string name;     // For logs
+    };
+    // Program whose compile/link was issued but not yet checked
+    struct PendingBuild {
+        size_t index;
+        GLuint program, vertexShader, fragmentShader;
+        std::chrono::steady_clock::time_point startTime;
+    };
+    // Linked program waiting for its fence before the swap
+    struct ReadyProgram {
+        size_t index;
+        GLuint program;
+        GLsync fence;
+        float buildMs;
+    };
+
+    std::vector<WatchedProgram> programs;
+    std::mutex programsMutex;  // Guards 'programs': watch() may run while the threads read it
+    std::string directory;
+    Mode mode = Mode::Disabled;
+
+    int inotifyFd = -1;
+    std::thread watcherThread, loaderThread;
+    std::atomic<bool> running{false};
+    GLFWwindow* loaderContext = nullptr;  // Hidden window sharing objects with the main context
+
+    std::mutex mutex;  // Taken before programsMutex when both are held
+    std::condition_variable loaderWake;
+    std::set<size_t> dirty;            // Programs whose sources changed (watcher -> builder)
+    std::vector<ReadyProgram> ready;   // Built programs (builder -> render thread)
+    std::vector<PendingBuild> inFlight;  // Parallel-compile builds (render thread only)
+
+    void watcherLoop();
+    void loaderLoop();
+    WatchedProgram getProgram(size_t index);  // Copy, safe against concurrent watch()
+    PendingBuild startBuild(size_t index);  // Issues compile + link without querying status
+    GLuint finishBuild(const PendingBuild& build);  // Checks status (blocks if not complete); 0 on error
+
+public:
+    ~ShaderHotReloader() { stop(); }
+
+    // Starts watching 'shaderDirectory'. Must be called on the render thread with the main
+    // context current. Returns false (and stays disabled) when inotify is unavailable.
+    bool start(GLFWwindow* mainWindow, const std::string& shaderDirectory);
+    void stop();  // Joins the threads and drops unswapped programs; main context current
+    Mode getMode() const { return mode; }
+    static const char* getModeName(Mode mode);
+
+    // Registers a program to rebuild when either source file changes (before or after start())
+    void watch(GLuint* handle, const std::string& vertexPath, const std::string& fragmentPath,
+        const std::string& defines = "", const std::string& variantName = "");
+    // Stops rebuilding into 'handle' (its owner is about to delete it); render thread only
+    void unwatch(GLuint* handle);
+
+    // Call once per frame before rendering: advances parallel builds and swaps every program
+    // whose build has completed on the GPU. Never blocks. Returns the number swapped.
+    int update();
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include "ResourceLoader.h"
+
+class ShaderHotReloader;
+
+// Feature toggles of the cube über-shader (shaders/cube.vert + shaders/cube.frag). Bit i
+// becomes "#define FEATURE_<NAME>" in the variant, so a new quality knob costs one bit
+// here and an #ifdef block in the shader.
+namespace ShaderFeature {
+    enum : uint32_t {
+        VertexColors = 1u << 0,  // Per-face vertex colors (otherwise the objectColor uniform)
+        Diffuse      = 1u << 1,  // Lambert term
+        Specular     = 1u << 2,  // Phong highlight (needs viewPos)
+        Attenuation  = 1u << 3,  // Distance falloff of diffuse + specular
+        Instanced    = 1u << 4,  // Per-instance model + normal matrix at attribute locations 3-9
+        MotionVectors = 1u << 5, // Screen-space velocity to color attachment 1 (temporal upsampling)
+        Shadows      = 1u << 6,  // Shadow-map lookup with PCF (lit variants; needs lightSpaceMatrix)
+    };
+    const int kCount = 7;
+
+    std::string toDefines(uint32_t features);  // One "#define FEATURE_X" line per set bit
+    std::string toString(uint32_t features);   // "VERTEX_COLORS|DIFFUSE", for logs
+    bool fromString(const std::string& names, uint32_t& features);  // Inverse of toString
+}
+
+// Variants of one über-shader, compiled on first request (or queued on the resource
+// loader) and cached by feature bitmask. Handles stay valid for the lifetime of the object
+// (the hot-reloader swaps them in place).
+class ShaderPermutations {
+private:
+    std::string vertexPath, fragmentPath;
+    std::unordered_map<uint32_t, GLuint> programs;
+    std::unordered_map<uint32_t, ResourceLoader::Ticket> loading;  // Variants the loader still builds
+    ResourceLoader* loader = nullptr;
+    ShaderHotReloader* reloader = nullptr;  // Set by watch(); later variants register themselves
+
+    void track(uint32_t features);  // Registers a new variant with the reloader, if any
+
+public:
+    ShaderPermutations(const std::string& vertexPath, const std::string& fragmentPath)
+        : vertexPath(vertexPath), fragmentPath(fragmentPath) {}
+
+    GLuint get(uint32_t features);  // Compiles (or loads from the binary cache) on a miss
+    // Builds the variant on the loader thread. Its handle exists (as 0) right away, so it can
+    // be watched; get() on it waits for that one job.
+    void load(uint32_t features, ResourceLoader& resourceLoader);
+    size_t getVariantCount() const { return programs.size(); }
+    std::vector<GLuint> getPrograms() const;
+    // Registers every variant compiled so far, and every one created from then on
+    void watch(ShaderHotReloader& hotReloader);
+    void cleanup();
+};
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+class ShaderHotReloader;
+
+// Depth-only pass from the scene's light, sampled by the cube über-shader's FEATURE_SHADOWS
+// with a (2r+1)^2 PCF kernel. The light is treated as directional, looking from its
+// position at the origin with an orthographic frustum around the object, so the ground
+// plane only receives shadows and never needs drawing into the map. The map is
+// reallocated when the tier's size changes, like the checkerboard resolve targets.
+class ShadowMapRenderer {
+private:
+    GLuint depthProgram = 0;
+    GLuint framebuffer = 0;
+    GLuint depthTexture = 0;  // DEPTH_COMPONENT24 with compare mode (sampler2DShadow)
+    int size = 0;
+    glm::mat4 lightSpaceMatrix = glm::mat4(1.0f);
+
+public:
+    static const int kMinSize = 256, kMaxSize = 4096;
+    static const int kMaxPcfRadius = 3;  // 7x7 taps
+
+    bool initialize(int size);
+    // Reallocates the map at size x size (no-op at the same size)
+    void resize(int size);
+    // Binds the map, clears it and returns the depth program with lightSpaceMatrix set; draw
+    // the casters with their 'model' uniform, then call end()
+    GLuint begin(const glm::vec3& lightPos, float sceneRadius);
+    void end();
+    void bindTexture(int unit) const;
+    const glm::mat4& getLightSpaceMatrix() const { return lightSpaceMatrix; }
+    int getSize() const { return size; }
+    void watch(ShaderHotReloader& reloader);
+    void cleanup();
+};
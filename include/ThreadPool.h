@@ -0,0 +1,41 @@
+#pragma once
+
+#include <thread>
+#include <vector>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+// Persistent worker pool for data-parallel CPU stages (culling, compaction, ...)
+// The calling thread always participates as worker 0, so a pool of N threads
+// spawns N-1 background workers.
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable wakeCondition;
+    std::condition_variable doneCondition;
+    std::function<void(int)> currentJob;
+    unsigned int jobGeneration = 0;
+    int pendingWorkers = 0;
+    bool stopping = false;
+
+    void workerLoop(int workerIndex);
+
+public:
+    explicit ThreadPool(int threadCount = 0);  // 0 = use hardware concurrency
+    ~ThreadPool();
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    int getThreadCount() const { return (int)workers.size() + 1; }
+
+    // Run job(threadIndex) once on every thread and block until all have returned
+    void runOnAll(const std::function<void(int)>& job);
+
+    // Split [0, count) into one contiguous range per thread (aligned to 'alignment')
+    // and run body(begin, end) on each. Small ranges run inline on the caller.
+    void parallelFor(size_t count, size_t minPerThread, size_t alignment,
+        const std::function<void(size_t, size_t)>& body);
+};
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include "RenderGraph.h"
+
+class CubeRenderer;
+class ShaderHotReloader;
+
+// How the low-res quality FBO reaches the window
+enum class PresentMode : int {
+    Pixelate = 0,        // pixelate.frag: nearest-grid snapping (the original look)
+    SpatialUpscale = 1,  // Edge-adaptive upsample + contrast-adaptive sharpening
+};
+
+// Two fullscreen passes modelled on FSR 1: upscale_easu.frag resamples the source with a
+// 12-tap Lanczos-like kernel stretched along the local edge direction (clamped to the
+// nearest 2x2 texels to avoid ringing) into a full-resolution target, then sharpen_cas.frag
+// sharpens it by an amount that backs off in high-contrast areas. The passes are separate
+// render graph nodes: the full-resolution target is a transient of the graph, and a
+// source already at the output resolution skips straight to the sharpening pass.
+class SpatialUpscaler {
+private:
+    GLuint upscaleProgram = 0;
+    GLuint sharpenProgram = 0;
+    int outputWidth = 0, outputHeight = 0;
+
+public:
+    bool initialize(int width, int height);
+    bool needsUpscale(int sourceWidth, int sourceHeight) const {
+        return sourceWidth != outputWidth || sourceHeight != outputHeight;
+    }
+    // Description of the target upscale() draws into
+    RenderTargetDesc getTargetDesc() const;
+    // Resamples sourceTexture (sourceWidth x sourceHeight) into the bound framebuffer at
+    // the output resolution
+    void upscale(GLuint sourceTexture, int sourceWidth, int sourceHeight, CubeRenderer& renderer);
+    // Sharpens sourceTexture (at the output resolution) into the bound framebuffer;
+    // sharpness is 0 (soft) to 1 (maximum)
+    void sharpen(GLuint sourceTexture, float sharpness, CubeRenderer& renderer);
+    void watch(ShaderHotReloader& reloader);
+    void cleanup();
+};
+
+// Temporal upsampling: each frame is rendered at the tier's resolution with a sub-pixel
+// jitter (Halton 2,3) and the cube shader's FEATURE_MOTION_VECTORS velocity output.
+// temporal_resolve.frag reprojects the full-resolution history along the velocity,
+// clips it to the variance box of the current 3x3 neighbourhood and blends in the new
+// samples weighted by their distance to each output pixel, so over a few frames the
+// low-res tiers converge towards a full-resolution image.
+class TemporalUpsampler {
+private:
+    GLuint resolveProgram = 0;
+    GLuint historyFramebuffers[2] = {0, 0};
+    GLuint historyTextures[2] = {0, 0};  // RGBA16F at the output resolution, ping-ponged
+    int historyIndex = 0;  // Texture holding the latest resolve
+    bool historyValid = false;
+    int historySourceWidth = 0, historySourceHeight = 0;
+    int outputWidth = 0, outputHeight = 0;
+    unsigned int jitterIndex = 0;
+
+public:
+    static const unsigned int kJitterPhases = 8;
+
+    bool initialize(int width, int height);
+    // Next offset of the sequence, in render pixels within [-0.5, 0.5]
+    glm::vec2 nextJitter();
+    // Shifts the image by 'jitter' render pixels (a clip-space translation)
+    static glm::mat4 jitterProjection(const glm::mat4& projection, glm::vec2 jitter,
+        int renderWidth, int renderHeight);
+    // Call on frames that do not resolve, so stale history is never reprojected
+    void invalidateHistory() { historyValid = false; }
+    // Resolves into the history and blits it to targetFramebuffer (0: the window)
+    void resolve(GLuint colorTexture, GLuint velocityTexture, int sourceWidth, int sourceHeight,
+        glm::vec2 jitter, GLuint targetFramebuffer, CubeRenderer& renderer);
+    void watch(ShaderHotReloader& reloader);
+    void cleanup();
+};
+
+// Checkerboard rendering: a stencil pattern written once into the tier's FBO (1 on even
+// cells, 2 on odd) restricts shading to half the pixels, alternating every frame.
+// checkerboard_resolve.frag keeps the shaded half and fills the other from the previous
+// resolve, reprojected along the neighbours' motion vectors and clamped to their colour
+// range, falling back to edge-directed interpolation where there is no usable history.
+class CheckerboardRenderer {
+private:
+    GLuint maskProgram = 0;
+    GLuint resolveProgram = 0;
+    GLuint resolvedFramebuffers[2] = {0, 0};
+    GLuint resolvedTextures[2] = {0, 0};  // Full-resolution result, ping-ponged as history
+    int resolvedIndex = 0;
+    bool historyValid = false;
+    GLuint maskedFramebuffer = 0;  // FBO whose stencil holds the pattern
+    int width = 0, height = 0;
+    unsigned int frameIndex = 0;
+    int parity = 0;
+
+public:
+    bool initialize(int width, int height);
+    // With the tier's FBO bound (and cleared without its stencil): writes the pattern on
+    // first use and enables the stencil test for this frame's half
+    void beginFrame(GLuint framebuffer, CubeRenderer& renderer);
+    void endFrame();
+    // Reconstructs the full image; returns the texture to present
+    GLuint resolve(GLuint colorTexture, GLuint velocityTexture, CubeRenderer& renderer);
+    void invalidateHistory() { historyValid = false; }
+    // Frames drawn so far; its parity picks the half shaded next
+    unsigned int getFrameIndex() const { return frameIndex; }
+    void setFrameIndex(unsigned int index) { frameIndex = index; }
+    // The FBO was rebuilt (possibly reusing its name): write the pattern again
+    void invalidateMask() { maskedFramebuffer = 0; }
+    // Reallocates the resolve targets for another tier's resolution (no-op at the same size)
+    void resize(int width, int height);
+    void watch(ShaderHotReloader& reloader);
+    void cleanup();
+};
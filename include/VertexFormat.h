@@ -0,0 +1,39 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Mesh.h"
+
+// 16-byte GPU vertex (vs 36 bytes for 9 floats). The shaders still see vec3 inputs:
+//   location 0: position, 3 x GL_HALF_FLOAT (+1 pad half)
+//   location 1: normal,   GL_INT_2_10_10_10_REV, normalized (signed 10 bits per axis)
+//   location 2: color,    4 x GL_UNSIGNED_BYTE, normalized (RGBA8 UNORM)
+struct PackedVertex {
+    uint16_t position[4];
+    uint32_t normal;
+    uint8_t color[4];
+};
+static_assert(sizeof(PackedVertex) == 16, "PackedVertex must stay 16 bytes");
+
+namespace VertexPacking {
+    uint16_t floatToHalf(float value);  // Round-to-nearest-even, handles denormals/inf/nan
+    float halfToFloat(uint16_t value);
+    uint32_t packSnorm2101010(const glm::vec3& normal);
+    void packUnorm8x4(const glm::vec3& color, float alpha, uint8_t out[4]);
+
+    PackedVertex pack(const glm::vec3& position, const glm::vec3& normal, const glm::vec3& color);
+    // Interleaved 9-float vertices (the CubeData layout)
+    std::vector<PackedVertex> packInterleaved(const float* data, size_t vertexCount);
+    std::vector<PackedVertex> packMesh(const std::vector<MeshVertex>& vertices);
+
+    // Point attributes 0-2 of the bound VAO at the bound GL_ARRAY_BUFFER
+    void setupPackedAttributes();
+    void setupFloatAttributes();  // 9-float layout, for comparison
+
+    // Draws the instanced high-poly mesh with both layouts into a tiny offscreen target
+    // (vertex-bound) and reports GPU time and vertex bytes per frame
+    int runBandwidthBenchmark(int instanceCount);
+}
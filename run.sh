@@ -12,6 +12,7 @@ fi
 if [ "$1" = "--software" ] || [ "$1" = "-s" ]; then
   echo "Enabling software rendering (LIBGL_ALWAYS_SOFTWARE=1)"
   export LIBGL_ALWAYS_SOFTWARE=1
+  shift
 fi
 
 # Ensure we're using the venv Python
@@ -44,8 +45,29 @@ echo "Building fuzzy 3D cube renderer (Modular Version)..."
 echo "Python includes: $PYTHON_INCLUDES"
 echo "Python ldflags: $PYTHON_LDFLAGS"
 
-g++ src/main.cpp \
+g++ -O2 src/main.cpp \
 src/FuzzyCubeApp.cpp \
+src/ThreadPool.cpp \
+src/FrustumCuller.cpp \
+src/InstanceData.cpp \
+src/GpuCuller.cpp \
+src/Mesh.cpp \
+src/VertexFormat.cpp \
+src/ShaderHotReload.cpp \
+src/ShaderPermutations.cpp \
+src/HeadlessContext.cpp \
+src/Upscaler.cpp \
+src/FramePacer.cpp \
+src/FrameQueue.cpp \
+src/ImageIO.cpp \
+src/FrameCapture.cpp \
+src/ImageDiff.cpp \
+src/QualitySolver.cpp \
+src/QualityTiers.cpp \
+src/RenderGraph.cpp \
+src/ShadowMap.cpp \
+src/PostChain.cpp \
+src/ResourceLoader.cpp \
 vendor/imgui/imgui.cpp \
 vendor/imgui/imgui_draw.cpp \
 vendor/imgui/imgui_tables.cpp \
@@ -63,6 +85,7 @@ ${PYTHON_INCLUDES} \
 -lXrandr \
 -lXi \
 -lGLEW \
+-lz \
 $(pkg-config --cflags --libs glm) \
 ${PYTHON_LDFLAGS} \
 -o build/app
@@ -108,4 +131,5 @@ fi
 
 echo "Thread settings: OMP_NUM_THREADS=$OMP_NUM_THREADS"
 
-./build/app
\ No newline at end of file
+# Remaining arguments go to the application (e.g. ./run.sh --software --verify-gpu-cull)
+./build/app "$@"
\ No newline at end of file
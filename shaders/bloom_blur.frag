@@ -0,0 +1,37 @@
+#version 330 core
+// One axis of the bloom's separable Gaussian (9 taps folded into 5 bilinear fetches),
+// drawn at the mip level's resolution so the horizontal pass also halves its source.
+// The first level's horizontal pass keeps only what is brighter than the threshold.
+in vec2 TexCoord;
+
+uniform sampler2D sourceTexture;
+uniform vec2 direction;   // One output texel along the blur axis, in UV
+uniform float threshold;  // Negative: no bright pass
+uniform float knee;       // Width of the soft transition around the threshold
+
+out vec4 FragColor;
+
+const float offsets[3] = float[](0.0, 1.3846153846, 3.2307692308);
+const float weights[3] = float[](0.2270270270, 0.3162162162, 0.0702702703);
+
+vec3 brightPass(vec3 color)
+{
+    if (threshold < 0.0) return color;
+    float brightness = max(color.r, max(color.g, color.b));
+    // Quadratic knee so the glow fades in instead of popping at the threshold
+    float soft = clamp(brightness - threshold + knee, 0.0, 2.0 * knee);
+    soft = soft * soft / (4.0 * knee + 1e-4);
+    float contribution = max(soft, brightness - threshold) / max(brightness, 1e-4);
+    return color * contribution;
+}
+
+void main()
+{
+    vec3 sum = brightPass(texture(sourceTexture, TexCoord).rgb) * weights[0];
+    for (int i = 1; i < 3; i++) {
+        vec2 offset = direction * offsets[i];
+        sum += brightPass(texture(sourceTexture, TexCoord + offset).rgb) * weights[i];
+        sum += brightPass(texture(sourceTexture, TexCoord - offset).rgb) * weights[i];
+    }
+    FragColor = vec4(sum, 1.0);
+}
@@ -0,0 +1,16 @@
+#version 330 core
+// Adds the accumulated bloom (at half resolution, filtered up) onto the presented image
+in vec2 TexCoord;
+
+uniform sampler2D screenTexture;
+uniform sampler2D bloomTexture;
+uniform float intensity;
+
+out vec4 FragColor;
+
+void main()
+{
+    vec3 color = texture(screenTexture, TexCoord).rgb;
+    color += texture(bloomTexture, TexCoord).rgb * intensity;
+    FragColor = vec4(color, 1.0);
+}
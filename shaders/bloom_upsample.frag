@@ -0,0 +1,23 @@
+#version 330 core
+// Tent-filtered upsample of a coarser bloom level, added (by blending) onto the next finer
+// one so every level's blur radius ends up in the top level
+in vec2 TexCoord;
+
+uniform sampler2D sourceTexture;  // The coarser level
+uniform vec2 texelSize;           // Of sourceTexture, in UV
+
+out vec4 FragColor;
+
+void main()
+{
+    vec3 sum = texture(sourceTexture, TexCoord).rgb * 4.0;
+    sum += texture(sourceTexture, TexCoord + vec2(-texelSize.x, 0.0)).rgb * 2.0;
+    sum += texture(sourceTexture, TexCoord + vec2( texelSize.x, 0.0)).rgb * 2.0;
+    sum += texture(sourceTexture, TexCoord + vec2(0.0, -texelSize.y)).rgb * 2.0;
+    sum += texture(sourceTexture, TexCoord + vec2(0.0,  texelSize.y)).rgb * 2.0;
+    sum += texture(sourceTexture, TexCoord + vec2(-texelSize.x, -texelSize.y)).rgb;
+    sum += texture(sourceTexture, TexCoord + vec2( texelSize.x, -texelSize.y)).rgb;
+    sum += texture(sourceTexture, TexCoord + vec2(-texelSize.x,  texelSize.y)).rgb;
+    sum += texture(sourceTexture, TexCoord + vec2( texelSize.x,  texelSize.y)).rgb;
+    FragColor = vec4(sum / 16.0, 1.0);
+}
@@ -0,0 +1,10 @@
+#version 330 core
+// Stencil-only pass for CheckerboardRenderer: survives on the even cells, (x + y) % 2 == 0
+
+void main()
+{
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    if (((p.x + p.y) & 1) != 0) {
+        discard;
+    }
+}
@@ -0,0 +1,70 @@
+#version 330 core
+// Checkerboard reconstruction at the tier's resolution. Cells with (x + y) % 2 == parity
+// were shaded this frame; the others are filled from the previous resolve.
+in vec2 TexCoord;
+
+uniform sampler2D currentColor;     // Half the cells valid (the rest hold the clear colour)
+uniform sampler2D velocityTexture;  // UV motion, written on the shaded cells only
+uniform sampler2D historyTexture;   // Previous resolve
+uniform int parity;
+uniform bool historyValid;
+
+out vec4 FragColor;
+
+float luma(vec3 color)
+{
+    return dot(color, vec3(0.299, 0.587, 0.114));
+}
+
+// Neighbours of a missing cell are all shaded; at the border, mirror to the opposite side
+ivec2 neighbour(ivec2 p, ivec2 offset, ivec2 size)
+{
+    ivec2 q = p + offset;
+    if (any(lessThan(q, ivec2(0))) || any(greaterThanEqual(q, size))) {
+        q = p - offset;
+    }
+    return q;
+}
+
+void main()
+{
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    ivec2 size = textureSize(currentColor, 0);
+    if (((p.x + p.y) & 1) == parity) {
+        FragColor = vec4(texelFetch(currentColor, p, 0).rgb, 1.0);
+        return;
+    }
+
+    ivec2 offsets[4] = ivec2[4](ivec2(-1, 0), ivec2(1, 0), ivec2(0, -1), ivec2(0, 1));
+    vec3 colors[4];
+    vec2 velocity = vec2(0.0);
+    for (int i = 0; i < 4; i++) {
+        ivec2 q = neighbour(p, offsets[i], size);
+        colors[i] = texelFetch(currentColor, q, 0).rgb;
+        vec2 neighbourVelocity = texelFetch(velocityTexture, q, 0).xy;
+        if (dot(neighbourVelocity, neighbourVelocity) > dot(velocity, velocity)) {
+            velocity = neighbourVelocity;
+        }
+    }
+
+    // Edge-directed interpolation: average along the axis with the smaller luma step
+    float horizontalStep = abs(luma(colors[0]) - luma(colors[1]));
+    float verticalStep = abs(luma(colors[2]) - luma(colors[3]));
+    vec3 horizontal = 0.5 * (colors[0] + colors[1]);
+    vec3 vertical = 0.5 * (colors[2] + colors[3]);
+    float verticalWeight = clamp(0.5 + (horizontalStep - verticalStep) * 4.0, 0.0, 1.0);
+    vec3 spatial = mix(horizontal, vertical, verticalWeight);
+
+    vec2 historyUV = (vec2(p) + 0.5) / vec2(size) - velocity;
+    if (!historyValid || any(lessThan(historyUV, vec2(0.0))) || any(greaterThan(historyUV, vec2(1.0)))) {
+        FragColor = vec4(spatial, 1.0);
+        return;
+    }
+
+    // Last frame's value is exact where nothing moved; clamping to the shaded neighbours
+    // rejects it on disocclusions and lighting changes
+    vec3 minColor = min(min(colors[0], colors[1]), min(colors[2], colors[3]));
+    vec3 maxColor = max(max(colors[0], colors[1]), max(colors[2], colors[3]));
+    vec3 history = texture(historyTexture, historyUV).rgb;
+    FragColor = vec4(clamp(history, minColor, maxColor), 1.0);
+}
@@ -0,0 +1,20 @@
+#version 330 core
+// Color grading: per-channel balance, contrast around mid-grey, then saturation against
+// the luma
+in vec2 TexCoord;
+
+uniform sampler2D screenTexture;
+uniform vec3 colorBalance;  // Channel gains; (1, 1, 1) is neutral
+uniform float contrast;     // 1 = unchanged
+uniform float saturation;   // 0 = greyscale, 1 = unchanged
+
+out vec4 FragColor;
+
+void main()
+{
+    vec3 color = texture(screenTexture, TexCoord).rgb * colorBalance;
+    color = (color - 0.5) * contrast + 0.5;
+    float luma = dot(color, vec3(0.2126, 0.7152, 0.0722));
+    color = mix(vec3(luma), color, saturation);
+    FragColor = vec4(clamp(color, 0.0, 1.0), 1.0);
+}
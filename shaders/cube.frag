@@ -1,41 +1,111 @@
 #version 330 core
+// Über-shader for every cube/mesh program (see cube.vert)
+#if defined(FEATURE_DIFFUSE) || defined(FEATURE_SPECULAR)
+#define FEATURE_LIT
+#endif
+
+#ifdef FEATURE_LIT
 in vec3 FragPos;
 in vec3 Normal;
-in vec3 Color;
 
 uniform vec3 lightPos;
-uniform vec3 viewPos;
 uniform vec3 lightColor;
-uniform vec3 ambientColor;
+#endif
+#ifdef FEATURE_SPECULAR
+uniform vec3 viewPos;
+#endif
+#ifdef FEATURE_VERTEX_COLORS
+in vec3 Color;
+#else
+uniform vec3 objectColor;
+#endif
+
+#ifdef FEATURE_SHADOWS
+in vec4 LightSpacePos;
+
+uniform sampler2DShadow shadowMap;
+uniform int pcfRadius;  // (2r+1)^2 taps; 0 = one hardware-filtered tap
+
+// Fraction of the light reaching the fragment
+float shadowFactor(vec3 norm, vec3 lightDir)
+{
+    vec3 coords = LightSpacePos.xyz / LightSpacePos.w * 0.5 + 0.5;
+    // The light's depth range only spans the casters, so receivers beyond it (the ground)
+    // compare at the far plane: shadowed under a caster, lit where the map is clear
+    coords.z = min(coords.z, 1.0);
+    float bias = max(0.004 * (1.0 - dot(norm, lightDir)), 0.0008);
+    vec2 texel = 1.0 / vec2(textureSize(shadowMap, 0));
+    float lit = 0.0;
+    for (int y = -pcfRadius; y <= pcfRadius; y++) {
+        for (int x = -pcfRadius; x <= pcfRadius; x++) {
+            lit += texture(shadowMap, vec3(coords.xy + vec2(x, y) * texel, coords.z - bias));
+        }
+    }
+    float taps = float((2 * pcfRadius + 1) * (2 * pcfRadius + 1));
+    return lit / taps;
+}
+#endif
+
+#ifdef FEATURE_MOTION_VECTORS
+in vec4 CurrentClip;
+in vec4 PreviousClip;
 
+layout (location = 0) out vec4 FragColor;
+layout (location = 1) out vec2 Velocity;  // UV motion since the previous frame (color attachment 1)
+#else
 out vec4 FragColor;
+#endif
 
 void main()
 {
-    // Use vertex color as base (distinct per face)
-    vec3 baseColor = Color;
-    
+#ifdef FEATURE_MOTION_VECTORS
+    Velocity = (CurrentClip.xy / CurrentClip.w - PreviousClip.xy / PreviousClip.w) * 0.5;
+#endif
+
+#ifdef FEATURE_VERTEX_COLORS
+    vec3 baseColor = Color;  // Distinct per face
+#else
+    vec3 baseColor = objectColor;
+#endif
+
+#ifdef FEATURE_LIT
     // Ambient lighting
     float ambientStrength = 0.3;
     vec3 ambient = ambientStrength * baseColor;
     
-    // Diffuse lighting
     vec3 norm = normalize(Normal);
     vec3 lightDir = normalize(lightPos - FragPos);
+    vec3 lighting = vec3(0.0);
+    
+#ifdef FEATURE_DIFFUSE
+    // Diffuse lighting
     float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor * baseColor;
+    lighting += diff * lightColor * baseColor;
+#endif
     
+#ifdef FEATURE_SPECULAR
     // Specular lighting
     float specularStrength = 0.4;
     vec3 viewDir = normalize(viewPos - FragPos);
     vec3 reflectDir = reflect(-lightDir, norm);
     float spec = pow(max(dot(viewDir, reflectDir), 0.0), 32);
-    vec3 specular = specularStrength * spec * lightColor;
+    lighting += specularStrength * spec * lightColor;
+#endif
     
+#ifdef FEATURE_ATTENUATION
     // Attenuation based on distance
     float distance = length(lightPos - FragPos);
-    float attenuation = 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
+    lighting *= 1.0 / (1.0 + 0.09 * distance + 0.032 * distance * distance);
+#endif
+    
+#ifdef FEATURE_SHADOWS
+    // Ambient stays: shadowed areas keep their colour
+    lighting *= shadowFactor(norm, lightDir);
+#endif
     
-    vec3 result = ambient + (diffuse + specular) * attenuation;
-    FragColor = vec4(result, 1.0);
+    FragColor = vec4(ambient + lighting, 1.0);
+#else
+    // No lighting: vertex colors keep the faces distinguishable, slightly dimmed
+    FragColor = vec4(baseColor * 0.7, 1.0);
+#endif
 }
@@ -1,21 +1,77 @@
 #version 330 core
+// Über-shader for every cube/mesh program. ShaderPermutations inserts FEATURE_* defines
+// after the #version line; the toggles are listed in include/ShaderPermutations.h.
+#if defined(FEATURE_DIFFUSE) || defined(FEATURE_SPECULAR)
+#define FEATURE_LIT
+#endif
+
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec3 aColor;
+#ifdef FEATURE_INSTANCED
+layout (location = 3) in mat4 aInstanceModel;   // Occupies locations 3-6, one per instance
+layout (location = 7) in mat3 aInstanceNormal;  // Locations 7-9: inverse-transpose of the instance's 3x3
+#endif
 
-uniform mat4 model;
+uniform mat4 model;  // Scene rotation, applied on top of every instance when instanced
 uniform mat4 view;
 uniform mat4 projection;
+uniform mat3 normalMatrix;  // inverse-transpose of mat3(model), computed once per frame on the CPU
+#ifdef FEATURE_MOTION_VECTORS
+uniform mat4 previousModel;
+uniform mat4 unjitteredViewProjection;  // This frame without the temporal jitter
+uniform mat4 previousViewProjection;    // Last frame, also unjittered
+out vec4 CurrentClip;
+out vec4 PreviousClip;
+#endif
+#ifdef FEATURE_SHADOWS
+uniform mat4 lightSpaceMatrix;
+out vec4 LightSpacePos;
+#endif
 
+#ifdef FEATURE_LIT
 out vec3 FragPos;
 out vec3 Normal;
+#endif
+#ifdef FEATURE_VERTEX_COLORS
 out vec3 Color;
+#endif
 
 void main()
 {
-    FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+#ifdef FEATURE_INSTANCED
+    mat4 world = model * aInstanceModel;
+#else
+    mat4 world = model;
+#endif
+    vec4 worldPos = world * vec4(aPos, 1.0);
+#ifdef FEATURE_LIT
+    FragPos = vec3(worldPos);
+#if defined(PER_VERTEX_NORMAL_MATRIX)
+    // Reference path for --bench-normal-matrix: a full inverse per vertex
+    Normal = mat3(transpose(inverse(world))) * aNormal;
+#elif defined(FEATURE_INSTANCED)
+    // inverse(A * B)^T = inverse(A)^T * inverse(B)^T
+    Normal = normalMatrix * (aInstanceNormal * aNormal);
+#else
+    Normal = normalMatrix * aNormal;
+#endif
+#endif
+#ifdef FEATURE_VERTEX_COLORS
     Color = aColor;
+#endif
+#ifdef FEATURE_SHADOWS
+    LightSpacePos = lightSpaceMatrix * worldPos;
+#endif
+#ifdef FEATURE_MOTION_VECTORS
+#ifdef FEATURE_INSTANCED
+    mat4 previousWorld = previousModel * aInstanceModel;  // Instances themselves are static
+#else
+    mat4 previousWorld = previousModel;
+#endif
+    CurrentClip = unjitteredViewProjection * worldPos;
+    PreviousClip = previousViewProjection * previousWorld * vec4(aPos, 1.0);
+#endif
     
-    gl_Position = projection * view * vec4(FragPos, 1.0);
+    gl_Position = projection * view * worldPos;
 }
@@ -1,28 +0,0 @@
-#version 330 core
-in vec3 FragPos;
-in vec3 Normal;
-in vec3 Color;
-
-uniform vec3 lightPos;
-uniform vec3 lightColor;
-
-out vec4 FragColor;
-
-void main()
-{
-    // Use vertex color as base (distinct per face)
-    vec3 baseColor = Color;
-    
-    // Ambient lighting
-    float ambientStrength = 0.3;
-    vec3 ambient = ambientStrength * baseColor;
-
-    // Diffuse lighting only (no specular for medium quality)
-    vec3 norm = normalize(Normal);
-    vec3 lightDir = normalize(lightPos - FragPos);
-    float diff = max(dot(norm, lightDir), 0.0);
-    vec3 diffuse = diff * lightColor * baseColor;
-
-    vec3 result = ambient + diffuse;
-    FragColor = vec4(result, 1.0);
-}
@@ -0,0 +1,11 @@
+#version 330 core
+// Depth-only pass into the shadow map (see include/ShadowMap.h)
+layout (location = 0) in vec3 aPos;
+
+uniform mat4 model;
+uniform mat4 lightSpaceMatrix;
+
+void main()
+{
+    gl_Position = lightSpaceMatrix * model * vec4(aPos, 1.0);
+}
@@ -0,0 +1,44 @@
+#version 330 core
+// Contrast-adaptive sharpening (after AMD FidelityFX CAS). A negative-lobe cross filter
+// whose strength shrinks where the 3x3 neighbourhood already spans most of the range,
+// so edges get crisper without halos and flat areas stay clean.
+in vec2 TexCoord;
+
+uniform sampler2D sourceTexture;  // Same size as the output
+uniform float sharpness;          // 0 = subtle, 1 = maximum
+
+out vec4 FragColor;
+
+void main()
+{
+    ivec2 p = ivec2(gl_FragCoord.xy);
+    ivec2 maxTexel = textureSize(sourceTexture, 0) - 1;
+
+    //  a b c
+    //  d e f
+    //  g h i
+    vec3 a = texelFetch(sourceTexture, clamp(p + ivec2(-1, -1), ivec2(0), maxTexel), 0).rgb;
+    vec3 b = texelFetch(sourceTexture, clamp(p + ivec2( 0, -1), ivec2(0), maxTexel), 0).rgb;
+    vec3 c = texelFetch(sourceTexture, clamp(p + ivec2( 1, -1), ivec2(0), maxTexel), 0).rgb;
+    vec3 d = texelFetch(sourceTexture, clamp(p + ivec2(-1,  0), ivec2(0), maxTexel), 0).rgb;
+    vec3 e = texelFetch(sourceTexture, p, 0).rgb;
+    vec3 f = texelFetch(sourceTexture, clamp(p + ivec2( 1,  0), ivec2(0), maxTexel), 0).rgb;
+    vec3 g = texelFetch(sourceTexture, clamp(p + ivec2(-1,  1), ivec2(0), maxTexel), 0).rgb;
+    vec3 h = texelFetch(sourceTexture, clamp(p + ivec2( 0,  1), ivec2(0), maxTexel), 0).rgb;
+    vec3 i = texelFetch(sourceTexture, clamp(p + ivec2( 1,  1), ivec2(0), maxTexel), 0).rgb;
+
+    // Soft min/max: cross plus the full 3x3, which keeps the response smooth
+    vec3 minColor = min(min(min(d, e), min(f, b)), h);
+    minColor += min(minColor, min(min(a, c), min(g, i)));
+    vec3 maxColor = max(max(max(d, e), max(f, b)), h);
+    maxColor += max(maxColor, max(max(a, c), max(g, i)));
+
+    // Amount of headroom left before clipping, per channel
+    vec3 amplitude = clamp(min(minColor, 2.0 - maxColor) / max(maxColor, vec3(1.0 / 65536.0)), 0.0, 1.0);
+    amplitude = sqrt(amplitude);
+
+    float peak = -1.0 / mix(8.0, 5.0, clamp(sharpness, 0.0, 1.0));
+    vec3 weight = amplitude * peak;
+    vec3 color = ((b + d + f + h) * weight + e) / (1.0 + 4.0 * weight);
+    FragColor = vec4(clamp(color, 0.0, 1.0), 1.0);
+}
@@ -6,6 +6,7 @@ layout (location = 2) in vec3 aColor;
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
+uniform mat3 normalMatrix;  // inverse-transpose of mat3(model), computed on the CPU
 
 out vec3 FragPos;
 out vec3 Normal;
@@ -14,7 +15,7 @@ out vec3 Color;
 void main()
 {
     FragPos = vec3(model * vec4(aPos, 1.0));
-    Normal = mat3(transpose(inverse(model))) * aNormal;
+    Normal = normalMatrix * aNormal;
     Color = aColor;
     
     gl_Position = projection * view * vec4(FragPos, 1.0);
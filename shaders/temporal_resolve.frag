@@ -0,0 +1,99 @@
+#version 330 core
+// Temporal upsampling resolve, run at the output resolution. The current frame is a
+// jittered low-res render; the history is last frame's resolve at full resolution.
+in vec2 TexCoord;
+
+uniform sampler2D currentColor;     // This frame at the tier's render resolution
+uniform sampler2D velocityTexture;  // Same size: UV motion since the previous frame
+uniform sampler2D historyTexture;   // Previous resolve (bilinear, clamp to edge)
+uniform vec2 renderSize;            // In render pixels
+uniform vec2 jitter;                // Image offset of this frame, in render pixels
+uniform bool historyValid;
+
+out vec4 FragColor;
+
+ivec2 clampTexel(ivec2 texel)
+{
+    return clamp(texel, ivec2(0), ivec2(renderSize) - 1);
+}
+
+// Approximation of the Blackman-Harris window (radius ~1.5 render pixels)
+float sampleWeight(vec2 offset)
+{
+    return exp(-2.29 * dot(offset, offset));
+}
+
+// Catmull-Rom from 5 bilinear taps (the 4 corner taps contribute little and are dropped)
+vec3 sampleHistory(vec2 uv)
+{
+    vec2 size = vec2(textureSize(historyTexture, 0));
+    vec2 position = uv * size;
+    vec2 center = floor(position - 0.5) + 0.5;
+    vec2 f = position - center;
+    vec2 w0 = f * (-0.5 + f * (1.0 - 0.5 * f));
+    vec2 w1 = 1.0 + f * f * (-2.5 + 1.5 * f);
+    vec2 w2 = f * (0.5 + f * (2.0 - 1.5 * f));
+    vec2 w3 = f * f * (-0.5 + 0.5 * f);
+    vec2 w12 = w1 + w2;
+    vec2 uv0 = (center - 1.0) / size;
+    vec2 uv3 = (center + 2.0) / size;
+    vec2 uv12 = (center + w2 / w12) / size;
+
+    vec3 color = texture(historyTexture, vec2(uv12.x, uv0.y)).rgb * (w12.x * w0.y)
+               + texture(historyTexture, vec2(uv0.x, uv12.y)).rgb * (w0.x * w12.y)
+               + texture(historyTexture, uv12).rgb * (w12.x * w12.y)
+               + texture(historyTexture, vec2(uv3.x, uv12.y)).rgb * (w3.x * w12.y)
+               + texture(historyTexture, vec2(uv12.x, uv3.y)).rgb * (w12.x * w3.y);
+    float weight = w12.x * w0.y + w0.x * w12.y + w12.x * w12.y + w3.x * w12.y + w12.x * w3.y;
+    return max(color / weight, vec3(0.0));
+}
+
+void main()
+{
+    // Output pixel centre in render pixels, and the texel whose jittered sample is nearest:
+    // texel t was shaded at t + 0.5 - jitter
+    vec2 position = TexCoord * renderSize;
+    ivec2 nearest = ivec2(floor(position + jitter));
+    vec2 nearestOffset = vec2(nearest) + 0.5 - jitter - position;
+
+    // 3x3 neighbourhood: reconstruction filter, colour moments for the history clip, and the
+    // longest velocity (so silhouettes reproject with the foreground object)
+    vec3 reconstructed = vec3(0.0);
+    float reconstructedWeight = 0.0;
+    vec3 moment1 = vec3(0.0), moment2 = vec3(0.0);
+    vec2 velocity = vec2(0.0);
+    for (int y = -1; y <= 1; y++) {
+        for (int x = -1; x <= 1; x++) {
+            ivec2 texel = clampTexel(nearest + ivec2(x, y));
+            vec3 color = texelFetch(currentColor, texel, 0).rgb;
+            float weight = sampleWeight(vec2(x, y) + nearestOffset);
+            reconstructed += color * weight;
+            reconstructedWeight += weight;
+            moment1 += color;
+            moment2 += color * color;
+
+            vec2 texelVelocity = texelFetch(velocityTexture, texel, 0).xy;
+            if (dot(texelVelocity, texelVelocity) > dot(velocity, velocity)) {
+                velocity = texelVelocity;
+            }
+        }
+    }
+    vec3 current = reconstructed / reconstructedWeight;
+
+    vec2 historyUV = TexCoord - velocity;
+    if (!historyValid || any(lessThan(historyUV, vec2(0.0))) || any(greaterThan(historyUV, vec2(1.0)))) {
+        FragColor = vec4(current, 1.0);
+        return;
+    }
+
+    // Variance clipping: history outside mean +- 1.25 sigma of the current neighbourhood is
+    // disoccluded or stale (ghosting) and is pulled back to the box
+    vec3 mean = moment1 / 9.0;
+    vec3 sigma = sqrt(max(moment2 / 9.0 - mean * mean, vec3(0.0)));
+    vec3 history = clamp(sampleHistory(historyUV), mean - 1.25 * sigma, mean + 1.25 * sigma);
+
+    // Output pixels close to this frame's sample take more of it; the rest keep the
+    // accumulated detail from earlier jitter phases
+    float feedback = mix(0.04, 0.2, sampleWeight(nearestOffset));
+    FragColor = vec4(mix(history, current, feedback), 1.0);
+}
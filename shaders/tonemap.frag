@@ -0,0 +1,20 @@
+#version 330 core
+// Tone mapping: exposure, then a filmic curve (Narkowicz's fit of the ACES reference
+// transform) that rolls the bloom's values above 1 off into the displayable range
+in vec2 TexCoord;
+
+uniform sampler2D screenTexture;
+uniform float exposure;
+
+out vec4 FragColor;
+
+vec3 filmic(vec3 x)
+{
+    return clamp((x * (2.51 * x + 0.03)) / (x * (2.43 * x + 0.59) + 0.14), 0.0, 1.0);
+}
+
+void main()
+{
+    vec3 color = texture(screenTexture, TexCoord).rgb * exposure;
+    FragColor = vec4(filmic(color), 1.0);
+}
@@ -0,0 +1,101 @@
+#version 330 core
+// Edge-adaptive spatial upsampling (after AMD FSR 1 EASU). Each output pixel takes
+// 12 source texels around it, weighted by a Lanczos-2 approximation whose footprint is
+// rotated to the local gradient: narrow across edges, wide along them.
+in vec2 TexCoord;
+
+uniform sampler2D sourceTexture;
+uniform vec2 sourceSize;  // In texels
+
+out vec4 FragColor;
+
+float luma(vec3 color)
+{
+    return dot(color, vec3(0.299, 0.587, 0.114));
+}
+
+vec3 fetch(ivec2 texel)
+{
+    return texelFetch(sourceTexture, clamp(texel, ivec2(0), ivec2(sourceSize) - 1), 0).rgb;
+}
+
+// Gradient direction and edge strength of one of the four texels nearest the sample.
+// Strength is 1 for a clean ramp and falls towards 0 for thin lines and noise.
+void accumulateEdge(inout vec2 direction, inout float strength, float weight,
+                    float left, float center, float right, float up, float down)
+{
+    float dirX = right - left;
+    float lenX = max(abs(right - center), abs(center - left));
+    lenX = clamp(abs(dirX) / max(lenX, 1.0 / 4096.0), 0.0, 1.0);
+    float dirY = down - up;
+    float lenY = max(abs(down - center), abs(center - up));
+    lenY = clamp(abs(dirY) / max(lenY, 1.0 / 4096.0), 0.0, 1.0);
+
+    direction += vec2(dirX, dirY) * weight;
+    strength += (lenX * lenX + lenY * lenY) * weight;
+}
+
+void main()
+{
+    // Position in source texels relative to the top-left texel of the nearest 2x2
+    vec2 position = TexCoord * sourceSize - 0.5;
+    ivec2 base = ivec2(floor(position));
+    vec2 f = position - vec2(base);
+
+    //    b c
+    //  e f g h
+    //  i j k l
+    //    n o
+    vec3 b = fetch(base + ivec2(0, -1)), c = fetch(base + ivec2(1, -1));
+    vec3 e = fetch(base + ivec2(-1, 0)), fc = fetch(base), g = fetch(base + ivec2(1, 0)), h = fetch(base + ivec2(2, 0));
+    vec3 i = fetch(base + ivec2(-1, 1)), j = fetch(base + ivec2(0, 1)), k = fetch(base + ivec2(1, 1)), l = fetch(base + ivec2(2, 1));
+    vec3 n = fetch(base + ivec2(0, 2)), o = fetch(base + ivec2(1, 2));
+
+    float lb = luma(b), lc = luma(c), le = luma(e), lf = luma(fc), lg = luma(g), lh = luma(h);
+    float li = luma(i), lj = luma(j), lk = luma(k), ll = luma(l), ln = luma(n), lo = luma(o);
+
+    // Bilinear blend of the edge analysis at f, g, j, k
+    vec2 direction = vec2(0.0);
+    float strength = 0.0;
+    accumulateEdge(direction, strength, (1.0 - f.x) * (1.0 - f.y), le, lf, lg, lb, lj);
+    accumulateEdge(direction, strength, f.x * (1.0 - f.y), lf, lg, lh, lc, lk);
+    accumulateEdge(direction, strength, (1.0 - f.x) * f.y, li, lj, lk, lf, ln);
+    accumulateEdge(direction, strength, f.x * f.y, lj, lk, ll, lg, lo);
+
+    float directionLength2 = dot(direction, direction);
+    direction = directionLength2 < 1.0 / 32768.0 ? vec2(1.0, 0.0) : direction * inversesqrt(directionLength2);
+    strength *= 0.5;
+    strength *= strength;
+
+    // Axis-aligned edges keep a square footprint; diagonal ones are stretched so the
+    // rotated kernel still reaches the corner taps
+    float stretch = 1.0 / max(abs(direction.x), abs(direction.y));
+    vec2 axisScale = vec2(1.0 + (stretch - 1.0) * strength, 1.0 - 0.5 * strength);
+    // Negative lobe strength: Lanczos-like at 0, closer to bilinear-soft when no edge
+    float lobe = 0.5 + ((1.0 / 4.0 - 0.04) - 0.5) * strength;
+    float clipDistance2 = 1.0 / lobe;
+
+    vec3 colors[12] = vec3[12](b, c, e, fc, g, h, i, j, k, l, n, o);
+    vec2 offsets[12] = vec2[12](vec2(0, -1), vec2(1, -1), vec2(-1, 0), vec2(0, 0), vec2(1, 0), vec2(2, 0),
+                                vec2(-1, 1), vec2(0, 1), vec2(1, 1), vec2(2, 1), vec2(0, 2), vec2(1, 2));
+    vec3 colorSum = vec3(0.0);
+    float weightSum = 0.0;
+    for (int t = 0; t < 12; t++) {
+        vec2 offset = offsets[t] - f;
+        // Rotate into (across edge, along edge) and scale
+        vec2 v = vec2(dot(offset, direction), dot(offset, vec2(-direction.y, direction.x))) * axisScale;
+        float distance2 = min(dot(v, v), clipDistance2);
+        // Lanczos-2 approximation without sin/sqrt: base * window
+        float baseTerm = 2.0 / 5.0 * distance2 - 1.0;
+        float windowTerm = lobe * distance2 - 1.0;
+        baseTerm = 25.0 / 16.0 * baseTerm * baseTerm - (25.0 / 16.0 - 1.0);
+        float weight = baseTerm * windowTerm * windowTerm;
+        colorSum += colors[t] * weight;
+        weightSum += weight;
+    }
+
+    // Deringing: never leave the range of the four nearest texels
+    vec3 minColor = min(min(fc, g), min(j, k));
+    vec3 maxColor = max(max(fc, g), max(j, k));
+    FragColor = vec4(clamp(colorSum / weightSum, minColor, maxColor), 1.0);
+}
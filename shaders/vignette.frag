@@ -0,0 +1,20 @@
+#version 330 core
+// Darkens towards the corners: a smooth falloff over the aspect-corrected distance from
+// the centre
+in vec2 TexCoord;
+
+uniform sampler2D screenTexture;
+uniform float aspect;     // Width / height
+uniform float intensity;  // Darkening at the corners, 0-1
+uniform float radius;     // Distance (1 = half the height) where the falloff starts
+uniform float softness;   // Width of the falloff
+
+out vec4 FragColor;
+
+void main()
+{
+    vec3 color = texture(screenTexture, TexCoord).rgb;
+    vec2 centered = (TexCoord - 0.5) * vec2(aspect, 1.0) * 2.0;
+    float falloff = smoothstep(radius, radius + softness, length(centered) / aspect);
+    FragColor = vec4(color * (1.0 - intensity * falloff), 1.0);
+}
@@ -0,0 +1,221 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/FrameCapture.h"
+#include "../include/ImageIO.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+// FrameCapture implementation
+bool FrameCapture::start(const std::string& path, Format captureFormat, int captureSource, int fps,
+                         int encoderThreads) {
+    stop();
+    format = captureFormat;
+    source = captureSource;
+    outputPath = path;
+    streamWidth = streamHeight = 0;
+    capturedFrames = droppedFrames = encodedFrames = 0;
+    nextSequence = nextWrite = 0;
+
+    std::error_code error;
+    if (format == Format::PNG) {
+        std::filesystem::create_directories(outputPath, error);
+    } else {
+        std::filesystem::path parent = std::filesystem::path(outputPath).parent_path();
+        if (!parent.empty()) std::filesystem::create_directories(parent, error);
+        stream = std::fopen(outputPath.c_str(), "wb");
+        if (!stream) {
+            std::cerr << "[CAPTURE] Cannot open " << outputPath << std::endl;
+            return false;
+        }
+    }
+    if (error) {
+        std::cerr << "[CAPTURE] Cannot create " << outputPath << ": " << error.message() << std::endl;
+        return false;
+    }
+    streamFps = std::max(fps, 1);
+
+    for (Readback& readback : ring) {
+        glGenBuffers(1, &readback.buffer);
+    }
+    checkGLError("Capture PBO creation");
+
+    if (encoderThreads <= 0) {
+        // PNG deflate parallelizes across frames; a Y4M stream is mostly conversion + I/O
+        encoderThreads = format == Format::PNG ? std::max(1u, std::thread::hardware_concurrency() / 2) : 2;
+    }
+    maxQueuedJobs = (size_t)encoderThreads * 2 + 2;
+    stopping = false;
+    for (int i = 0; i < encoderThreads; i++) {
+        workers.emplace_back(&FrameCapture::workerLoop, this);
+    }
+    active = true;
+    std::cout << "[CAPTURE] " << (format == Format::PNG ? "PNG sequence" : "Y4M stream") << " to "
+              << outputPath << " from " << (source == kPresented ? std::string("the presented frame")
+                                                                  : "quality FBO " + std::to_string(source))
+              << " | " << encoderThreads << " encoder thread(s)" << std::endl;
+    return true;
+}
+
+void FrameCapture::capture(GLuint framebuffer, int width, int height, unsigned long long frame) {
+    if (!active) return;
+    collect(false);
+
+    Readback& readback = ring[ringHead];
+    if (readback.fence) {
+        // The GPU has not finished the readback issued kRingSize frames ago
+        droppedFrames++;
+        return;
+    }
+    if (format == Format::Y4M) {
+        // A stream has one frame size; the first capture fixes it
+        if (!streamWidth) {
+            streamWidth = width;
+            streamHeight = height;
+            std::string header = ImageIO::y4mHeader(width, height, streamFps);
+            std::fwrite(header.data(), 1, header.size(), stream);
+        } else if (width != streamWidth || height != streamHeight) {
+            droppedFrames++;
+            return;
+        }
+    }
+
+    size_t size = (size_t)width * height * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    if (readback.width != width || readback.height != height) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, size, nullptr, GL_STREAM_READ);
+        readback.width = width;
+        readback.height = height;
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+    glReadBuffer(framebuffer ? GL_COLOR_ATTACHMENT0 : GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);  // Into the PBO
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    readback.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    readback.frame = frame;
+    ringHead = (ringHead + 1) % kRingSize;
+    capturedFrames++;
+}
+
+void FrameCapture::collect(bool wait) {
+    // Oldest first, so frames reach the encoders (and the Y4M sequence) in order
+    for (int offset = 0; offset < kRingSize; offset++) {
+        Readback& readback = ring[(ringHead + offset) % kRingSize];
+        if (!readback.fence) continue;
+        GLenum status = glClientWaitSync(readback.fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                                         wait ? 1000000000ull : 0);  // 1 s when flushing
+        if (status == GL_TIMEOUT_EXPIRED) {
+            if (wait) continue;
+            break;
+        }
+        glDeleteSync(readback.fence);
+        readback.fence = nullptr;
+
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!wait && jobs.size() >= maxQueuedJobs) {
+            droppedFrames++;  // Encoders are behind; the readback slot is simply reused
+            continue;
+        }
+        Job job;
+        if (!freeBuffers.empty()) {
+            job.pixels = std::move(freeBuffers.back());
+            freeBuffers.pop_back();
+        }
+        lock.unlock();
+
+        size_t size = (size_t)readback.width * readback.height * 4;
+        job.pixels.resize(size);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+        const void* mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+        if (mapped) {
+            std::memcpy(job.pixels.data(), mapped, size);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if (!mapped) {
+            droppedFrames++;
+            continue;
+        }
+        job.width = readback.width;
+        job.height = readback.height;
+        job.frame = readback.frame;
+
+        lock.lock();
+        job.sequence = nextSequence++;
+        jobs.push_back(std::move(job));
+        lock.unlock();
+        jobCondition.notify_one();
+    }
+}
+
+void FrameCapture::workerLoop() {
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobCondition.wait(lock, [this] { return stopping || !jobs.empty(); });
+            if (jobs.empty()) return;  // Stopping and drained
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        encode(job);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        encodedFrames++;
+        freeBuffers.push_back(std::move(job.pixels));
+    }
+}
+
+void FrameCapture::encode(Job& job) {
+    if (format == Format::PNG) {
+        char name[32];
+        std::snprintf(name, sizeof(name), "frame_%06llu.png", job.frame);
+        std::string path = (std::filesystem::path(outputPath) / name).string();
+        if (!ImageIO::writePNG(path, job.width, job.height, 4, job.pixels.data(), true)) {
+            std::cerr << "[CAPTURE] Failed to write " << path << std::endl;
+        }
+        return;
+    }
+
+    // Y4M: convert in parallel, then append in sequence order
+    std::vector<uint8_t> planes;
+    ImageIO::convertRGBAToI420(job.pixels.data(), job.width, job.height, true, planes);
+    std::unique_lock<std::mutex> lock(mutex);
+    writeCondition.wait(lock, [&] { return nextWrite == job.sequence; });
+    std::fwrite("FRAME\n", 1, 6, stream);
+    std::fwrite(planes.data(), 1, planes.size(), stream);
+    nextWrite++;
+    writeCondition.notify_all();
+}
+
+unsigned long long FrameCapture::getEncodedFrames() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return encodedFrames;
+}
+
+void FrameCapture::stop() {
+    if (!active) return;
+    collect(true);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobCondition.notify_all();
+    for (std::thread& worker : workers) worker.join();
+    workers.clear();
+    freeBuffers.clear();
+
+    for (Readback& readback : ring) {
+        if (readback.fence) glDeleteSync(readback.fence);
+        if (readback.buffer) glDeleteBuffers(1, &readback.buffer);
+        readback = Readback();
+    }
+    if (stream) {
+        std::fclose(stream);
+        stream = nullptr;
+    }
+    active = false;
+    std::cout << "[CAPTURE] Stopped: " << capturedFrames << " captured, " << encodedFrames << " encoded, "
+              << droppedFrames << " dropped" << std::endl;
+}
@@ -0,0 +1,97 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/FramePacer.h"
+#include <algorithm>
+#include <thread>
+
+// FramePacer implementation
+void FramePacer::initialize() {
+    adaptiveSupported = glfwExtensionSupported("GLX_EXT_swap_control_tear") ||
+                        glfwExtensionSupported("WGL_EXT_swap_control_tear");
+    frameTimesMs.assign(kHistoryFrames, 0.0f);
+    setSwapMode(swapMode);
+    std::cout << "[PACING] Target " << targetFps << " FPS | adaptive vsync: "
+              << (adaptiveSupported ? "supported" : "unsupported (falls back to vsync)") << std::endl;
+}
+
+void FramePacer::setSwapMode(SwapMode mode) {
+    swapMode = mode;
+    int interval = 0;
+    if (mode == SwapMode::VSync) {
+        interval = 1;
+    } else if (mode == SwapMode::Adaptive) {
+        interval = adaptiveSupported ? -1 : 1;
+    }
+    glfwSwapInterval(interval);
+    if (g_verbose) {
+        std::cout << "[PACING] Swap interval " << interval << std::endl;
+    }
+}
+
+float FramePacer::getEffectiveFps() const {
+    if (targetFps <= 0.0f) return controllerCapFps;
+    if (controllerCapFps <= 0.0f) return targetFps;
+    return std::min(targetFps, controllerCapFps);
+}
+
+void FramePacer::waitForNextFrame() {
+    Clock::time_point now = Clock::now();
+    float fps = getEffectiveFps();
+    if (fps > 0.0f) {
+        auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / fps));
+        deadline = started ? deadline + period : now + period;
+        // More than a frame late: restart the schedule instead of rushing to catch up
+        if (deadline + period < now) {
+            deadline = now + period;
+        }
+
+        // Sleep through most of the wait, then spin for precision
+        auto sleepUntil = deadline - std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double, std::milli>(sleepMarginMs));
+        if (sleepUntil > now) {
+            std::this_thread::sleep_until(sleepUntil);
+            double lateMs = std::chrono::duration<double, std::milli>(Clock::now() - sleepUntil).count();
+            oversleepMs = oversleepMs * 0.95 + lateMs * 0.05;
+            sleepMarginMs = std::min(4.0, std::max(0.25, oversleepMs * 2.0));
+        }
+        while (Clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        now = Clock::now();
+    }
+
+    if (started) {
+        frameTimesMs[frameTimeCursor] = std::chrono::duration<float, std::milli>(now - lastFrameEnd).count();
+        frameTimeCursor = (frameTimeCursor + 1) % kHistoryFrames;
+    }
+    lastFrameEnd = now;
+    started = true;
+}
+
+float FramePacer::getAverageFrameMs() const {
+    float sum = 0.0f;
+    int count = 0;
+    for (float ms : frameTimesMs) {
+        if (ms > 0.0f) {
+            sum += ms;
+            count++;
+        }
+    }
+    return count ? sum / count : 0.0f;
+}
+
+float FramePacer::getJitterMs() const {
+    float mean = getAverageFrameMs();
+    float sumSquares = 0.0f;
+    int count = 0;
+    for (float ms : frameTimesMs) {
+        if (ms > 0.0f) {
+            sumSquares += (ms - mean) * (ms - mean);
+            count++;
+        }
+    }
+    return count > 1 ? std::sqrt(sumSquares / (count - 1)) : 0.0f;
+}
+
+float FramePacer::getWorstFrameMs() const {
+    return *std::max_element(frameTimesMs.begin(), frameTimesMs.end());
+}
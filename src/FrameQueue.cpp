@@ -0,0 +1,116 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/FrameQueue.h"
+#include <algorithm>
+#include <chrono>
+
+// FrameQueue implementation
+bool FrameQueue::initialize(int framesInFlight) {
+    depth = std::min(std::max(framesInFlight, 1), kMaxFramesInFlight);
+    timestampsSupported = GLEW_ARB_timer_query || GLEW_VERSION_3_3;
+    if (timestampsSupported) {
+        for (Slot& s : slots) glGenQueries(2, s.timestampQueries);
+    }
+    std::cout << "[FRAMES] " << depth << " frame(s) in flight (max " << kMaxFramesInFlight << ")"
+              << (timestampsSupported ? "" : ", GPU frame timing unsupported") << std::endl;
+    checkGLError("Frame queue creation");
+    return true;
+}
+
+void FrameQueue::retire(Slot& retired) {
+    if (retired.fence) {
+        // Flush so the fence is guaranteed to signal even if nothing else is submitted
+        GLenum result = glClientWaitSync(retired.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+        while (result == GL_TIMEOUT_EXPIRED) {
+            result = glClientWaitSync(retired.fence, 0, 1000000);  // 1 ms
+        }
+        if (result == GL_WAIT_FAILED) {
+            std::cerr << "[FRAMES] glClientWaitSync failed" << std::endl;
+        }
+        glDeleteSync(retired.fence);
+        retired.fence = nullptr;
+    }
+    if (retired.timestampsPending) {
+        // The fence covers both timestamps, so the results are ready
+        GLuint64 start = 0, end = 0;
+        glGetQueryObjectui64v(retired.timestampQueries[0], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(retired.timestampQueries[1], GL_QUERY_RESULT, &end);
+        lastGpuFrameMs = (end - start) / 1000000.0f;
+        retired.timestampsPending = false;
+    }
+}
+
+void FrameQueue::beginFrame() {
+    auto waitStart = std::chrono::steady_clock::now();
+    retire(slots[slot]);
+    lastFenceWaitMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - waitStart).count();
+
+    if (timestampsSupported) {
+        glQueryCounter(slots[slot].timestampQueries[0], GL_TIMESTAMP);
+    }
+}
+
+void FrameQueue::endFrame() {
+    Slot& current = slots[slot];
+    if (timestampsSupported) {
+        glQueryCounter(current.timestampQueries[1], GL_TIMESTAMP);
+        current.timestampsPending = true;
+    }
+    current.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    frameIndex++;
+    slot = (int)(frameIndex % depth);
+}
+
+void FrameQueue::waitIdle() {
+    for (Slot& s : slots) retire(s);
+}
+
+void FrameQueue::setDepth(int framesInFlight) {
+    framesInFlight = std::min(std::max(framesInFlight, 1), kMaxFramesInFlight);
+    if (framesInFlight == depth) return;
+    waitIdle();
+    depth = framesInFlight;
+    slot = (int)(frameIndex % depth);
+    std::cout << "[FRAMES] " << depth << " frame(s) in flight" << std::endl;
+}
+
+void FrameQueue::cleanup() {
+    waitIdle();
+    for (Slot& s : slots) {
+        if (s.timestampQueries[0]) glDeleteQueries(2, s.timestampQueries);
+        s.timestampQueries[0] = s.timestampQueries[1] = 0;
+    }
+}
+
+// UniformRing implementation
+bool UniformRing::initialize(GLuint binding, GLsizeiptr size) {
+    GLint alignment = 256;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    bindingPoint = binding;
+    blockSize = size;
+    stride = (size + alignment - 1) / alignment * alignment;
+
+    glGenBuffers(1, &buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, stride * FrameQueue::kMaxFramesInFlight, nullptr, GL_DYNAMIC_DRAW);
+    glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, buffer, 0, blockSize);
+    checkGLError("Uniform ring creation");
+    return true;
+}
+
+void* UniformRing::map(int slot) {
+    GLintptr offset = stride * slot;
+    glBindBufferRange(GL_UNIFORM_BUFFER, bindingPoint, buffer, offset, blockSize);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    return glMapBufferRange(GL_UNIFORM_BUFFER, offset, blockSize,
+                            GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+}
+
+void UniformRing::unmap() {
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glUnmapBuffer(GL_UNIFORM_BUFFER);
+}
+
+void UniformRing::cleanup() {
+    if (buffer) glDeleteBuffers(1, &buffer);
+    buffer = 0;
+}
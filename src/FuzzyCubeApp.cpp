@@ -1,4 +1,15 @@
 #include "../include/FuzzyCubeApp.h"
+#include "../include/ImageIO.h"
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 // Global verbose flag
 bool g_verbose = false;
@@ -65,6 +76,45 @@ void checkGLError(const char* operation) {
     }
 }
 
+GLFWwindow* createGLWindow(int width, int height, const char* title, bool visible, bool preferGL43,
+                           GLFWwindow* shareWith) {
+    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
+    
+    GLFWwindow* created = nullptr;
+    if (preferGL43) {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        created = glfwCreateWindow(width, height, title, nullptr, shareWith);
+        if (!created) {
+            std::cout << "[DEBUG] OpenGL 4.3 core context unavailable, falling back to 3.3" << std::endl;
+        }
+    }
+    if (!created) {
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+        created = glfwCreateWindow(width, height, title, nullptr, shareWith);
+    }
+    glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+    
+    if (!created) {
+        std::cerr << "Failed to create GLFW window" << std::endl;
+        return nullptr;
+    }
+    glfwMakeContextCurrent(created);
+    return created;
+}
+
+std::string makeTempPath(const std::string& path) {
+    static std::atomic<unsigned> counter{0};
+#ifdef __linux__
+    long process = (long)getpid();
+#else
+    long process = 0;
+#endif
+    return path + "." + std::to_string(process) + "-" + std::to_string(counter++) + ".tmp";
+}
+
 // Cube vertex data definitions
 namespace CubeData {
     // Simple cube for low quality - all 6 faces with distinct colors
@@ -187,9 +237,194 @@ namespace CubeData {
          1.0f, -1.0f,  1.0f, 0.0f,
          1.0f,  1.0f,  1.0f, 1.0f
     };
+
+    // Ground plane under the single object, receiving its shadow (same layout as the cube)
+    float groundPlaneVertices[] = {
+        // positions          // normals          // colors
+        -5.0f, -1.0f, -6.0f,  0.0f, 1.0f, 0.0f,  0.45f, 0.47f, 0.5f,
+        -5.0f, -1.0f,  2.0f,  0.0f, 1.0f, 0.0f,  0.45f, 0.47f, 0.5f,
+         5.0f, -1.0f,  2.0f,  0.0f, 1.0f, 0.0f,  0.45f, 0.47f, 0.5f,
+
+        -5.0f, -1.0f, -6.0f,  0.0f, 1.0f, 0.0f,  0.45f, 0.47f, 0.5f,
+         5.0f, -1.0f,  2.0f,  0.0f, 1.0f, 0.0f,  0.45f, 0.47f, 0.5f,
+         5.0f, -1.0f, -6.0f,  0.0f, 1.0f, 0.0f,  0.45f, 0.47f, 0.5f,
+    };
+
+    std::vector<glm::mat4> generateInstanceField(int count, unsigned int seed) {
+        std::vector<glm::mat4> transforms;
+        transforms.reserve(count);
+
+        // Cubic grid with 2-unit spacing centered on the origin, so the camera sits inside the field
+        int side = (int)std::ceil(std::cbrt((double)count));
+        float spacing = 2.0f;
+        float offset = (side - 1) * spacing * 0.5f;
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> jitter(-0.4f, 0.4f);
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 360.0f);
+        std::uniform_real_distribution<float> scale(0.4f, 0.9f);
+
+        for (int i = 0; i < count; i++) {
+            int x = i % side;
+            int y = (i / side) % side;
+            int z = i / (side * side);
+            glm::vec3 position(x * spacing - offset + jitter(rng),
+                               y * spacing - offset + jitter(rng),
+                               z * spacing - offset + jitter(rng));
+
+            glm::vec3 axis(unit(rng), unit(rng), unit(rng));
+            if (glm::length(axis) < 0.01f) axis = glm::vec3(0.0f, 1.0f, 0.0f);
+
+            glm::mat4 transform = glm::translate(glm::mat4(1.0f), position);
+            transform = glm::rotate(transform, glm::radians(angle(rng)), glm::normalize(axis));
+            transform = glm::scale(transform, glm::vec3(scale(rng)));
+            transforms.push_back(transform);
+        }
+        return transforms;
+    }
 }
 
 // ShaderManager implementation
+bool ShaderManager::programCacheEnabled = true;
+std::atomic<int> ShaderManager::programCacheHits{0};
+std::atomic<int> ShaderManager::programCacheMisses{0};
+const char* const ShaderManager::kProgramCacheDirectory = ".shader_cache";
+
+namespace {
+    // Header of a cached program binary file
+    struct ProgramCacheHeader {
+        char magic[4];           // "FCPB"
+        uint32_t version;
+        uint32_t binaryFormat;   // As returned by glGetProgramBinary
+        uint32_t binaryLength;
+    };
+    const uint32_t kProgramCacheVersion = 1;
+
+    // Both compile-cost benchmarks end with it
+    void printDriverCacheNote() {
+        std::cout << "[BENCH] Note: driver-side caches (e.g. Mesa's) can hide compile cost; "
+                  << "MESA_SHADER_CACHE_DISABLE=true shows the raw cost" << std::endl;
+    }
+}
+
+bool ShaderManager::isProgramCacheSupported() {
+    if (!GLEW_VERSION_4_1 && !GLEW_ARB_get_program_binary) return false;
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    return formats > 0;
+}
+
+std::string ShaderManager::programCacheKey(const std::vector<std::string>& sources) {
+    // FNV-1a over every stage's source plus the driver identity: binaries are only
+    // valid for the exact driver build that produced them
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const char* data, size_t length) {
+        for (size_t i = 0; i < length; i++) {
+            hash ^= (unsigned char)data[i];
+            hash *= 1099511628211ull;
+        }
+        hash ^= 0xff;  // Separator so ("ab", "c") and ("a", "bc") differ
+        hash *= 1099511628211ull;
+    };
+    for (const std::string& source : sources) mix(source.data(), source.size());
+    for (GLenum name : {GL_RENDERER, GL_VERSION}) {
+        const char* value = (const char*)glGetString(name);
+        if (value) mix(value, std::strlen(value));
+    }
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)hash);
+    return hex;
+}
+
+GLuint ShaderManager::loadCachedProgram(const std::string& key, const std::string& programName) {
+    if (!programCacheEnabled || !isProgramCacheSupported()) return 0;
+
+    std::ifstream file(std::string(kProgramCacheDirectory) + "/" + key + ".bin", std::ios::binary);
+    ProgramCacheHeader header;
+    if (!file.is_open() || !file.read((char*)&header, sizeof(header)) ||
+        std::memcmp(header.magic, "FCPB", 4) != 0 || header.version != kProgramCacheVersion) {
+        programCacheMisses++;
+        return 0;
+    }
+    // The length must match what follows the header before anything is allocated: a
+    // truncated or foreign file could otherwise ask for gigabytes (and bad_alloc on the
+    // loader thread would terminate the process)
+    std::streampos binaryStart = file.tellg();
+    file.seekg(0, std::ios::end);
+    std::streamoff remaining = file.tellg() - binaryStart;
+    file.seekg(binaryStart);
+    if (header.binaryLength == 0 || remaining != (std::streamoff)header.binaryLength) {
+        std::cout << "[SHADER CACHE] Binary for " << programName << " has the wrong length, recompiling" << std::endl;
+        programCacheMisses++;
+        return 0;
+    }
+    std::vector<char> binary(header.binaryLength);
+    if (!file.read(binary.data(), binary.size())) {
+        programCacheMisses++;
+        return 0;
+    }
+
+    GLuint program = glCreateProgram();
+    glProgramBinary(program, header.binaryFormat, binary.data(), (GLsizei)binary.size());
+    GLint success = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        // Driver update or different GPU behind the same strings: compile from source instead
+        std::cout << "[SHADER CACHE] Binary for " << programName << " rejected by the driver, recompiling" << std::endl;
+        glDeleteProgram(program);
+        glGetError();  // glProgramBinary may raise GL_INVALID_ENUM for unknown formats
+        programCacheMisses++;
+        return 0;
+    }
+
+    programCacheHits++;
+    validateProgram(program, programName);
+    std::cout << "[SHADER] Program loaded from binary cache (ID: " << program << ")" << std::endl;
+    return program;
+}
+
+void ShaderManager::storeCachedProgram(GLuint program, const std::string& key) {
+    if (!programCacheEnabled || !isProgramCacheSupported()) return;
+
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) return;
+    std::vector<char> binary(length);
+    GLenum format = 0;
+    glGetProgramBinary(program, length, nullptr, &format, binary.data());
+
+    std::error_code error;
+    std::filesystem::create_directories(kProgramCacheDirectory, error);
+    ProgramCacheHeader header = {{'F', 'C', 'P', 'B'}, kProgramCacheVersion, format, (uint32_t)length};
+
+    // Write then rename so a concurrent launch never reads a half-written file
+    std::string path = std::string(kProgramCacheDirectory) + "/" + key + ".bin";
+    std::string tempPath = makeTempPath(path);
+    {
+        std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "[SHADER CACHE] Cannot write " << tempPath << std::endl;
+            return;
+        }
+        file.write((const char*)&header, sizeof(header));
+        file.write(binary.data(), binary.size());
+    }
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);  // Temp names are unique, so nothing else reuses it
+        return;
+    }
+    if (g_verbose) {
+        std::cout << "[SHADER CACHE] Stored " << length << " byte binary as " << path << std::endl;
+    }
+}
+
+void ShaderManager::clearProgramCache() {
+    std::error_code error;
+    std::filesystem::remove_all(kProgramCacheDirectory, error);
+}
+
 std::string ShaderManager::loadShaderSource(const std::string& filePath) {
     std::ifstream file(filePath);
     if (!file.is_open()) {
@@ -201,7 +436,8 @@ std::string ShaderManager::loadShaderSource(const std::string& filePath) {
     return buffer.str();
 }
 
-GLuint ShaderManager::compileShader(GLenum type, const std::string& source, const std::string& shaderName) {
+GLuint ShaderManager::compileShader(GLenum type, const std::string& source, const std::string& shaderName,
+                                    std::string* errors) {
     GLuint shader = glCreateShader(type);
     const char* src = source.c_str();
     glShaderSource(shader, 1, &src, nullptr);
@@ -213,7 +449,13 @@ GLuint ShaderManager::compileShader(GLenum type, const std::string& source, cons
     if (!success) {
         GLchar infoLog[1024];
         glGetShaderInfoLog(shader, 1024, nullptr, infoLog);
-        const char* typeStr = (type == GL_VERTEX_SHADER) ? "VERTEX" : "FRAGMENT";
+        const char* typeStr = (type == GL_VERTEX_SHADER) ? "VERTEX" :
+                              (type == GL_COMPUTE_SHADER) ? "COMPUTE" : "FRAGMENT";
+        if (errors) {
+            *errors += std::string(typeStr) + " shader " + shaderName + " failed to compile:\n" + infoLog;
+            glDeleteShader(shader);
+            return 0;
+        }
         std::cerr << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << std::endl;
         std::cerr << "❌ FATAL: " << typeStr << " SHADER COMPILATION FAILED" << std::endl;
         std::cerr << "Shader: " << shaderName << std::endl;
@@ -231,21 +473,48 @@ GLuint ShaderManager::compileShader(GLenum type, const std::string& source, cons
     return shader;
 }
 
-GLuint ShaderManager::createShaderProgram(const std::string& vertexPath, const std::string& fragmentPath) {
+std::string ShaderManager::injectDefines(const std::string& source, const std::string& defines) {
+    if (defines.empty()) return source;
+    // #version must stay the first line
+    size_t insertAt = 0;
+    if (source.compare(0, 8, "#version") == 0) {
+        size_t lineEnd = source.find('\n');
+        insertAt = lineEnd == std::string::npos ? source.size() : lineEnd + 1;
+    }
+    return source.substr(0, insertAt) + defines + source.substr(insertAt);
+}
+
+GLuint ShaderManager::createShaderProgram(const std::string& vertexPath, const std::string& fragmentPath,
+                                          const std::string& defines, std::string* errors) {
     std::cout << "[SHADER] Creating program from " << vertexPath << " + " << fragmentPath << std::endl;
     
-    std::string vertexSource = loadShaderSource(vertexPath);
-    std::string fragmentSource = loadShaderSource(fragmentPath);
+    std::string vertexSource = injectDefines(loadShaderSource(vertexPath), defines);
+    std::string fragmentSource = injectDefines(loadShaderSource(fragmentPath), defines);
     
     if (vertexSource.empty() || fragmentSource.empty()) {
+        if (errors) {
+            *errors += "Failed to load shader sources " + vertexPath + " + " + fragmentPath;
+            return 0;
+        }
         std::cerr << "❌ FATAL: Failed to load shader sources" << std::endl;
         std::exit(1);
     }
     
-    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource, vertexPath);
-    GLuint fragmentShader = compileShader(GL_FRAGMENT_SHADER, fragmentSource, fragmentPath);
+    std::string cacheKey = programCacheKey({vertexSource, fragmentSource});
+    GLuint cachedProgram = loadCachedProgram(cacheKey, vertexPath + "+" + fragmentPath);
+    if (cachedProgram) return cachedProgram;
+    
+    GLuint vertexShader = compileShader(GL_VERTEX_SHADER, vertexSource, vertexPath, errors);
+    GLuint fragmentShader = vertexShader ? compileShader(GL_FRAGMENT_SHADER, fragmentSource, fragmentPath, errors) : 0;
+    if (!fragmentShader) {
+        glDeleteShader(vertexShader);  // Only reached with 'errors', which now holds the log
+        return 0;
+    }
     
     GLuint program = glCreateProgram();
+    if (programCacheEnabled && isProgramCacheSupported()) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
     glAttachShader(program, vertexShader);
     glAttachShader(program, fragmentShader);
     glLinkProgram(program);
@@ -256,6 +525,13 @@ GLuint ShaderManager::createShaderProgram(const std::string& vertexPath, const s
     if (!success) {
         GLchar infoLog[1024];
         glGetProgramInfoLog(program, 1024, nullptr, infoLog);
+        if (errors) {
+            *errors += "Program " + vertexPath + " + " + fragmentPath + " failed to link:\n" + infoLog;
+            glDeleteProgram(program);
+            glDeleteShader(vertexShader);
+            glDeleteShader(fragmentShader);
+            return 0;
+        }
         std::cerr << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << std::endl;
         std::cerr << "❌ FATAL: SHADER PROGRAM LINKING FAILED" << std::endl;
         std::cerr << "Program: " << vertexPath << " + " << fragmentPath << std::endl;
@@ -274,11 +550,58 @@ GLuint ShaderManager::createShaderProgram(const std::string& vertexPath, const s
     
     glDeleteShader(vertexShader);
     glDeleteShader(fragmentShader);
+    storeCachedProgram(program, cacheKey);
     
     std::cout << "[SHADER] Program created successfully (ID: " << program << ")" << std::endl;
     return program;
 }
 
+GLuint ShaderManager::createComputeProgram(const std::string& computePath) {
+    std::cout << "[SHADER] Creating compute program from " << computePath << std::endl;
+    
+    std::string computeSource = loadShaderSource(computePath);
+    if (computeSource.empty()) {
+        std::cerr << "❌ FATAL: Failed to load compute shader source" << std::endl;
+        std::exit(1);
+    }
+    
+    std::string cacheKey = programCacheKey({computeSource});
+    GLuint cachedProgram = loadCachedProgram(cacheKey, computePath);
+    if (cachedProgram) return cachedProgram;
+    
+    GLuint computeShader = compileShader(GL_COMPUTE_SHADER, computeSource, computePath);
+    
+    GLuint program = glCreateProgram();
+    if (programCacheEnabled && isProgramCacheSupported()) {
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    }
+    glAttachShader(program, computeShader);
+    glLinkProgram(program);
+    
+    GLint success;
+    glGetProgramiv(program, GL_LINK_STATUS, &success);
+    if (!success) {
+        GLchar infoLog[1024];
+        glGetProgramInfoLog(program, 1024, nullptr, infoLog);
+        std::cerr << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << std::endl;
+        std::cerr << "❌ FATAL: COMPUTE PROGRAM LINKING FAILED" << std::endl;
+        std::cerr << "Program: " << computePath << std::endl;
+        std::cerr << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << std::endl;
+        std::cerr << infoLog << std::endl;
+        std::cerr << "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━" << std::endl;
+        glDeleteProgram(program);
+        glDeleteShader(computeShader);
+        std::cerr << "Application cannot continue with invalid shader program. Exiting." << std::endl;
+        std::exit(1);
+    }
+    
+    glDeleteShader(computeShader);
+    storeCachedProgram(program, cacheKey);
+    
+    std::cout << "[SHADER] Compute program created successfully (ID: " << program << ")" << std::endl;
+    return program;
+}
+
 GLuint ShaderManager::reloadShaderProgram(GLuint oldProgram, const std::string& vertexPath, const std::string& fragmentPath) {
     std::cout << "[SHADER] Attempting to reload shader program..." << std::endl;
     
@@ -374,27 +697,15 @@ bool ShaderManager::validateProgram(GLuint program, const std::string& programNa
 }
 
 // FramebufferManager implementation
-FramebufferManager::FramebufferManager() {
-    for (int i = 0; i < 3; i++) {
-        fbos[i].framebuffer = 0;
-        fbos[i].textureColorbuffer = 0;
-        fbos[i].rbo = 0;
-        fbos[i].width = 0;
-        fbos[i].height = 0;
-    }
-}
-
-bool FramebufferManager::initialize() {
-    // Pre-allocate three FBOs with different resolutions for each quality level
-    // Quality 0 (Low): 600x400 (50% resolution)
-    // Quality 1 (Medium): 900x600 (75% resolution)
-    // Quality 2 (High): 1200x800 (100% resolution)
-    int widths[] = {600, 900, 1200};
-    int heights[] = {400, 600, 800};
-    
-    for (int i = 0; i < 3; i++) {
-        fbos[i].width = widths[i];
-        fbos[i].height = heights[i];
+bool FramebufferManager::initialize(const QualityTierRegistry& tiers) {
+    // Pre-allocate one FBO per quality tier at its share of the 1200x800 output, so switching
+    // tiers never allocates (e.g. Low at 50%: 600x400)
+    glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+    fbos.assign(tiers.size(), QualityFBO());
+    
+    for (int i = 0; i < tiers.size(); i++) {
+        fbos[i].width = tiers[i].renderWidth();
+        fbos[i].height = tiers[i].renderHeight();
         
         if (g_verbose) {
             std::cout << "[FBO] Creating FBO for quality " << i << " (" 
@@ -408,12 +719,23 @@ bool FramebufferManager::initialize() {
         // Create color attachment texture
         glGenTextures(1, &fbos[i].textureColorbuffer);
         glBindTexture(GL_TEXTURE_2D, fbos[i].textureColorbuffer);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, fbos[i].width, fbos[i].height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        // Sized RGB8 so a multisample resolve blit has matching formats
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, fbos[i].width, fbos[i].height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
         glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
         glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, fbos[i].textureColorbuffer, 0);
         checkGLError("FBO texture creation");
         
+        // Velocity attachment, only written while temporal upsampling is on for this tier
+        glGenTextures(1, &fbos[i].velocityTexture);
+        glBindTexture(GL_TEXTURE_2D, fbos[i].velocityTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RG16F, fbos[i].width, fbos[i].height, 0, GL_RG, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, fbos[i].velocityTexture, 0);
+        glDrawBuffer(GL_COLOR_ATTACHMENT0);
+        checkGLError("FBO velocity texture creation");
+        
         // Create renderbuffer for depth and stencil
         glGenRenderbuffers(1, &fbos[i].rbo);
         glBindRenderbuffer(GL_RENDERBUFFER, fbos[i].rbo);
@@ -434,22 +756,100 @@ bool FramebufferManager::initialize() {
     
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
     checkGLError("FBO initialization");
-    std::cout << "[FBO] All 3 FBOs pre-allocated successfully" << std::endl;
+    std::cout << "[FBO] All " << fbos.size() << " FBOs pre-allocated successfully" << std::endl;
     return true;
 }
 
 void FramebufferManager::bind(int quality) {
-    if (quality < 0 || quality > 2) {
+    if (quality < 0 || quality >= (int)fbos.size()) {
         std::cerr << "[FBO ERROR] Invalid quality level: " << quality << std::endl;
         return;
     }
-    glBindFramebuffer(GL_FRAMEBUFFER, fbos[quality].framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, getFramebuffer(quality));
     currentBoundQuality = quality;
     if (g_verbose) {
         checkGLError("FBO bind");
     }
 }
 
+bool FramebufferManager::setSamples(int quality, int samples) {
+    QualityFBO& fbo = fbos[quality];
+    samples = samples <= 1 ? 0 : std::min(samples, maxSamples);
+    if (samples == fbo.samples) return false;
+    if (!samples || samples == fbo.msaaAllocated) {
+        fbo.samples = samples;
+        return true;
+    }
+    destroyMultisampleTarget(fbo);
+    fbo.samples = samples;
+
+    // Same attachments as the single-sample FBO: colour, velocity, depth/stencil
+    glGenFramebuffers(1, &fbo.msaaFramebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo.msaaFramebuffer);
+    glGenRenderbuffers(1, &fbo.msaaColor);
+    glBindRenderbuffer(GL_RENDERBUFFER, fbo.msaaColor);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGB8, fbo.width, fbo.height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, fbo.msaaColor);
+    glGenRenderbuffers(1, &fbo.msaaVelocity);
+    glBindRenderbuffer(GL_RENDERBUFFER, fbo.msaaVelocity);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RG16F, fbo.width, fbo.height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_RENDERBUFFER, fbo.msaaVelocity);
+    glGenRenderbuffers(1, &fbo.msaaDepthStencil);
+    glBindRenderbuffer(GL_RENDERBUFFER, fbo.msaaDepthStencil);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH24_STENCIL8, fbo.width, fbo.height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, fbo.msaaDepthStencil);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    checkGLError("MSAA FBO creation");
+
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, currentBoundQuality >= 0 ? getFramebuffer(currentBoundQuality) : 0);
+    if (!complete) {
+        std::cerr << "[FBO] " << samples << "x MSAA FBO for quality " << quality
+                  << " is not complete; falling back to single-sample" << std::endl;
+        destroyMultisampleTarget(fbo);
+        fbo.samples = 0;
+        return true;
+    }
+    fbo.msaaAllocated = samples;
+    std::cout << "[FBO] Quality " << quality << " now renders with " << samples << "x MSAA" << std::endl;
+    return true;
+}
+
+void FramebufferManager::destroyMultisampleTarget(QualityFBO& fbo) {
+    if (fbo.msaaFramebuffer) glDeleteFramebuffers(1, &fbo.msaaFramebuffer);
+    if (fbo.msaaColor) glDeleteRenderbuffers(1, &fbo.msaaColor);
+    if (fbo.msaaVelocity) glDeleteRenderbuffers(1, &fbo.msaaVelocity);
+    if (fbo.msaaDepthStencil) glDeleteRenderbuffers(1, &fbo.msaaDepthStencil);
+    fbo.msaaFramebuffer = fbo.msaaColor = fbo.msaaVelocity = fbo.msaaDepthStencil = 0;
+    fbo.samples = fbo.msaaAllocated = 0;
+}
+
+void FramebufferManager::resolve(int quality, bool velocity) {
+    QualityFBO& fbo = fbos[quality];
+    if (!fbo.samples) return;
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo.msaaFramebuffer);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fbo.framebuffer);
+    // One blit per attachment: the read buffer selects the source, the draw buffers the target
+    for (int attachment = 0; attachment < (velocity ? 2 : 1); attachment++) {
+        GLenum drawBuffers[2] = {GL_NONE, GL_NONE};
+        drawBuffers[attachment] = GL_COLOR_ATTACHMENT0 + attachment;
+        glReadBuffer(GL_COLOR_ATTACHMENT0 + attachment);
+        glDrawBuffers(attachment + 1, drawBuffers);
+        glBlitFramebuffer(0, 0, fbo.width, fbo.height, 0, 0, fbo.width, fbo.height, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    }
+    glReadBuffer(GL_COLOR_ATTACHMENT0);
+    glDrawBuffer(GL_COLOR_ATTACHMENT0);
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo.framebuffer);
+    if (g_verbose) {
+        checkGLError("MSAA resolve");
+    }
+}
+
+void FramebufferManager::setVelocityOutput(bool enabled) {
+    const GLenum attachments[2] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1};
+    glDrawBuffers(enabled ? 2 : 1, attachments);
+}
+
 void FramebufferManager::unbind() { 
     glBindFramebuffer(GL_FRAMEBUFFER, 0); 
     currentBoundQuality = -1;
@@ -459,7 +859,7 @@ void FramebufferManager::unbind() {
 }
 
 GLuint FramebufferManager::getTexture(int quality) const { 
-    if (quality < 0 || quality > 2) {
+    if (quality < 0 || quality >= (int)fbos.size()) {
         std::cerr << "[FBO ERROR] Invalid quality level for getTexture: " << quality << std::endl;
         return 0;
     }
@@ -467,11 +867,14 @@ GLuint FramebufferManager::getTexture(int quality) const {
 }
 
 void FramebufferManager::cleanup() {
-    for (int i = 0; i < 3; i++) {
-        if (fbos[i].framebuffer) glDeleteFramebuffers(1, &fbos[i].framebuffer);
-        if (fbos[i].textureColorbuffer) glDeleteTextures(1, &fbos[i].textureColorbuffer);
-        if (fbos[i].rbo) glDeleteRenderbuffers(1, &fbos[i].rbo);
+    for (QualityFBO& fbo : fbos) {
+        if (fbo.framebuffer) glDeleteFramebuffers(1, &fbo.framebuffer);
+        if (fbo.textureColorbuffer) glDeleteTextures(1, &fbo.textureColorbuffer);
+        if (fbo.velocityTexture) glDeleteTextures(1, &fbo.velocityTexture);
+        if (fbo.rbo) glDeleteRenderbuffers(1, &fbo.rbo);
+        destroyMultisampleTarget(fbo);
     }
+    fbos.clear();
 }
 
 // CubeRenderer implementation
@@ -487,10 +890,12 @@ bool CubeRenderer::initialize() {
     std::cout << "[DEBUG CubeRenderer] Binding full cube..." << std::endl;
     glBindVertexArray(cubeVAO);
     
-    // Upload vertex data
+    // Upload vertex data, packed to 16 bytes per vertex (half positions, 10:10:10:2 normals, RGBA8 colors)
+    std::vector<PackedVertex> cubePacked = VertexPacking::packInterleaved(CubeData::cubeVertices, 24);
     glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
-    std::cout << "[DEBUG CubeRenderer] Uploading full cube vertex data (size: " << sizeof(CubeData::cubeVertices) << " bytes, 24 vertices)..." << std::endl;
-    glBufferData(GL_ARRAY_BUFFER, sizeof(CubeData::cubeVertices), CubeData::cubeVertices, GL_STATIC_DRAW);
+    std::cout << "[DEBUG CubeRenderer] Uploading full cube vertex data (size: " << cubePacked.size() * sizeof(PackedVertex)
+              << " bytes packed from " << sizeof(CubeData::cubeVertices) << ", 24 vertices)..." << std::endl;
+    glBufferData(GL_ARRAY_BUFFER, cubePacked.size() * sizeof(PackedVertex), cubePacked.data(), GL_STATIC_DRAW);
     checkGLError("Cube VBO upload");
     
     // Upload index data
@@ -500,15 +905,7 @@ bool CubeRenderer::initialize() {
     checkGLError("Cube EBO upload");
     
     std::cout << "[DEBUG CubeRenderer] Setting up full cube attributes..." << std::endl;
-    // Position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // Normal attribute
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    // Color attribute
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+    VertexPacking::setupPackedAttributes();
     checkGLError("Cube VAO setup");
     
     // Create and bind VAO/VBO for simple cube (low quality)
@@ -520,19 +917,34 @@ bool CubeRenderer::initialize() {
     glBindVertexArray(simpleCubeVAO);
     glBindBuffer(GL_ARRAY_BUFFER, simpleCubeVBO);
     
-    std::cout << "[DEBUG CubeRenderer] Uploading simple cube data (size: " << sizeof(CubeData::simpleCubeVertices) << ")..." << std::endl;
-    glBufferData(GL_ARRAY_BUFFER, sizeof(CubeData::simpleCubeVertices), CubeData::simpleCubeVertices, GL_STATIC_DRAW);
+    std::vector<PackedVertex> simplePacked = VertexPacking::packInterleaved(CubeData::simpleCubeVertices, 36);
+    std::cout << "[DEBUG CubeRenderer] Uploading simple cube data (size: " << simplePacked.size() * sizeof(PackedVertex)
+              << " bytes packed from " << sizeof(CubeData::simpleCubeVertices) << ")..." << std::endl;
+    glBufferData(GL_ARRAY_BUFFER, simplePacked.size() * sizeof(PackedVertex), simplePacked.data(), GL_STATIC_DRAW);
     
     std::cout << "[DEBUG CubeRenderer] Setting up simple cube attributes..." << std::endl;
-    // Position attribute
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)0);
-    glEnableVertexAttribArray(0);
-    // Normal attribute
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
-    // Color attribute
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+    VertexPacking::setupPackedAttributes();
+    
+    // Per-instance model + normal matrix (attributes 3-9) shared by both cube VAOs.
+    // Non-instanced shaders never read these locations, so the regular draws are unaffected.
+    std::cout << "[DEBUG CubeRenderer] Creating instance buffer..." << std::endl;
+    glGenBuffers(1, &instanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    for (GLuint vao : {cubeVAO, simpleCubeVAO}) {
+        glBindVertexArray(vao);
+        InstanceTransforms::setupAttributes();
+    }
+    checkGLError("Instance buffer setup");
+    
+    // Ground plane, packed like the cubes
+    glGenVertexArrays(1, &groundVAO);
+    glGenBuffers(1, &groundVBO);
+    glBindVertexArray(groundVAO);
+    glBindBuffer(GL_ARRAY_BUFFER, groundVBO);
+    std::vector<PackedVertex> groundPacked = VertexPacking::packInterleaved(CubeData::groundPlaneVertices, 6);
+    glBufferData(GL_ARRAY_BUFFER, groundPacked.size() * sizeof(PackedVertex), groundPacked.data(), GL_STATIC_DRAW);
+    VertexPacking::setupPackedAttributes();
+    checkGLError("Ground plane setup");
     
     // Create and bind VAO/VBO for screen quad
     std::cout << "[DEBUG CubeRenderer] Creating screen quad VAO/VBO..." << std::endl;
@@ -560,8 +972,7 @@ bool CubeRenderer::initialize() {
 }
 
 void CubeRenderer::renderCube(GLuint program, int indexCount) {
-    glUseProgram(program);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glUseProgram(program);  // Polygon mode is the scene pass's (wireframe tiers)
     glBindVertexArray(cubeVAO);
     // Use indexed drawing (EBO is already bound to the VAO)
     glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
@@ -572,11 +983,83 @@ void CubeRenderer::renderCube(GLuint program, int indexCount) {
 
 void CubeRenderer::renderSimpleCube(GLuint program) {
     glUseProgram(program);
-    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
     glBindVertexArray(simpleCubeVAO);
     glDrawArrays(GL_TRIANGLES, 0, 36);  // Now rendering all 6 faces
 }
 
+void CubeRenderer::renderCubeInstanced(GLuint program, int indexCount, int instanceCount) {
+    glUseProgram(program);
+    glBindVertexArray(cubeVAO);
+    glDrawElementsInstanced(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0, instanceCount);
+    if (g_verbose) {
+        checkGLError("Cube draw elements instanced");
+    }
+}
+
+void CubeRenderer::renderSimpleCubeInstanced(GLuint program, int instanceCount) {
+    glUseProgram(program);
+    glBindVertexArray(simpleCubeVAO);
+    glDrawArraysInstanced(GL_TRIANGLES, 0, 36, instanceCount);
+}
+
+void CubeRenderer::setInstanceCapacity(size_t capacity) {
+    instanceCapacity = capacity;
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, instanceCapacity * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+    checkGLError("Instance buffer allocation");
+}
+
+InstanceData* CubeRenderer::mapInstanceBuffer() {
+    if (instanceCapacity == 0) return nullptr;
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    // Invalidate so the driver hands back fresh storage instead of stalling on last frame's draw
+    return (InstanceData*)glMapBufferRange(GL_ARRAY_BUFFER, 0, instanceCapacity * sizeof(InstanceData),
+                                           GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+}
+
+void CubeRenderer::unmapInstanceBuffer() {
+    glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+}
+
+GLuint CubeRenderer::createInstancedVAO(bool simple, GLuint instanceBuffer) {
+    if (simple && !simpleCubeEBO) {
+        // The simple cube is non-indexed; give it a trivial index buffer so indirect
+        // elements draws work for every quality level
+        unsigned int sequentialIndices[36];
+        for (unsigned int i = 0; i < 36; i++) sequentialIndices[i] = i;
+        glGenBuffers(1, &simpleCubeEBO);
+        glBindVertexArray(0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, simpleCubeEBO);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(sequentialIndices), sequentialIndices, GL_STATIC_DRAW);
+    }
+    
+    GLuint vao;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    
+    glBindBuffer(GL_ARRAY_BUFFER, simple ? simpleCubeVBO : cubeVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, simple ? simpleCubeEBO : cubeEBO);
+    VertexPacking::setupPackedAttributes();
+    
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    InstanceTransforms::setupAttributes();
+    
+    glBindVertexArray(0);
+    checkGLError("Instanced VAO creation");
+    return vao;
+}
+
+void CubeRenderer::destroyInstancedVAO(GLuint vao) {
+    if (vao) glDeleteVertexArrays(1, &vao);
+}
+
+void CubeRenderer::renderGroundPlane(GLuint program) {
+    glUseProgram(program);
+    glBindVertexArray(groundVAO);
+    glDrawArrays(GL_TRIANGLES, 0, 6);
+}
+
 void CubeRenderer::renderScreenQuad() {
     glBindVertexArray(quadVAO);
     glDrawArrays(GL_TRIANGLES, 0, 6);
@@ -590,6 +1073,10 @@ void CubeRenderer::cleanup() {
     glDeleteBuffers(1, &simpleCubeVBO);
     glDeleteVertexArrays(1, &quadVAO);
     glDeleteBuffers(1, &quadVBO);
+    glDeleteVertexArrays(1, &groundVAO);
+    glDeleteBuffers(1, &groundVBO);
+    glDeleteBuffers(1, &instanceVBO);
+    if (simpleCubeEBO) glDeleteBuffers(1, &simpleCubeEBO);
 }
 
 // ImGuiManager implementation
@@ -605,7 +1092,7 @@ bool ImGuiManager::initialize(GLFWwindow* window) {
 
 void ImGuiManager::renderUI(float& cpuLoad, float& temp, float& gpuLoad, float& vramUsage,
                            float& cameraDistance, float& rotationX, float& rotationY, 
-                           int quality, bool isManualOverride) {
+                           const QualityTierRegistry& tiers, int quality, bool isManualOverride) {
     ImGui::Begin("Fuzzy Logic Parameters");
     ImGui::Text("System Metrics (used to calculate power consumption):");
     ImGui::SliderFloat("CPU Load", &cpuLoad, 0.0f, 200.0f);
@@ -620,11 +1107,10 @@ void ImGuiManager::renderUI(float& cpuLoad, float& temp, float& gpuLoad, float&
     
     ImGui::Separator();
     ImGui::Text("Quality Control:");
-    ImGui::Text("Press 1=Low, 2=Medium, 3=High, 0=Auto");
+    ImGui::Text("Press 1-%d for a tier (lowest first), 0=Auto", tiers.size());
     
     // Show current quality mode
-    const char* qualityNames[] = {"Low", "Medium", "High"};
-    ImGui::Text("Current Quality: %s", qualityNames[quality]);
+    ImGui::Text("Current Quality: %s (%d of %d)", tiers[quality].name.c_str(), quality + 1, tiers.size());
     if (isManualOverride) {
         ImGui::SameLine();
         ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "(MANUAL)");
@@ -641,6 +1127,272 @@ void ImGuiManager::renderUI(float& cpuLoad, float& temp, float& gpuLoad, float&
     ImGui::End();
 }
 
+void ImGuiManager::renderSceneUI(bool& instancedScene, int& instanceCount, bool& useAVX2,
+                                 bool& useGPUCulling, bool gpuCullingSupported,
+                                 size_t visibleCount, float cullTimeMs) {
+    ImGui::Begin("Scene");
+    ImGui::Checkbox("Instanced Scene", &instancedScene);
+    if (instancedScene) {
+        ImGui::SliderInt("Instances", &instanceCount, 1000, 200000);
+        if (gpuCullingSupported) {
+            ImGui::Checkbox("GPU Culling (compute + indirect)", &useGPUCulling);
+        } else {
+            ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "GPU culling needs a GL 4.3 context");
+        }
+        if (gpuCullingSupported && useGPUCulling) {
+            ImGui::Text("Visible: computed on GPU");
+            ImGui::Text("CPU submit: %.3f ms", cullTimeMs);
+        } else {
+            ImGui::Checkbox("AVX2 Culling", &useAVX2);
+            ImGui::Text("Visible: %zu / %d", visibleCount, instanceCount);
+            ImGui::Text("CPU cull + compaction: %.3f ms", cullTimeMs);
+        }
+    }
+    ImGui::End();
+}
+
+void ImGuiManager::renderMeshUI(bool& meshScene, int& lodSelectionMode, float& maxPixelError,
+                                int currentLOD, const MeshLODChain& meshChain) {
+    ImGui::Begin("Mesh LOD");
+    ImGui::Checkbox("Show LOD Mesh", &meshScene);
+    if (meshScene) {
+        const char* modes[] = {"Per Quality Tier", "Screen-Space Error"};
+        ImGui::Combo("LOD Selection", &lodSelectionMode, modes, 2);
+        if (lodSelectionMode == 1) {
+            ImGui::SliderFloat("Max Pixel Error", &maxPixelError, 0.25f, 8.0f);
+        }
+        if (!meshChain.isUploaded()) {
+            ImGui::TextDisabled("Loading the LOD chain (the cube stands in)...");
+        }
+        for (int lod = 0; lod < meshChain.getLODCount(); lod++) {
+            const MeshLOD& level = meshChain.getLOD(lod);
+            ImGui::Text("%s LOD %d: %d triangles, error %.4f", lod == currentLOD ? ">" : " ",
+                        lod, (int)(level.indexCount / 3), level.error);
+        }
+        ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "Replaces the cube in the single-object view");
+    }
+    ImGui::End();
+}
+
+bool ImGuiManager::renderQualityVectorUI(bool& enabled, int& budgetMode, float budget, const QualityVector& vector,
+                                         float renderScale, float estimatedMs, float score, float gpuFrameMs,
+                                         bool calibrated) {
+    ImGui::Begin("Quality Vector");
+    ImGui::Checkbox("Solve knobs from the budget", &enabled);
+    const char* modes[] = {"Power (cost x FPS)", "Frame time"};
+    ImGui::Combo("Budget", &budgetMode, modes, 2);
+    if (enabled) {
+        const char* shadingNames[] = {"Unlit", "Lambert", "Phong"};
+        ImGui::Text("Controller budget: %.0f%% of full quality", budget * 100.0f);
+        ImGui::Text("Render scale: %.0f%%", renderScale * 100.0f);
+        ImGui::Text("MSAA: %dx | Shading: %s | Mesh LOD: %d", vector.msaaSamples,
+                    shadingNames[(int)vector.shading], vector.meshLOD);
+        if (vector.fpsCap > 0.0f) {
+            ImGui::Text("FPS cap: %.0f", vector.fpsCap);
+        } else {
+            ImGui::Text("FPS cap: none");
+        }
+        ImGui::Text("Effects: %s", QualityEffect::toString(vector.effects).c_str());
+        ImGui::Text("Score %.2f | estimated %.2f ms | measured %.2f ms GPU", score, estimatedMs, gpuFrameMs);
+    }
+    ImGui::Separator();
+    ImGui::Text("Knob costs: %s", calibrated ? "calibrated on this GPU" : "defaults");
+    bool recalibrate = ImGui::Button("Recalibrate");
+    ImGui::End();
+    return recalibrate;
+}
+
+void ImGuiManager::renderMsaaUI(bool& enabled, QualityTierRegistry& tiers, int maxSamples, float sceneTimeMs,
+                                float resolveTimeMs) {
+    ImGui::Begin("MSAA");
+    ImGui::Checkbox("Enable MSAA (M)", &enabled);
+    const char* counts[] = {"Off", "2x", "4x", "8x"};
+    const int values[] = {0, 2, 4, 8};
+    for (int tier = 0; tier < tiers.size(); tier++) {
+        int index = 0;
+        for (int i = 0; i < 4; i++) {
+            if (values[i] == tiers[tier].msaaSamples) index = i;
+        }
+        std::string label = tiers[tier].name + " Samples";
+        if (ImGui::Combo(label.c_str(), &index, counts, 4)) {
+            tiers[tier].msaaSamples = values[index];
+        }
+    }
+    ImGui::Text("Max supported: %dx", maxSamples);
+    ImGui::Text("Scene pass: %.3f ms | resolve blit: %.3f ms GPU", sceneTimeMs, resolveTimeMs);
+    ImGui::End();
+}
+
+void ImGuiManager::renderShadowUI(bool& enabled, QualityTierRegistry& tiers, int mapSize, float shadowTimeMs) {
+    ImGui::Begin("Shadows");
+    ImGui::Checkbox("Enable Shadows", &enabled);
+    const char* sizes[] = {"Off", "512", "1024", "2048", "4096"};
+    const int values[] = {0, 512, 1024, 2048, 4096};
+    for (int tier = 0; tier < tiers.size(); tier++) {
+        int index = 0;
+        for (int i = 0; i < 5; i++) {
+            if (values[i] == tiers[tier].shadowMapSize) index = i;
+        }
+        std::string label = tiers[tier].name + " Map";
+        if (ImGui::Combo(label.c_str(), &index, sizes, 5)) {
+            tiers[tier].shadowMapSize = values[index];
+            QualityTierRegistry::resolveShadows(tiers[tier]);  // Unlit tiers stay off
+        }
+        label = tiers[tier].name + " PCF Radius";
+        ImGui::SliderInt(label.c_str(), &tiers[tier].shadowPCF, 0, ShadowMapRenderer::kMaxPcfRadius);
+    }
+    ImGui::Text("Shadow pass: %dx%d, %.3f ms GPU", mapSize, mapSize, shadowTimeMs);
+    ImGui::End();
+}
+
+void ImGuiManager::renderPostUI(bool& enabled, QualityTierRegistry& tiers, PostChain& chain, uint32_t active,
+                                const RenderGraph& graph) {
+    ImGui::Begin("Post Effects");
+    ImGui::Checkbox("Enable Post Effects", &enabled);
+    for (int tier = 0; tier < tiers.size(); tier++) {
+        for (int bit = QualityEffect::kFirstPost; bit < QualityEffect::kCount; bit++) {
+            uint32_t effect = 1u << bit;
+            if (bit > QualityEffect::kFirstPost) ImGui::SameLine();
+            bool on = (tiers[tier].postEffects & effect) != 0;
+            std::string label = tiers[tier].name + " " + QualityEffect::toString(effect);
+            if (ImGui::Checkbox(label.c_str(), &on)) {
+                tiers[tier].postEffects ^= effect;
+            }
+        }
+    }
+    ImGui::Separator();
+    ImGui::SliderFloat("Bloom Threshold", &chain.bloomThreshold, 0.0f, 1.5f);
+    ImGui::SliderFloat("Bloom Intensity", &chain.bloomIntensity, 0.0f, 2.0f);
+    ImGui::SliderFloat("Exposure", &chain.exposure, 0.25f, 4.0f);
+    ImGui::SliderFloat("Saturation", &chain.saturation, 0.0f, 2.0f);
+    ImGui::SliderFloat("Contrast", &chain.contrast, 0.5f, 1.5f);
+    ImGui::SliderFloat("Vignette Intensity", &chain.vignetteIntensity, 0.0f, 1.0f);
+    ImGui::SliderFloat("Vignette Radius", &chain.vignetteRadius, 0.0f, 1.5f);
+    ImGui::Separator();
+    // The tier's effects minus those stripped to fit the controller's budget
+    ImGui::Text("Running: %s", QualityEffect::toString(active).c_str());
+    for (int bit = QualityEffect::kFirstPost; bit < QualityEffect::kCount; bit++) {
+        uint32_t effect = 1u << bit;
+        if (active & effect) {
+            ImGui::Text("%-12s %.3f ms GPU", QualityEffect::toString(effect).c_str(),
+                        PostChain::getEffectMs(graph, effect));
+        } else {
+            ImGui::TextDisabled("%-12s off", QualityEffect::toString(effect).c_str());
+        }
+    }
+    ImGui::End();
+}
+
+void ImGuiManager::renderGraphUI(const RenderGraph& graph) {
+    ImGui::Begin("Render Graph");
+    for (const RenderGraph::PassInfo& pass : graph.describe()) {
+        if (pass.culled) {
+            ImGui::TextDisabled("%-22s culled", pass.name.c_str());
+        } else {
+            ImGui::Text("%-22s %.3f ms", pass.name.c_str(), pass.gpuMs);
+        }
+    }
+    ImGui::Separator();
+    ImGui::Text("Transient pool: %d target(s), %.1f MB | %d aliased last frame", graph.getPoolSize(),
+                graph.getPoolBytes() / (1024.0f * 1024.0f), graph.getAliasedTargets());
+    ImGui::End();
+}
+
+void ImGuiManager::renderLoaderUI(const ResourceLoader& loader, GLuint texture) {
+    ImGui::Begin("Resources");
+    ImGui::Text("Loader: %s", ResourceLoader::getModeName(loader.getMode()));
+    ImGui::Text("Jobs: %d pending, %d finished", loader.getPendingCount(), loader.getFinishedCount());
+    if (texture) {
+        ImGui::Image((ImTextureID)(intptr_t)texture, ImVec2(128, 128));
+    } else {
+        ImGui::TextDisabled("Loading textures/sample.png...");
+    }
+    ImGui::End();
+}
+
+void ImGuiManager::renderPresentUI(int& presentMode, float& sharpness, float upscaleTimeMs,
+                                   QualityTierRegistry& tiers, float temporalTimeMs, bool& checkerboard,
+                                   float checkerboardTimeMs, float sceneTimeMs) {
+    ImGui::Begin("Presentation");
+    const char* modes[] = {"Pixelate", "Spatial Upscale + CAS"};
+    ImGui::Combo("Present Mode", &presentMode, modes, 2);
+    if (presentMode == (int)PresentMode::SpatialUpscale) {
+        ImGui::SliderFloat("Sharpness", &sharpness, 0.0f, 1.0f);
+        ImGui::Text("Upscale + sharpen: %.3f ms GPU", upscaleTimeMs);
+    }
+    ImGui::Separator();
+    ImGui::Text("Temporal upsampling (replaces the present mode):");
+    for (int tier = 0; tier < tiers.size(); tier++) {
+        if (tier > 0) ImGui::SameLine();
+        std::string label = "Temporal " + tiers[tier].name;
+        ImGui::Checkbox(label.c_str(), &tiers[tier].temporal);
+    }
+    ImGui::Text("Temporal resolve: %.3f ms GPU", temporalTimeMs);
+    ImGui::Separator();
+    ImGui::Checkbox("Checkerboard (tiers that ask for it)", &checkerboard);
+    ImGui::Text("Checkerboard resolve: %.3f ms GPU", checkerboardTimeMs);
+    ImGui::Text("Scene pass: %.3f ms GPU", sceneTimeMs);
+    ImGui::End();
+}
+
+void ImGuiManager::renderPacingUI(float& targetFps, int& swapMode, bool adaptiveSupported,
+                                  bool& controllerCap, float effectiveFps, float averageMs,
+                                  float jitterMs, float worstMs, bool& renderOnDemand,
+                                  float& idleWakeRate, int idleWakes, int& framesInFlight,
+                                  float fenceWaitMs, float gpuFrameMs) {
+    ImGui::Begin("Frame Pacing");
+    ImGui::SliderFloat("Target FPS (0 = off)", &targetFps, 0.0f, 240.0f, "%.0f");
+    const char* modes[] = {"Off", "VSync", "Adaptive VSync"};
+    ImGui::Combo("Swap Interval", &swapMode, modes, 3);
+    if (!adaptiveSupported) {
+        ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "Adaptive unsupported: falls back to vsync");
+    }
+    ImGui::Checkbox("Quality Tier Caps FPS", &controllerCap);
+    if (effectiveFps > 0.0f) {
+        ImGui::Text("Effective cap: %.0f FPS", effectiveFps);
+    } else {
+        ImGui::Text("Effective cap: none");
+    }
+    ImGui::Text("Frame time: %.2f ms avg, %.2f ms worst", averageMs, worstMs);
+    ImGui::Text("Jitter: %.3f ms (std dev)", jitterMs);
+    ImGui::Separator();
+    ImGui::Checkbox("Render On Demand", &renderOnDemand);
+    if (renderOnDemand) {
+        ImGui::SliderFloat("Idle Wake Rate (Hz)", &idleWakeRate, 0.5f, 30.0f, "%.1f");
+        ImGui::Text("Idle wake-ups skipped: %d", idleWakes);
+    }
+    ImGui::Separator();
+    ImGui::SliderInt("Frames In Flight", &framesInFlight, 1, FrameQueue::kMaxFramesInFlight);
+    ImGui::Text("CPU fence wait: %.3f ms | GPU frame: %.3f ms", fenceWaitMs, gpuFrameMs);
+    ImGui::End();
+}
+
+bool ImGuiManager::renderCaptureUI(int& format, int& source, const QualityTierRegistry& tiers, bool active,
+                                   unsigned long long captured, unsigned long long encoded,
+                                   unsigned long long dropped) {
+    ImGui::Begin("Frame Capture");
+    const char* formats[] = {"PNG Sequence", "Y4M Stream"};
+    std::vector<std::string> sourceNames = {"Presented Frame"};
+    for (int tier = 0; tier < tiers.size(); tier++) sourceNames.push_back(tiers[tier].name + " FBO");
+    std::vector<const char*> sources;
+    for (const std::string& name : sourceNames) sources.push_back(name.c_str());
+    int sourceIndex = source + 1;  // kPresented is -1
+    if (active) {
+        ImGui::Text("Recording %s from %s", formats[format], sources[sourceIndex]);
+    } else {
+        ImGui::Combo("Format", &format, formats, 2);
+        ImGui::Combo("Source", &sourceIndex, sources.data(), (int)sources.size());
+        source = sourceIndex - 1;
+    }
+    bool toggled = ImGui::Button(active ? "Stop Capture" : "Start Capture");
+    ImGui::Text("Captured %llu | encoded %llu | dropped %llu", captured, encoded, dropped);
+    if (source != -1) {
+        ImGui::TextColored(ImVec4(0.6f, 0.6f, 0.6f, 1.0f), "FBO sources record only while that tier is active");
+    }
+    ImGui::End();
+    return toggled;
+}
+
 void ImGuiManager::shutdown() {
     ImGui_ImplOpenGL3_Shutdown();
     ImGui_ImplGlfw_Shutdown();
@@ -719,6 +1471,15 @@ bool PythonManager::initialize() {
         return false;
     }
     
+    // Optional: continuous budget for the quality-vector solver
+    pBudgetFunc = PyObject_GetAttrString(pModule, "compute_budget");
+    if (!pBudgetFunc || !PyCallable_Check(pBudgetFunc)) {
+        PyErr_Clear();
+        Py_XDECREF(pBudgetFunc);
+        pBudgetFunc = nullptr;
+        std::cout << "[DEBUG] No compute_budget in fuzzy_module; budgets follow compute_quality" << std::endl;
+    }
+    
     std::cout << "[DEBUG] Python initialization complete!" << std::endl;
     return true;
 }
@@ -752,42 +1513,82 @@ int PythonManager::getQuality(float cpuLoad, float temp, float gpuLoad, float vr
     return result;
 }
 
+float PythonManager::getBudget(float cpuLoad, float temp, float gpuLoad, float vramUsage) {
+    if (!pBudgetFunc) {
+        return QualitySolver::kTierBudgets[std::max(0, std::min(2, getQuality(cpuLoad, temp, gpuLoad, vramUsage)))];
+    }
+    
+    PyObject* pArgs = PyTuple_Pack(4,
+        PyFloat_FromDouble(cpuLoad),
+        PyFloat_FromDouble(temp),
+        PyFloat_FromDouble(gpuLoad),
+        PyFloat_FromDouble(vramUsage)
+    );
+    
+    PyObject* pResult = PyObject_CallObject(pBudgetFunc, pArgs);
+    Py_DECREF(pArgs);
+    
+    if (!pResult) {
+        PyErr_Print();
+        return QualitySolver::kTierBudgets[1];  // Medium, as getQuality falls back to
+    }
+    
+    float result = (float)PyFloat_AsDouble(pResult);
+    Py_DECREF(pResult);
+    return std::max(0.0f, std::min(1.0f, result));
+}
+
 void PythonManager::cleanup() {
+    Py_XDECREF(pBudgetFunc);
     Py_XDECREF(pFunc);
     Py_DECREF(pModule);
     Py_Finalize();
 }
 
 // QualitySettings implementation
-QualitySettings QualitySettings::getSettings(int quality, GLuint simpleProgram, GLuint mediumProgram, 
-                                          GLuint highProgram, GLuint simpleVAO, GLuint fullVAO) {
+QualitySettings QualitySettings::getSettings(const QualityTier& tier, ShaderPermutations& cubeShaders,
+                                          GLuint simpleVAO, GLuint fullVAO) {
     QualitySettings settings;
+    settings.renderWidth = tier.renderWidth();
+    settings.renderHeight = tier.renderHeight();
+    settings.shaderFeatures = tier.shaderFeatures;
+    settings.simpleGeometry = tier.simpleGeometry;
+    settings.cubeVAO = tier.simpleGeometry ? simpleVAO : fullVAO;  // Simple: non-indexed, 36 vertices
+    settings.indexCount = 36;                  // Vertex count (simple) or index count (indexed)
+    settings.wireframe = tier.wireframe;
+    settings.pixelSize = tier.pixelSize;
+    settings.meshLOD = tier.meshLOD;
+    settings.checkerboard = tier.checkerboard;
+    settings.msaaSamples = tier.msaaSamples;
+    settings.shadowMapSize = tier.shadowMapSize;
+    settings.shadowPCF = tier.shadowPCF;
+    settings.fpsCap = tier.fpsCap;
+    settings.cubeProgram = cubeShaders.get(settings.shaderFeatures);
     
-    if (quality == 0) {
-        // Low quality: Reduce everything
-        settings.renderWidth = 600;   // 50% resolution
-        settings.renderHeight = 400;
-        settings.cubeProgram = simpleProgram;  // No lighting calculations
-        settings.cubeVAO = simpleVAO;          // Simple cube (non-indexed, 36 vertices, 6 faces)
-        settings.indexCount = 36;              // Vertex count for glDrawArrays
-        settings.pixelSize = 32.0f;   // More pixelation
-    } else if (quality == 1) {
-        // Medium quality: Moderate settings
-        settings.renderWidth = 900;   // 75% resolution
-        settings.renderHeight = 600;
-        settings.cubeProgram = mediumProgram;  // Basic lighting only
-        settings.cubeVAO = fullVAO;            // Full indexed geometry
-        settings.indexCount = 36;              // Index count for glDrawElements (36 indices)
-        settings.pixelSize = 64.0f;   // Medium pixelation
-    } else {
-        // High quality: Full quality
-        settings.renderWidth = 1200;  // 100% resolution
-        settings.renderHeight = 800;
-        settings.cubeProgram = highProgram;    // Full lighting
-        settings.cubeVAO = fullVAO;            // Full indexed geometry
-        settings.indexCount = 36;              // Index count for glDrawElements (36 indices)
-        settings.pixelSize = 200.0f;  // Minimal pixelation
-    }
+    return settings;
+}
+
+uint32_t QualitySettings::shadingFeatures(ShadingModel shading) {
+    const uint32_t features[3] = {
+        ShaderFeature::VertexColors,
+        ShaderFeature::VertexColors | ShaderFeature::Diffuse,
+        ShaderFeature::VertexColors | ShaderFeature::Diffuse | ShaderFeature::Specular | ShaderFeature::Attenuation,
+    };
+    return features[(int)shading];
+}
+
+QualitySettings QualitySettings::fromVector(const QualityVector& vector, const QualityTierRegistry& tiers,
+                                           ShaderPermutations& cubeShaders, GLuint simpleVAO, GLuint fullVAO) {
+    QualitySettings settings = getSettings(tiers[vector.scaleTier], cubeShaders, simpleVAO, fullVAO);
+    
+    settings.shaderFeatures = shadingFeatures(vector.shading);
+    settings.wireframe = false;  // The shading knob replaces the tier's program
+    settings.meshLOD = vector.meshLOD;
+    settings.checkerboard = (vector.effects & QualityEffect::Checkerboard) != 0;
+    settings.msaaSamples = vector.msaaSamples;
+    settings.shadowMapSize = 0;  // Not a solver knob: its cost table has no shadow term
+    settings.fpsCap = vector.fpsCap;
+    settings.cubeProgram = cubeShaders.get(settings.shaderFeatures);
     
     return settings;
 }
@@ -813,24 +1614,17 @@ bool FuzzyCubeApp::initialize() {
     }
     
     // Configure GLFW
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-    glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-    glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_SAMPLES, 4);  // Request 4x MSAA
     
-    // Create window
+    // Create window (4.3 core when available for GPU culling, otherwise 3.3 core).
+    // CRITICAL: createGLWindow makes the context current, which must happen BEFORE initializing GLEW
     std::cout << "[DEBUG] Creating window..." << std::endl;
-    window = glfwCreateWindow(1200, 800, "Fuzzy 3D Cube Renderer", nullptr, nullptr);
+    window = createGLWindow(1200, 800, "Fuzzy 3D Cube Renderer", !headless, preferGL43);
     if (!window) {
-        std::cerr << "Failed to create GLFW window" << std::endl;
         glfwTerminate();
         return false;
     }
     
-    // CRITICAL: Make context current BEFORE initializing GLEW
-    std::cout << "[DEBUG] Making OpenGL context current..." << std::endl;
-    glfwMakeContextCurrent(window);
-    
     // Initialize GLEW with experimental features
     std::cout << "[DEBUG] Initializing GLEW..." << std::endl;
     glewExperimental = GL_TRUE;  // Enable modern OpenGL features
@@ -862,36 +1656,150 @@ bool FuzzyCubeApp::initialize() {
     glEnable(GL_MULTISAMPLE);  // Enable MSAA (can be toggled at runtime)
     glViewport(0, 0, 1200, 800);
     
+    // Meshes and shader variants are built on a shared context while the rest initializes
+    // and the first frames draw; without one they load on this thread, one per frame
+    loadStart = std::chrono::steady_clock::now();
+    resourceLoader.start(window);
+    
     // Initialize components
     std::cout << "[DEBUG] Initializing ImGui..." << std::endl;
+    installInputCallbacks();  // Before ImGui, which chains to them
     if (!ImGuiManager::initialize(window)) return false;
     std::cout << "[DEBUG] Initializing cube renderer..." << std::endl;
     if (!cubeRenderer.initialize()) return false;
-    std::cout << "[DEBUG] Initializing framebuffer manager (pre-allocating 3 FBOs)..." << std::endl;
-    if (!framebufferManager.initialize()) return false;
     
-    // Create shader programs
-    cubeSimpleProgram = ShaderManager::createShaderProgram("shaders/cube_simple.vert", "shaders/cube_simple.frag");
-    cubeMediumProgram = ShaderManager::createShaderProgram("shaders/cube_medium.vert", "shaders/cube_medium.frag");
-    cubeHighProgram = ShaderManager::createShaderProgram("shaders/cube.vert", "shaders/cube.frag");
-    pixelateProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/pixelate.frag");
+    // Quality tiers: the config file, else the built-in low/medium/high
+    if (qualityTiers.load(tiersPath)) {
+        std::cout << "[TIERS] Loaded " << qualityTiers.size() << " quality tiers from " << tiersPath << std::endl;
+    } else {
+        std::cout << "[TIERS] Using the built-in low/medium/high tiers" << std::endl;
+    }
+    int checkerboardTier = qualityTiers.highest();  // Initial size; it resizes to whichever tier uses it
+    for (int tier = 0; tier < qualityTiers.size(); tier++) {
+        QualityTier& settings = qualityTiers[tier];
+        settings.temporal = temporalBelowFull && settings.renderScale < 1.0f;
+        if (settings.checkerboard && !qualityTiers[checkerboardTier].checkerboard) checkerboardTier = tier;
+        if (g_verbose) {
+            std::cout << "[TIERS] " << tier << ": " << settings.name << " | " << settings.renderWidth() << "x"
+                      << settings.renderHeight() << " | " << settings.program << " | budget " << settings.budget
+                      << std::endl;
+        }
+    }
+    if (!captureSourceName.empty()) {
+        captureSource = qualityTiers.find(captureSourceName);  // kPresented (-1) when there is none
+        if (captureSource < 0 && captureSourceName != "presented") {
+            std::cerr << "[CAPTURE] No quality tier named '" << captureSourceName << "'; capturing the presented frame"
+                      << std::endl;
+        }
+    }
     
-    if (!cubeSimpleProgram || !cubeMediumProgram || !cubeHighProgram || !pixelateProgram) {
+    std::cout << "[DEBUG] Initializing framebuffer manager (one FBO per quality tier)..." << std::endl;
+    if (!framebufferManager.initialize(qualityTiers)) return false;
+    if (!spatialUpscaler.initialize(1200, 800)) return false;
+    if (!temporalUpsampler.initialize(1200, 800)) return false;
+    if (!checkerboardRenderer.initialize(framebufferManager.getWidth(checkerboardTier),
+                                         framebufferManager.getHeight(checkerboardTier))) {
+        return false;
+    }
+    if (!shadowMap.initialize(1024)) return false;
+    if (!postChain.initialize(1200, 800)) return false;
+    if (headless) {
+        glGenFramebuffers(1, &offscreenFramebuffer);
+        glGenTextures(1, &offscreenTexture);
+        glBindFramebuffer(GL_FRAMEBUFFER, offscreenFramebuffer);
+        glBindTexture(GL_TEXTURE_2D, offscreenTexture);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1200, 800, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, offscreenTexture, 0);
+        bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (!complete) {
+            std::cerr << "[HEADLESS] Offscreen present target is not complete!" << std::endl;
+            return false;
+        }
+    }
+    renderGraph.initialize();
+    qualitySolver.setMaxSamples(framebufferManager.getMaxSamples());
+    qualitySolver.setRenderScales(qualityTiers.getRenderScales());
+    
+    // Knob costs measured on this GPU by an earlier calibration
+    const char* renderer = (const char*)glGetString(GL_RENDERER);
+    QualityCostTable costs;
+    if (renderer && costs.load(QualitySolver::kCostTablePath, renderer)) {
+        qualitySolver.setCostTable(costs);
+        costsCalibrated = true;
+        std::cout << "[CALIBRATE] Loaded knob costs for " << renderer << " from "
+                  << QualitySolver::kCostTablePath << std::endl;
+    }
+    framePacer.setTargetFps(targetFps);
+    framePacer.initialize();
+    framePacer.setSwapMode((FramePacer::SwapMode)swapMode);
+    
+    // Create shader programs (from the binary cache when the driver supports it); the cube
+    // variants are queued on the loader
+    auto programStart = std::chrono::steady_clock::now();
+    if (!createPrograms(&resourceLoader)) {
         std::cerr << "Failed to create shader programs" << std::endl;
         return false;
     }
+    float programMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - programStart).count();
+    std::cout << "[SHADER CACHE] Render-thread programs ready in " << programMs << " ms ("
+              << ShaderManager::getProgramCacheHits() << " from cache, "
+              << ShaderManager::getProgramCacheMisses() << " compiled"
+              << (ShaderManager::isProgramCacheSupported() ? "" : ", cache unsupported by driver") << "); "
+              << resourceLoader.getPendingCount() << " cube variants loading" << std::endl;
+    
+    // High-poly mesh + LOD chain: parsing, simplification and the buffer upload run on the
+    // loader; the VAO is made here once the buffers are complete
+    std::shared_ptr<MeshLODChain> loadedMesh = std::make_shared<MeshLODChain>();
+    std::string sourcePath = meshPath;
+    resourceLoader.submit("mesh LOD chain", [loadedMesh, sourcePath]() {
+        MeshData sourceMesh;
+        if (sourcePath.empty() || !MeshBuilder::loadOBJ(sourcePath, sourceMesh)) {
+            sourceMesh = MeshBuilder::generateRoundedCube(48, 0.3f);
+        }
+        loadedMesh->build(sourceMesh, 4, 0.25f);
+        return loadedMesh->uploadBuffers();
+    }, [this, loadedMesh](bool success) {
+        if (!success || !loadedMesh->createVertexArray()) {
+            loadedMesh->cleanup();
+            return;
+        }
+        meshChain.cleanup();
+        meshChain = std::move(*loadedMesh);
+    });
+    resourceLoader.loadTexture("textures/sample.png", sampleTexture);
+    
+    if (shaderHotReload) {
+        cubeShaders.watch(shaderReloader);
+        shaderReloader.watch(&pixelateProgram, "shaders/pixelate.vert", "shaders/pixelate.frag");
+        for (auto& entry : presentPrograms) {
+            shaderReloader.watch(&entry.second, "shaders/screen.vert", "shaders/" + entry.first + ".frag");
+        }
+        spatialUpscaler.watch(shaderReloader);
+        temporalUpsampler.watch(shaderReloader);
+        checkerboardRenderer.watch(shaderReloader);
+        shadowMap.watch(shaderReloader);
+        postChain.watch(shaderReloader);
+        shaderReloader.start(window, "shaders");
+    }
     
-    // Debug: Print shader program IDs
-    std::cout << "Cube Simple program ID: " << cubeSimpleProgram << std::endl;
-    std::cout << "Cube Medium program ID: " << cubeMediumProgram << std::endl;
-    std::cout << "Cube High program ID: " << cubeHighProgram << std::endl;
-    std::cout << "Pixelate program ID: " << pixelateProgram << std::endl;
+    // Worker pool for CPU culling/compaction (created after Python, like the rest of the threading)
+    threadPool.reset(new ThreadPool());
+    frustumCuller.setThreadPool(threadPool.get());
+    cullAVX2 = FrustumCuller::cpuSupportsAVX2();
+    std::cout << "[CULL] Worker threads: " << threadPool->getThreadCount()
+              << " | AVX2: " << (cullAVX2 ? "yes" : "no (scalar fallback)") << std::endl;
+    
+    // GPU-driven culling path; on 3.3 contexts this stays disabled and the CPU culler is used
+    if (gpuCuller.initialize()) {
+        gpuCubeVAO = cubeRenderer.createInstancedVAO(false, gpuCuller.getVisibleTransformBuffer());
+        gpuSimpleCubeVAO = cubeRenderer.createInstancedVAO(true, gpuCuller.getVisibleTransformBuffer());
+    }
     
     // Create Uniform Buffer Objects for shared data
-    glGenBuffers(1, &matricesUBO);
-    glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-    glBufferData(GL_UNIFORM_BUFFER, 3 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
-    glBindBufferBase(GL_UNIFORM_BUFFER, 0, matricesUBO);
+    if (!matricesRing.initialize(0, 3 * sizeof(glm::mat4))) return false;
     
     glGenBuffers(1, &lightingUBO);
     glBindBuffer(GL_UNIFORM_BUFFER, lightingUBO);
@@ -901,37 +1809,172 @@ bool FuzzyCubeApp::initialize() {
     checkGLError("UBO creation");
     std::cout << "[UBO] Created UBOs for matrices and lighting" << std::endl;
     
-    // Create GPU timer queries for profiling (if supported)
-    if (GLEW_ARB_timer_query || GLEW_VERSION_3_3) {
-        glGenQueries(2, queryIDs);
-        std::cout << "[GPU] Timer queries created for profiling" << std::endl;
-    } else {
-        std::cout << "[GPU] Timer queries not supported on this system" << std::endl;
+    // Per-slot fences and GPU frame timestamps
+    if (!frameQueue.initialize(framesInFlight)) return false;
+    
+    // Draw every pipeline state once so the first switch to a tier does not hitch; the
+    // states need everything the loader builds, so it waits for the loader from run()
+    prewarmPending = prewarm;
+    
+    // The solver needs real costs: measure them once per GPU (or when asked to)
+    if (calibrateOnStartup || (qualityVectorMode && !costsCalibrated && !headless)) {
+        calibrateQualityCosts();
     }
     
+    if (!capturePath.empty()) {
+        resourceLoader.waitIdle();  // Captured sequences start on the final scene
+        bool y4m = capturePath.size() > 4 && capturePath.compare(capturePath.size() - 4, 4, ".y4m") == 0;
+        captureFormat = (int)(y4m ? FrameCapture::Format::Y4M : FrameCapture::Format::PNG);
+        if (!frameCapture.start(capturePath, (FrameCapture::Format)captureFormat, captureSource,
+                                targetFps > 0.0f ? (int)targetFps : 60)) {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+bool FuzzyCubeApp::createPrograms(ResourceLoader* loader) {
+    // Only the über-shader variants the quality tiers and the vector's shading models use
+    // (single object with and without shadows + instanced field, each with and without
+    // temporal motion vectors). All are built up front so the hot-reloader watches them and
+    // toggling temporal upsampling or shadows never compiles mid-frame; with a loader they
+    // are queued on it and a frame only waits for the variant it draws with.
+    std::vector<uint32_t> featureSets;
+    for (int tier = 0; tier < qualityTiers.size(); tier++) featureSets.push_back(qualityTiers[tier].shaderFeatures);
+    for (int shading = 0; shading < 3; shading++) featureSets.push_back(QualitySettings::shadingFeatures((ShadingModel)shading));
+    for (uint32_t features : featureSets) {
+        uint32_t shadows = features & ShaderFeature::Shadows;
+        features &= ~ShaderFeature::Shadows;
+        for (uint32_t extra : {0u, shadows, (uint32_t)ShaderFeature::Instanced}) {
+            for (uint32_t motion : {0u, (uint32_t)ShaderFeature::MotionVectors}) {
+                if (loader) {
+                    cubeShaders.load(features | extra | motion, *loader);
+                } else if (!cubeShaders.get(features | extra | motion)) {
+                    return false;
+                }
+            }
+        }
+    }
+    pixelateProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/pixelate.frag");
+    if (!pixelateProgram) {
+        return false;
+    }
+    
+    // Present shaders other than pixelate, once per name
+    for (int tier = 0; tier < qualityTiers.size(); tier++) {
+        const std::string& present = qualityTiers[tier].present;
+        if (present == "pixelate" || presentPrograms.count(present)) continue;
+        GLuint program = ShaderManager::createShaderProgram("shaders/screen.vert", "shaders/" + present + ".frag");
+        if (!program) {
+            return false;
+        }
+        presentPrograms[present] = program;
+    }
+    
+    // Debug: Print shader program IDs
+    std::cout << "Cube shader variants: " << cubeShaders.getVariantCount() << std::endl;
+    std::cout << "Pixelate program ID: " << pixelateProgram << std::endl;
     return true;
 }
 
+void FuzzyCubeApp::deletePrograms() {
+    cubeShaders.cleanup();
+    glDeleteProgram(pixelateProgram);
+    for (const auto& entry : presentPrograms) glDeleteProgram(entry.second);
+    presentPrograms.clear();
+}
+
+int FuzzyCubeApp::runShaderCacheBenchmark() {
+    std::cout << "[BENCH] Shader program startup: source compile vs binary cache" << std::endl;
+    if (!glfwInit()) {
+        std::cerr << "Failed to initialize GLFW" << std::endl;
+        return 1;
+    }
+    
+    struct Run { const char* name; bool useCache; bool clearFirst; };
+    const Run runs[] = {
+        {"cache off (source compile)", false, false},
+        {"cold cache (compile + store)", true, true},
+        {"warm cache (binary load)   ", true, false},
+    };
+    
+    float results[3] = {0.0f, 0.0f, 0.0f};
+    for (int r = 0; r < 3; r++) {
+        // Fresh context per run so nothing carries over inside the driver
+        GLFWwindow* window = createGLWindow(64, 64, "Shader cache benchmark", false, true);
+        if (!window) {
+            glfwTerminate();
+            return 1;
+        }
+        glewExperimental = GL_TRUE;
+        if (glewInit() != GLEW_OK) {
+            std::cerr << "Failed to initialize GLEW" << std::endl;
+            glfwTerminate();
+            return 1;
+        }
+        glGetError();
+        if (r == 0) {
+            std::cout << "[BENCH] Renderer: " << glGetString(GL_RENDERER) << " | Binary cache supported: "
+                      << (ShaderManager::isProgramCacheSupported() ? "yes" : "no") << std::endl;
+        }
+        if (runs[r].clearFirst) ShaderManager::clearProgramCache();
+        ShaderManager::setProgramCacheEnabled(runs[r].useCache);
+        ShaderManager::resetProgramCacheStats();
+        
+        // Time until every program has drawn once, so deferred backend compiles are included
+        FuzzyCubeApp probe;
+        probe.qualityTiers.load(QualityTierRegistry::kDefaultPath);
+        auto start = std::chrono::steady_clock::now();
+        bool created = probe.createPrograms();
+        GLuint emptyVAO;
+        glGenVertexArrays(1, &emptyVAO);
+        glBindVertexArray(emptyVAO);
+        std::vector<GLuint> programs = probe.cubeShaders.getPrograms();
+        programs.push_back(probe.pixelateProgram);
+        for (const auto& entry : probe.presentPrograms) programs.push_back(entry.second);
+        for (GLuint program : programs) {
+            glUseProgram(program);
+            glDrawArrays(GL_TRIANGLES, 0, 3);
+        }
+        glFinish();
+        results[r] = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        
+        std::cout << "[BENCH]   " << runs[r].name << ": " << results[r] << " ms ("
+                  << ShaderManager::getProgramCacheHits() << " hits, "
+                  << ShaderManager::getProgramCacheMisses() << " misses)" << std::endl;
+        glDeleteVertexArrays(1, &emptyVAO);
+        if (created) probe.deletePrograms();
+        glfwDestroyWindow(window);
+    }
+    glfwTerminate();
+    ShaderManager::setProgramCacheEnabled(true);
+    
+    if (ShaderManager::getProgramCacheHits() == 0) {
+        std::cout << "[BENCH] No binary was reused: the driver exposes no program binary formats" << std::endl;
+    } else if (results[2] > 0.0f) {
+        std::cout << "[BENCH] Warm cache is " << results[0] / results[2] << "x faster than compiling from source" << std::endl;
+    }
+    printDriverCacheNote();
+    return 0;
+}
+
 void FuzzyCubeApp::handleInput() {
     static bool mKeyWasPressed = false;
     
-    // Manual quality override with keyboard input (1=low, 2=medium, 3=high)
-    if (glfwGetKey(window, GLFW_KEY_1) == GLFW_PRESS) {
-        manualQuality = 0;
-    } else if (glfwGetKey(window, GLFW_KEY_2) == GLFW_PRESS) {
-        manualQuality = 1;
-    } else if (glfwGetKey(window, GLFW_KEY_3) == GLFW_PRESS) {
-        manualQuality = 2;
-    } else if (glfwGetKey(window, GLFW_KEY_0) == GLFW_PRESS) {
+    // Manual quality override with keyboard input (1 = the lowest tier ... N = the highest)
+    for (int tier = 0; tier < qualityTiers.size(); tier++) {
+        if (glfwGetKey(window, GLFW_KEY_1 + tier) == GLFW_PRESS) manualQuality = tier;
+    }
+    if (glfwGetKey(window, GLFW_KEY_0) == GLFW_PRESS) {
         manualQuality = -1;
     }
     
     // Toggle MSAA with M key
     if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS) {
         if (!mKeyWasPressed) {
+            // Switches the tiers' FBOs to their sample counts (GL_MULTISAMPLE stays enabled)
             msaaEnabled = !msaaEnabled;
-            if (msaaEnabled) glEnable(GL_MULTISAMPLE);
-            else glDisable(GL_MULTISAMPLE);
             std::cout << "[MSAA] " << (msaaEnabled ? "Enabled" : "Disabled") << std::endl;
             mKeyWasPressed = true;
         }
@@ -940,49 +1983,187 @@ void FuzzyCubeApp::handleInput() {
     }
 }
 
+void FuzzyCubeApp::rebuildInstanceField() {
+    std::vector<glm::mat4> transforms = CubeData::generateInstanceField(instanceCount, 1337u);
+    frustumCuller.setInstances(transforms, glm::vec3(-0.5f), glm::vec3(0.5f));
+    cubeRenderer.setInstanceCapacity(transforms.size());
+    gpuCuller.setInstances(frustumCuller.getBounds(), frustumCuller.getInstances());
+    builtInstanceCount = instanceCount;
+    std::cout << "[CULL] Built instance field with " << instanceCount << " cubes" << std::endl;
+}
+
+void FuzzyCubeApp::applyCubeUniforms(GLuint program, uint32_t features, const glm::mat4& model,
+                                     const glm::mat4& view, const glm::mat4& projection) {
+    glUseProgram(program);
+    
+    // Set common uniforms
+    glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(glGetUniformLocation(program, "view"), 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+    
+    // Set only the uniforms the variant's features read
+    if (features & (ShaderFeature::Diffuse | ShaderFeature::Specular)) {
+        // Once per object per frame instead of an inverse per vertex
+        glm::mat3 normalMatrix = InstanceTransforms::normalMatrix(model);
+        glUniformMatrix3fv(glGetUniformLocation(program, "normalMatrix"), 1, GL_FALSE, glm::value_ptr(normalMatrix));
+    }
+    if (!(features & ShaderFeature::VertexColors)) {
+        glUniform3fv(glGetUniformLocation(program, "objectColor"), 1, glm::value_ptr(glm::vec3(0.8f, 0.8f, 0.8f)));
+    }
+    if (features & (ShaderFeature::Diffuse | ShaderFeature::Specular)) {
+        glUniform3fv(glGetUniformLocation(program, "lightPos"), 1, glm::value_ptr(lightPos));
+        glUniform3fv(glGetUniformLocation(program, "lightColor"), 1, glm::value_ptr(glm::vec3(1.0f, 1.0f, 1.0f)));
+    }
+    if (features & ShaderFeature::Specular) {
+        glUniform3fv(glGetUniformLocation(program, "viewPos"), 1, glm::value_ptr(glm::vec3(0.0f, 0.0f, cameraDistance)));
+    }
+    if (features & ShaderFeature::Shadows) {
+        glUniformMatrix4fv(glGetUniformLocation(program, "lightSpaceMatrix"), 1, GL_FALSE,
+                           glm::value_ptr(shadowMap.getLightSpaceMatrix()));
+        glUniform1i(glGetUniformLocation(program, "shadowMap"), kShadowTextureUnit);
+        glUniform1i(glGetUniformLocation(program, "pcfRadius"), shadowPcfRadius);
+    }
+    if (features & ShaderFeature::MotionVectors) {
+        glUniformMatrix4fv(glGetUniformLocation(program, "previousModel"), 1, GL_FALSE, glm::value_ptr(previousModel));
+        glUniformMatrix4fv(glGetUniformLocation(program, "unjitteredViewProjection"), 1, GL_FALSE,
+                           glm::value_ptr(unjitteredViewProjection));
+        glUniformMatrix4fv(glGetUniformLocation(program, "previousViewProjection"), 1, GL_FALSE,
+                           glm::value_ptr(previousViewProjection));
+    }
+}
+
 void FuzzyCubeApp::render() {
     // Start ImGui frame
     ImGui_ImplOpenGL3_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
     
-    // Get quality for UI display
-    int quality = pythonManager.getQuality(cpuLoad, temp, gpuLoad, vramUsage);
-    if (manualQuality >= 0) {
-        quality = manualQuality;
-    }
+    // Get quality for UI display (in vector mode, the solved vector's scale tier). Switching
+    // modes in the UI below takes effect next frame, so quality and settings always agree.
+    bool vectorMode = qualityVectorMode;
+    int quality = selectQuality();
     
     // Render ImGui UI first
     ImGuiManager::renderUI(cpuLoad, temp, gpuLoad, vramUsage, 
                           cameraDistance, rotationX, rotationY, 
-                          quality, manualQuality >= 0);
-    
-    // Get quality settings
-    QualitySettings settings = QualitySettings::getSettings(quality, cubeSimpleProgram, 
-                                                          cubeMediumProgram, cubeHighProgram, 
-                                                          cubeRenderer.getSimpleVAO(), 
-                                                          cubeRenderer.getFullVAO());
+                          qualityTiers, quality, manualQuality >= 0);
+    bool gpuCullingActive = gpuCulling && gpuCuller.isSupported();
+    ImGuiManager::renderSceneUI(instancedScene, instanceCount, cullAVX2, gpuCulling, gpuCuller.isSupported(),
+                                frustumCuller.getLastVisibleCount(),
+                                gpuCullingActive ? gpuSubmitTimeMs : frustumCuller.getLastCullTimeMs());
+    ImGuiManager::renderMeshUI(meshScene, lodSelectionMode, lodPixelError, currentLOD, meshChain);
+    // The single-object view keeps the cube until the loader has handed the LOD chain over
+    bool meshView = meshScene && meshChain.isUploaded();
+    if (ImGuiManager::renderQualityVectorUI(qualityVectorMode, budgetMode, qualityBudget, qualityVector,
+                                            qualitySolver.getRenderScale(qualityVector.scaleTier),
+                                            qualitySolver.estimateFrameMs(qualityVector),
+                                            qualitySolver.score(qualityVector, targetFps),
+                                            frameQueue.getLastGpuFrameMs(), costsCalibrated)) {
+        calibrationRequested = true;
+    }
+    float sceneMs = renderGraph.getPassMs("Scene");
+    ImGuiManager::renderMsaaUI(msaaEnabled, qualityTiers, framebufferManager.getMaxSamples(), sceneMs,
+                               renderGraph.getPassMs("MSAA Resolve"));
+    ImGuiManager::renderShadowUI(shadowsEnabled, qualityTiers, shadowMap.getSize(), renderGraph.getPassMs("Shadow"));
+    ImGuiManager::renderPresentUI(presentMode, upscaleSharpness,
+                                  renderGraph.getPassMs("Upscale") + renderGraph.getPassMs("Sharpen"),
+                                  qualityTiers, renderGraph.getPassMs("Temporal Resolve"), checkerboardRendering,
+                                  renderGraph.getPassMs("Checkerboard Resolve"), sceneMs);
+    ImGuiManager::renderGraphUI(renderGraph);  // The previous frame's graph
+    ImGuiManager::renderLoaderUI(resourceLoader, sampleTexture);
+    
+    // Get quality settings: the tier's preset, or the solved vector drawn into its scale tier
+    const QualityTier& tier = qualityTiers[quality];
+    QualitySettings settings = vectorMode
+        ? QualitySettings::fromVector(qualityVector, qualityTiers, cubeShaders, cubeRenderer.getSimpleVAO(),
+                                      cubeRenderer.getFullVAO())
+        : QualitySettings::getSettings(tier, cubeShaders,
+                                       cubeRenderer.getSimpleVAO(), 
+                                       cubeRenderer.getFullVAO());
+    
+    // Temporal tiers draw with the motion-vector variant and a jittered projection;
+    // checkerboard tiers need the motion vectors to reproject their missing half
+    bool temporal = vectorMode ? (qualityVector.effects & QualityEffect::TemporalUpsample) != 0
+                               : tier.temporal;
+    bool spatialUpscale = vectorMode ? (qualityVector.effects & QualityEffect::SpatialUpscale) != 0
+                                     : presentMode == (int)PresentMode::SpatialUpscale;
+    bool checkerboard = settings.checkerboard && checkerboardRendering && !temporal;
+    bool motionVectors = temporal || checkerboard;
+    // Shadows fall on the ground plane of the single-object views only
+    bool tierShadows = (settings.shaderFeatures & ShaderFeature::Shadows) != 0;
+    bool shadows = tierShadows && shadowsEnabled && !instancedScene;
+    if (!shadows) {
+        settings.shaderFeatures &= ~ShaderFeature::Shadows;
+    }
+    // Post effects: the solved vector's, or the tier's that still fit the controller's budget
+    uint32_t postEffects = 0;
+    if (postEnabled) {
+        postEffects = vectorMode ? qualityVector.effects & QualityEffect::kPost : stripPostEffects(tier);
+    }
+    ImGuiManager::renderPostUI(postEnabled, qualityTiers, postChain, postEffects, renderGraph);
+    if (motionVectors) {
+        settings.shaderFeatures |= ShaderFeature::MotionVectors;
+    }
+    settings.cubeProgram = cubeShaders.get(settings.shaderFeatures);
+    if (!temporal) temporalUpsampler.invalidateHistory();
+    if (!checkerboard) checkerboardRenderer.invalidateHistory();
+    
+    // Frame pacing: the tier's FPS cap is one more knob the controller turns
+    ImGuiManager::renderPacingUI(targetFps, swapMode, framePacer.isAdaptiveSupported(), controllerFpsCap,
+                                 framePacer.getEffectiveFps(), framePacer.getAverageFrameMs(),
+                                 framePacer.getJitterMs(), framePacer.getWorstFrameMs(),
+                                 renderOnDemand, idleWakeRate, idleWakes, framesInFlight,
+                                 frameQueue.getLastFenceWaitMs(), frameQueue.getLastGpuFrameMs());
+    framePacer.setTargetFps(targetFps);
+    framePacer.setControllerCap(controllerFpsCap ? settings.fpsCap : 0.0f);
+    if (swapMode != (int)framePacer.getSwapMode()) {
+        framePacer.setSwapMode((FramePacer::SwapMode)swapMode);
+    }
     
     // Debug: Print current settings (only if verbose)
     if (g_verbose) {
-        std::cout << "Quality: " << quality << " | Resolution: " << settings.renderWidth << "x" << settings.renderHeight 
+        std::cout << "Quality: " << quality << " (" << tier.name << ") | Resolution: " << settings.renderWidth << "x" << settings.renderHeight 
                   << " | Indices: " << settings.indexCount << " | PixelSize: " << settings.pixelSize;
         if (manualQuality >= 0) {
             std::cout << " (MANUAL)";
         }
+        if (vectorMode) {
+            std::cout << " | Vector: " << qualitySolver.toString(qualityVector);
+        }
         std::cout << std::endl;
     }
     
-    // GPU timer start (if enabled)
-    if (enableGPUTimers) {
-        glQueryCounter(queryIDs[0], GL_TIMESTAMP);
+    // Frame capture controls
+    if (ImGuiManager::renderCaptureUI(captureFormat, captureSource, qualityTiers, frameCapture.isActive(),
+                                      frameCapture.getCapturedFrames(), frameCapture.getEncodedFrames(),
+                                      frameCapture.getDroppedFrames())) {
+        if (frameCapture.isActive()) {
+            frameCapture.stop();
+        } else {
+            bool y4m = captureFormat == (int)FrameCapture::Format::Y4M;
+            frameCapture.start(y4m ? "captures/capture.y4m" : "captures/frames", (FrameCapture::Format)captureFormat,
+                               captureSource, targetFps > 0.0f ? (int)targetFps : 60);
+        }
     }
     
-    // First pass: Render cube to pre-allocated FBO for this quality level
-    framebufferManager.bind(quality);
-    glViewport(0, 0, framebufferManager.getWidth(quality), framebufferManager.getHeight(quality));
-    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    // Claim this frame's slot: blocks only if the GPU is still 'framesInFlight' frames behind
+    frameQueue.setDepth(framesInFlight);
+    frameQueue.beginFrame();
+    
+    // Model matrix with rotation
+    glm::mat4 model = glm::mat4(1.0f);
+    model = glm::rotate(model, glm::radians(rotationX), glm::vec3(1.0f, 0.0f, 0.0f));
+    model = glm::rotate(model, glm::radians(rotationY), glm::vec3(0.0f, 1.0f, 0.0f));
+    
+    // LOD from the tier, or from the geometric error projected at this tier's resolution
+    if (meshView) {
+        if (lodSelectionMode == 0) {
+            currentLOD = settings.meshLOD;
+        } else {
+            currentLOD = meshChain.selectLOD(cameraDistance, glm::radians(45.0f), settings.renderHeight, lodPixelError);
+        }
+        currentLOD = std::min(currentLOD, meshChain.getLODCount() - 1);
+    }
     
     // Set up view and projection matrices
     glm::mat4 view = glm::lookAt(
@@ -993,114 +2174,984 @@ void FuzzyCubeApp::render() {
     
     glm::mat4 projection = glm::perspective(glm::radians(45.0f), (float)settings.renderWidth / (float)settings.renderHeight, 0.1f, 100.0f);
     
-    // Model matrix with rotation
-    glm::mat4 model = glm::mat4(1.0f);
-    model = glm::rotate(model, glm::radians(rotationX), glm::vec3(1.0f, 0.0f, 0.0f));
-    model = glm::rotate(model, glm::radians(rotationY), glm::vec3(0.0f, 1.0f, 0.0f));
+    // Motion vectors compare unjittered matrices; the jitter only moves the rasterized samples
+    unjitteredViewProjection = projection * view;
+    if (!hasPreviousFrame) {
+        previousModel = model;
+        previousViewProjection = unjitteredViewProjection;
+    }
+    glm::vec2 jitter(0.0f);
+    if (temporal) {
+        jitter = temporalUpsampler.nextJitter();
+        projection = TemporalUpsampler::jitterProjection(projection, jitter, settings.renderWidth, settings.renderHeight);
+    }
     
-    // Update UBOs with matrices (reduces per-program uniform uploads)
-    glBindBuffer(GL_UNIFORM_BUFFER, matricesUBO);
-    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(model));
-    glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(view));
-    glBufferSubData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(projection));
+    // The tier's pre-allocated FBO (the multisampled one while MSAA is on)
+    int samples = vectorMode || msaaEnabled ? settings.msaaSamples : 0;
+    if (framebufferManager.setSamples(quality, samples)) {
+        checkerboardRenderer.invalidateMask();
+    }
+    int renderWidth = framebufferManager.getWidth(quality);
+    int renderHeight = framebufferManager.getHeight(quality);
+    GLuint presentTexture = framebufferManager.getTexture(quality);  // The checkerboard resolve replaces it
+    
+    // Declare the frame's passes in execution order with the targets they read and write
+    renderGraph.reset();
+    // The window, or the offscreen target standing in for it when headless
+    RenderGraph::Resource backbuffer = renderGraph.importTarget("Backbuffer", offscreenTexture, offscreenFramebuffer);
+    renderGraph.markOutput(backbuffer);
+    RenderGraph::Resource tierColor = renderGraph.importTarget("Tier Color", framebufferManager.getTexture(quality),
+                                                              framebufferManager.getResolvedFramebuffer(quality));
+    RenderGraph::Resource sceneTarget = samples > 0
+        ? renderGraph.importTarget("Tier MSAA", 0, framebufferManager.getFramebuffer(quality))
+        : tierColor;
+    RenderGraph::Resource presentSource = tierColor;
+    // With post effects the present pass draws a full-resolution image for the chain, whose
+    // last pass draws the window
+    RenderGraph::Resource presented = postEffects != 0
+        ? renderGraph.createTarget("Presented", postChain.getTargetDesc())
+        : backbuffer;
+    auto bindPresentTarget = [&]() {
+        framebufferManager.unbind();
+        glBindFramebuffer(GL_FRAMEBUFFER, renderGraph.getFramebuffer(presented));
+        glViewport(0, 0, 1200, 800);  // Always render final output at full screen resolution
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    };
     
-    // Render cube with quality-appropriate shader and geometry
-    glUseProgram(settings.cubeProgram);
+    // Shadow pass: the object's depth from the light at the tier's map size. Declared for
+    // every shadowed tier; the graph culls it when the scene does not sample the map.
+    RenderGraph::Resource shadowTarget = RenderGraph::kNone;
+    if (tierShadows) {
+        shadowTarget = renderGraph.importTarget("Shadow Map", 0, 0);
+        renderGraph.addPass("Shadow", {}, {shadowTarget}, [&]() {
+            shadowMap.resize(settings.shadowMapSize);
+            float radius = meshView ? meshChain.getBoundingRadius() : 0.87f;  // Cube: half its diagonal
+            GLuint depthProgram = shadowMap.begin(lightPos, radius);
+            glUniformMatrix4fv(glGetUniformLocation(depthProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
+            if (meshView) {
+                meshChain.draw(depthProgram, currentLOD);
+            } else if (settings.simpleGeometry) {
+                cubeRenderer.renderSimpleCube(depthProgram);
+            } else {
+                cubeRenderer.renderCube(depthProgram, settings.indexCount);
+            }
+            shadowMap.end();
+            shadowMap.bindTexture(kShadowTextureUnit);
+            shadowPcfRadius = settings.shadowPCF;
+        });
+    }
     
-    // Set common uniforms
-    glUniformMatrix4fv(glGetUniformLocation(settings.cubeProgram, "model"), 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(glGetUniformLocation(settings.cubeProgram, "view"), 1, GL_FALSE, glm::value_ptr(view));
-    glUniformMatrix4fv(glGetUniformLocation(settings.cubeProgram, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
-    
-    // Set lighting uniforms only for medium and high quality
-    if (quality >= 1) {
-        glm::vec3 lightPos = glm::vec3(-2.0f, 3.0f, 2.0f);
-        glUniform3fv(glGetUniformLocation(settings.cubeProgram, "lightPos"), 1, glm::value_ptr(lightPos));
-        glUniform3fv(glGetUniformLocation(settings.cubeProgram, "lightColor"), 1, glm::value_ptr(glm::vec3(1.0f, 1.0f, 1.0f)));
+    // Scene pass: the cube, mesh or instanced field into the tier's FBO
+    renderGraph.addPass("Scene", {shadows ? shadowTarget : RenderGraph::kNone}, {sceneTarget}, [&]() {
+        framebufferManager.bind(quality);
+        framebufferManager.setVelocityOutput(motionVectors);
+        glViewport(0, 0, renderWidth, renderHeight);
+        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);  // Stencil keeps the checkerboard pattern
+        if (motionVectors) {
+            const GLfloat zeroVelocity[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+            glClearBufferfv(GL_COLOR, 1, zeroVelocity);
+        }
+        if (checkerboard) {
+            checkerboardRenderer.resize(renderWidth, renderHeight);
+            checkerboardRenderer.beginFrame(framebufferManager.getFramebuffer(quality), cubeRenderer);
+        }
+        if (settings.wireframe) {
+            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        }
+        
+        // Update UBOs with matrices (reduces per-program uniform uploads); this frame's ring range
+        if (glm::mat4* matrices = (glm::mat4*)matricesRing.map(frameQueue.getSlot())) {
+            matrices[0] = model;
+            matrices[1] = view;
+            matrices[2] = projection;
+            matricesRing.unmap();
+        }
+        
+        if (instancedScene) {
+            if (builtInstanceCount != instanceCount) {
+                rebuildInstanceField();
+            }
+            uint32_t instancedFeatures = settings.shaderFeatures | ShaderFeature::Instanced;
+            GLuint program = cubeShaders.get(instancedFeatures);
+            applyCubeUniforms(program, instancedFeatures, model, view, projection);
+            
+            // Cull in scene space: folding the scene rotation into the clip matrix keeps the
+            // instance bounds static, so they never need re-transforming on the CPU
+            Frustum frustum = Frustum::fromMatrix(unjitteredViewProjection * model);
+            
+            if (gpuCulling && gpuCuller.isSupported()) {
+                // GPU path: CPU cost is one dispatch + one indirect draw regardless of instance count
+                auto submitStart = std::chrono::steady_clock::now();
+                gpuCuller.cull(frustum, settings.indexCount);
+                applyCubeUniforms(program, instancedFeatures, model, view, projection);
+                gpuCuller.draw(program, settings.simpleGeometry ? gpuSimpleCubeVAO : gpuCubeVAO);
+                gpuSubmitTimeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - submitStart).count();
+            } else {
+                frustumCuller.setUseAVX2(cullAVX2);
+                InstanceData* instanceData = cubeRenderer.mapInstanceBuffer();
+                int visibleCount = instanceData ? (int)frustumCuller.cull(frustum, instanceData) : 0;
+                cubeRenderer.unmapInstanceBuffer();
+                
+                if (settings.simpleGeometry) {
+                    cubeRenderer.renderSimpleCubeInstanced(program, visibleCount);
+                } else {
+                    cubeRenderer.renderCubeInstanced(program, settings.indexCount, visibleCount);
+                }
+            }
+        } else if (meshView) {
+            applyCubeUniforms(settings.cubeProgram, settings.shaderFeatures, model, view, projection);
+            meshChain.draw(settings.cubeProgram, currentLOD);
+        } else {
+            // Render cube with quality-appropriate shader and geometry
+            applyCubeUniforms(settings.cubeProgram, settings.shaderFeatures, model, view, projection);
+            
+            // Render cube with appropriate geometry
+            if (settings.simpleGeometry) {
+                cubeRenderer.renderSimpleCube(settings.cubeProgram);
+            } else {
+                cubeRenderer.renderCube(settings.cubeProgram, settings.indexCount);
+            }
+        }
+        if (!instancedScene) {
+            // Ground plane in world space: no scene rotation, so nothing moves between frames
+            const glm::mat4 identity(1.0f);
+            applyCubeUniforms(settings.cubeProgram, settings.shaderFeatures, identity, view, projection);
+            if (motionVectors) {
+                glUniformMatrix4fv(glGetUniformLocation(settings.cubeProgram, "previousModel"), 1, GL_FALSE,
+                                   glm::value_ptr(identity));
+            }
+            cubeRenderer.renderGroundPlane(settings.cubeProgram);
+        }
         
-        // High quality gets additional uniforms
-        if (quality == 2) {
-            glUniform3fv(glGetUniformLocation(settings.cubeProgram, "viewPos"), 1, glm::value_ptr(glm::vec3(0.0f, 0.0f, cameraDistance)));
-            glUniform3fv(glGetUniformLocation(settings.cubeProgram, "ambientColor"), 1, glm::value_ptr(glm::vec3(0.3f, 0.3f, 0.3f)));
+        if (settings.wireframe) {
+            glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
         }
+        if (checkerboard) {
+            checkerboardRenderer.endFrame();
+        }
+    });
+    
+    if (samples > 0) {
+        renderGraph.addPass("MSAA Resolve", {sceneTarget}, {tierColor}, [&]() {
+            framebufferManager.resolve(quality, motionVectors);
+        });
+    }
+    if (checkerboard) {
+        RenderGraph::Resource checkerboardColor = renderGraph.importTarget("Checkerboard Color", 0, 0);
+        renderGraph.addPass("Checkerboard Resolve", {tierColor}, {checkerboardColor}, [&]() {
+            presentTexture = checkerboardRenderer.resolve(presentTexture, framebufferManager.getVelocityTexture(quality),
+                                                          cubeRenderer);
+        });
+        presentSource = checkerboardColor;
     }
     
-    // Render cube with appropriate geometry
-    if (quality == 0) {
-        cubeRenderer.renderSimpleCube(settings.cubeProgram);
+    // Present: one of the full-resolution reconstructions into the window
+    if (temporal) {
+        // Accumulate this frame's jittered samples into the full-resolution history
+        renderGraph.addPass("Temporal Resolve", {tierColor}, {presented}, [&]() {
+            bindPresentTarget();
+            temporalUpsampler.resolve(framebufferManager.getTexture(quality), framebufferManager.getVelocityTexture(quality),
+                                      renderWidth, renderHeight, jitter, renderGraph.getFramebuffer(presented),
+                                      cubeRenderer);
+        });
+    } else if (spatialUpscale) {
+        // Reconstruct detail from the low-res FBO instead of snapping it to a grid; the
+        // upscaled image only lives until the sharpening pass has read it
+        RenderGraph::Resource sharpenSource = presentSource;
+        if (spatialUpscaler.needsUpscale(renderWidth, renderHeight)) {
+            RenderGraph::Resource upscaled = renderGraph.createTarget("Upscaled", spatialUpscaler.getTargetDesc());
+            renderGraph.addPass("Upscale", {presentSource}, {upscaled}, [&, upscaled]() {
+                glBindFramebuffer(GL_FRAMEBUFFER, renderGraph.getFramebuffer(upscaled));
+                spatialUpscaler.upscale(presentTexture, renderWidth, renderHeight, cubeRenderer);
+            });
+            sharpenSource = upscaled;
+        }
+        renderGraph.addPass("Sharpen", {sharpenSource}, {presented}, [&, sharpenSource]() {
+            GLuint source = sharpenSource == presentSource ? presentTexture : renderGraph.getTexture(sharpenSource);
+            bindPresentTarget();
+            spatialUpscaler.sharpen(source, upscaleSharpness, cubeRenderer);
+        });
     } else {
-        cubeRenderer.renderCube(settings.cubeProgram, settings.indexCount);
+        renderGraph.addPass("Present", {presentSource}, {presented}, [&]() {
+            bindPresentTarget();
+            // Disable depth testing for quad rendering
+            glDisable(GL_DEPTH_TEST);
+            
+            // The tier's present shader: pixelate, or one of shaders/ over screen.vert
+            auto custom = presentPrograms.find(tier.present);
+            GLuint presentProgram = custom != presentPrograms.end() ? custom->second : pixelateProgram;
+            glUseProgram(presentProgram);
+            
+            // Bind the framebuffer texture for the current quality level
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, presentTexture);
+            glUniform1i(glGetUniformLocation(presentProgram, "screenTexture"), 0);
+            glUniform1i(glGetUniformLocation(presentProgram, "ourTexture"), 0);  // low/medium/high.frag
+            
+            // Set pixelation uniform
+            glUniform1f(glGetUniformLocation(presentProgram, "pixelSize"), settings.pixelSize);
+            
+            // Render fullscreen quad
+            cubeRenderer.renderScreenQuad();
+            
+            // Re-enable depth testing
+            glEnable(GL_DEPTH_TEST);
+        });
+    }
+    postChain.declare(renderGraph, postEffects, presented, backbuffer, cubeRenderer);
+    
+    // Capture before the UI is drawn over the presented frame
+    if (frameCapture.isActive()) {
+        int source = frameCapture.getSource();
+        if (source == FrameCapture::kPresented) {
+            renderGraph.addPass("Capture", {backbuffer}, {}, [&]() {
+                frameCapture.capture(renderGraph.getFramebuffer(backbuffer), 1200, 800, frameQueue.getFrameIndex());
+            }, true);
+        } else if (source == quality) {
+            renderGraph.addPass("Capture", {tierColor}, {}, [&]() {
+                frameCapture.capture(framebufferManager.getResolvedFramebuffer(quality), renderWidth, renderHeight,
+                                     frameQueue.getFrameIndex());
+            }, true);
+        }
     }
     
-    // Second pass: Render fullscreen quad with pixelation shader
-    framebufferManager.unbind();
-    glViewport(0, 0, 1200, 800);  // Always render final output at full screen resolution
-    glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-    glClear(GL_COLOR_BUFFER_BIT);
-    
-    // Disable depth testing for quad rendering
-    glDisable(GL_DEPTH_TEST);
-    
-    glUseProgram(pixelateProgram);
-    
-    // Bind the framebuffer texture for the current quality level
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, framebufferManager.getTexture(quality));
-    glUniform1i(glGetUniformLocation(pixelateProgram, "screenTexture"), 0);
-    
-    // Set pixelation uniform
-    glUniform1f(glGetUniformLocation(pixelateProgram, "pixelSize"), settings.pixelSize);
+    // Render ImGui
+    ImGui::Render();
+    if (drawUI) {
+        renderGraph.addPass("UI", {backbuffer}, {backbuffer}, [&]() {
+            glBindFramebuffer(GL_FRAMEBUFFER, renderGraph.getFramebuffer(backbuffer));
+            ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+        });
+    }
     
-    // Render fullscreen quad
-    cubeRenderer.renderScreenQuad();
+    renderGraph.compile();
+    renderGraph.execute(frameQueue.getSlot());
     
-    // Re-enable depth testing
-    glEnable(GL_DEPTH_TEST);
+    previousModel = model;
+    previousViewProjection = unjitteredViewProjection;
+    hasPreviousFrame = true;
     
-    // Render ImGui
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-    
-    // GPU timer end and report (if enabled)
-    if (enableGPUTimers) {
-        glQueryCounter(queryIDs[1], GL_TIMESTAMP);
-        GLuint64 startTime, endTime;
-        glGetQueryObjectui64v(queryIDs[0], GL_QUERY_RESULT, &startTime);
-        glGetQueryObjectui64v(queryIDs[1], GL_QUERY_RESULT, &endTime);
-        float gpuTimeMs = (endTime - startTime) / 1000000.0f;
-        if (g_verbose) {
-            std::cout << "[GPU] Frame time: " << gpuTimeMs << " ms" << std::endl;
+    // GPU frame time of the last retired slot (no stall on this frame's queries)
+    if (g_verbose) {
+        std::cout << "[GPU] Frame time: " << frameQueue.getLastGpuFrameMs() << " ms";
+        if (temporal) {
+            std::cout << " (temporal resolve " << renderGraph.getPassMs("Temporal Resolve") << " ms)";
+        }
+        std::cout << std::endl;
+    }
+}
+
+int FuzzyCubeApp::selectQuality() {
+    if (qualityVectorMode) {
+        updateQualityVector();
+        return qualityVector.scaleTier;
+    }
+    if (manualQuality >= 0) {
+        int quality = qualityTiers.clamp(manualQuality);
+        qualityBudget = qualityTiers[quality].budget;
+        return quality;
+    }
+    // The controller's budget picks the tier that stands for the nearest one
+    qualityBudget = controllerBudget;
+    return qualityTiers.selectForBudget(qualityBudget);
+}
+
+void FuzzyCubeApp::sampleControllerBudget() {
+    // The manual override never reads it
+    if (manualQuality >= 0) return;
+    controllerBudget = pythonManager.getBudget(cpuLoad, temp, gpuLoad, vramUsage);
+}
+
+uint32_t FuzzyCubeApp::stripPostEffects(const QualityTier& tier) const {
+    // Budgets are fractions of the most expensive vector's frame time, so a budget below the
+    // tier's is a shortfall in ms; the costliest effects go first until it is covered
+    const QualityCostTable& costs = qualitySolver.getCostTable();
+    float shortfallMs = (tier.budget - qualityBudget) * qualitySolver.estimateFrameMs(qualitySolver.maximum());
+    uint32_t effects = tier.postEffects;
+    while (shortfallMs > 0.0f && effects != 0) {
+        int costliest = -1;
+        for (int bit = QualityEffect::kFirstPost; bit < QualityEffect::kCount; bit++) {
+            if ((effects & (1u << bit)) && (costliest < 0 || costs.effectMs[bit] > costs.effectMs[costliest])) {
+                costliest = bit;
+            }
         }
+        effects &= ~(1u << costliest);
+        shortfallMs -= costs.effectMs[costliest];
     }
+    return effects;
+}
+
+void FuzzyCubeApp::updateQualityVector() {
+    if (qualityVectorPinned) return;
+    qualityBudget = manualQuality >= 0 ? qualityTiers[qualityTiers.clamp(manualQuality)].budget
+                                       : controllerBudget;
+    if (qualityVectorSolved && qualityBudget == solvedBudget && budgetMode == solvedBudgetMode &&
+        targetFps == solvedTargetFps) {
+        return;
+    }
+    
+    QualityVector solved = qualitySolver.solve((BudgetMode)budgetMode, qualityBudget, targetFps);
+    if (!qualityVectorSolved || solved != qualityVector) {
+        std::cout << "[QUALITY] Budget " << qualityBudget << " -> " << qualitySolver.toString(solved)
+                  << " (" << qualitySolver.estimateFrameMs(solved) << " ms est.)" << std::endl;
+    }
+    qualityVector = solved;
+    qualityVectorSolved = true;
+    solvedBudget = qualityBudget;
+    solvedBudgetMode = budgetMode;
+    solvedTargetFps = targetFps;
+}
+
+bool FuzzyCubeApp::RedrawState::operator!=(const RedrawState& other) const {
+    return quality != other.quality || budget != other.budget || cpuLoad != other.cpuLoad || temp != other.temp ||
+           gpuLoad != other.gpuLoad || vramUsage != other.vramUsage ||
+           cameraDistance != other.cameraDistance || rotationX != other.rotationX || rotationY != other.rotationY;
+}
+
+FuzzyCubeApp::RedrawState FuzzyCubeApp::captureRedrawState() {
+    RedrawState state;
+    state.quality = selectQuality();
+    state.budget = qualityBudget;
+    state.cpuLoad = cpuLoad;
+    state.temp = temp;
+    state.gpuLoad = gpuLoad;
+    state.vramUsage = vramUsage;
+    state.cameraDistance = cameraDistance;
+    state.rotationX = rotationX;
+    state.rotationY = rotationY;
+    return state;
+}
+
+void FuzzyCubeApp::markInputPending(GLFWwindow* window) {
+    static_cast<FuzzyCubeApp*>(glfwGetWindowUserPointer(window))->inputPending = true;
+}
+
+void FuzzyCubeApp::installInputCallbacks() {
+    // Any event that can change what ImGui or the scene shows marks the next frame as needed.
+    // Installed before ImGui_ImplGlfw_InitForOpenGL, whose callbacks chain to these.
+    glfwSetWindowUserPointer(window, this);
+    glfwSetCursorPosCallback(window, [](GLFWwindow* w, double, double) { markInputPending(w); });
+    glfwSetMouseButtonCallback(window, [](GLFWwindow* w, int, int, int) { markInputPending(w); });
+    glfwSetScrollCallback(window, [](GLFWwindow* w, double, double) { markInputPending(w); });
+    glfwSetKeyCallback(window, [](GLFWwindow* w, int, int, int, int) { markInputPending(w); });
+    glfwSetCharCallback(window, [](GLFWwindow* w, unsigned int) { markInputPending(w); });
+    glfwSetWindowFocusCallback(window, [](GLFWwindow* w, int) { markInputPending(w); });
+    glfwSetWindowRefreshCallback(window, [](GLFWwindow* w) { markInputPending(w); });
 }
 
 void FuzzyCubeApp::run() {
+    // After a change, keep drawing long enough for ImGui hover state to settle and for the
+    // temporal and checkerboard history to converge on the static image
+    const int kSettleFrames = 2 * (int)TemporalUpsampler::kJitterPhases;
+    
     while (!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
+        bool idle = renderOnDemand && settleFrames == 0;
+        if (idle) {
+            glfwWaitEventsTimeout(1.0 / std::max(idleWakeRate, 0.1f));
+        } else {
+            glfwPollEvents();
+        }
         
+        if (calibrationRequested) {
+            calibrationRequested = false;
+            calibrateQualityCosts();
+            framePacer.resetSchedule();
+        }
+        
+        // Frame boundary: swap in any shaders rebuilt and hand over any resources loaded
+        // since the last frame
+        bool changed = shaderReloader.update() > 0;
+        changed = resourceLoader.update() > 0 || changed || inputPending;
+        inputPending = false;
+        if (!loadReported && resourceLoader.isIdle()) {
+            loadReported = true;
+            float loadMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+            std::cout << "[LOADER] " << resourceLoader.getFinishedCount() << " resources loaded in " << (int)loadMs
+                      << " ms (" << ResourceLoader::getModeName(resourceLoader.getMode()) << "), "
+                      << frameQueue.getFrameIndex() << " frames drawn meanwhile" << std::endl;
+        }
+        if (prewarmPending && resourceLoader.isIdle()) {
+            prewarmPending = false;
+            float warmupMs = prewarmPipelines();
+            std::cout << "[WARMUP] " << enumeratePipelineStates().size() << " pipeline states drawn in "
+                      << (int)warmupMs << " ms" << std::endl;
+            framePacer.resetSchedule();
+        }
         handleInput();
+        sampleControllerBudget();  // After input, which may switch back to the controller
+        
+        if (renderOnDemand) {
+            // Controller update: re-evaluate the quality and compare with the last drawn state
+            if (idle) {
+                RedrawState state = captureRedrawState();
+                changed = changed || state != lastRedrawState;
+                lastRedrawState = state;
+            }
+            if (changed) {
+                if (idle) framePacer.resetSchedule();
+                settleFrames = kSettleFrames;
+            }
+            if (settleFrames == 0) {
+                idleWakes++;
+                continue;
+            }
+            settleFrames--;
+        }
         render();
         
         glfwSwapBuffers(window);
+        frameQueue.endFrame();
+        framePacer.waitForNextFrame();
+        if (renderOnDemand && settleFrames == 0) {
+            lastRedrawState = captureRedrawState();  // Includes edits made through the UI
+        }
     }
 }
 
+bool FuzzyCubeApp::calibrateQualityCosts() {
+    const char* renderer = (const char*)glGetString(GL_RENDERER);
+    if (!renderer) return false;
+    resourceLoader.waitIdle();  // The mesh LOD costs need the real chain, not the stand-in cube
+    std::cout << "[CALIBRATE] Measuring quality knob costs on " << renderer << "..." << std::endl;
+    auto calibrationStart = std::chrono::steady_clock::now();
+    
+    // Everything the bursts change is restored when this returns
+    RenderStateGuard savedState(*this);
+    
+    // The golden-test view of the single object, unpaced, without the UI
+    qualityVectorMode = true;
+    qualityVectorPinned = true;
+    instancedScene = false;
+    checkerboardRendering = true;
+    postEnabled = true;
+    drawUI = false;
+    controllerFpsCap = false;
+    lodSelectionMode = 0;
+    swapMode = (int)FramePacer::SwapMode::Off;
+    rotationX = 30.0f;
+    rotationY = 45.0f;
+    cameraDistance = 3.0f;
+    
+    // One burst: warm-up frames absorb first-use work and the timers' readback lag, then the
+    // GPU timers are averaged over the measured frames
+    struct Burst { float sceneMs, resolveMs, effectMs, frameMs; };
+    const int kWarmupFrames = 4, kMeasuredFrames = 8;
+    auto measure = [&](int scaleTier, int samples, ShadingModel shading, int meshLOD, uint32_t effects, bool mesh) {
+        qualityVector = {scaleTier, samples, shading, meshLOD, 0.0f, effects};
+        meshScene = mesh;
+        hasPreviousFrame = false;
+        Burst burst = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (int frame = 0; frame < kWarmupFrames + kMeasuredFrames; frame++) {
+            render();
+            glfwSwapBuffers(window);
+            frameQueue.endFrame();
+            glFinish();  // Every query is available when the next frame's graph collects it
+            if (frame < kWarmupFrames) continue;
+            burst.sceneMs += renderGraph.getPassMs("Scene");
+            burst.resolveMs += renderGraph.getPassMs("MSAA Resolve");
+            burst.frameMs += frameQueue.getLastGpuFrameMs();
+            if (effects & QualityEffect::SpatialUpscale) {
+                burst.effectMs += renderGraph.getPassMs("Upscale") + renderGraph.getPassMs("Sharpen");
+            } else if (effects & QualityEffect::TemporalUpsample) {
+                burst.effectMs += renderGraph.getPassMs("Temporal Resolve");
+            } else if (effects & QualityEffect::Checkerboard) {
+                burst.effectMs += renderGraph.getPassMs("Checkerboard Resolve");
+            }
+            burst.effectMs += PostChain::getEffectMs(renderGraph, effects);
+        }
+        burst.sceneMs /= kMeasuredFrames;
+        burst.resolveMs /= kMeasuredFrames;
+        burst.effectMs /= kMeasuredFrames;
+        burst.frameMs /= kMeasuredFrames;
+        if (g_verbose) {
+            std::cout << "[CALIBRATE]   " << qualitySolver.toString(qualityVector) << (mesh ? " (mesh)" : "")
+                      << ": scene " << burst.sceneMs << " | resolve " << burst.resolveMs << " | effect "
+                      << burst.effectMs << " | frame " << burst.frameMs << " ms" << std::endl;
+        }
+        return burst;
+    };
+    // One burst set per scale tier (the quality tiers' render scales)
+    int scaleTiers = qualitySolver.getScaleTierCount();
+    int fullTier = qualitySolver.maximum().scaleTier;
+    int lowTier = qualitySolver.minimum().scaleTier;
+    std::vector<float> pixelFraction(scaleTiers);
+    for (int tier = 0; tier < scaleTiers; tier++) {
+        pixelFraction[tier] = qualitySolver.getRenderScale(tier) * qualitySolver.getRenderScale(tier);
+    }
+    
+    QualityCostTable table;
+    bool valid = true;
+    
+    // Shading: the scene pass of each model at every scale. A least-squares line over the
+    // pixel fraction gives the full-resolution cost; its intercept (work that does not scale
+    // with resolution) joins the base cost with the clear and present passes.
+    std::vector<Burst> plain[3];
+    float fixedMs = 0.0f;
+    for (int shading = 0; shading < 3; shading++) {
+        for (int tier = 0; tier < scaleTiers; tier++) {
+            plain[shading].push_back(measure(tier, 0, (ShadingModel)shading, 0, 0, false));
+        }
+        float meanP = 0.0f, meanMs = 0.0f;
+        for (int tier = 0; tier < scaleTiers; tier++) {
+            meanP += pixelFraction[tier] / scaleTiers;
+            meanMs += plain[shading][tier].sceneMs / scaleTiers;
+        }
+        float covariance = 0.0f, variance = 0.0f;
+        for (int tier = 0; tier < scaleTiers; tier++) {
+            covariance += (pixelFraction[tier] - meanP) * (plain[shading][tier].sceneMs - meanMs);
+            variance += (pixelFraction[tier] - meanP) * (pixelFraction[tier] - meanP);
+        }
+        // A single scale cannot separate the two: everything is then per-pixel
+        float slope = variance > 0.0f ? covariance / variance : meanMs / meanP;
+        table.shadingMs[shading] = std::max(slope, 0.0f);
+        fixedMs += std::max(meanMs - slope * meanP, 0.0f) / 3.0f;
+        valid = valid && plain[shading][fullTier].sceneMs > 0.0f;
+    }
+    float overheadMs = 0.0f;
+    for (int shading = 0; shading < 3; shading++) {
+        for (const Burst& burst : plain[shading]) {
+            overheadMs += std::max(burst.frameMs - burst.sceneMs - burst.resolveMs, 0.0f) / (3.0f * scaleTiers);
+        }
+    }
+    table.baseMs = overheadMs + fixedMs;
+    
+    // MSAA: extra scene + resolve time over the single-sampled Phong pass, fitted through
+    // the origin (no samples, no extra cost)
+    const std::vector<Burst>& phong = plain[(int)ShadingModel::Phong];
+    for (int index = 1; index < 3; index++) {
+        int samples = 2 * index;
+        if (samples > framebufferManager.getMaxSamples()) break;  // The solver never picks it
+        float weighted = 0.0f, squares = 0.0f;
+        for (int tier = 0; tier < scaleTiers; tier++) {
+            Burst burst = measure(tier, samples, ShadingModel::Phong, 0, 0, false);
+            float extraMs = burst.sceneMs + burst.resolveMs - phong[tier].sceneMs - phong[tier].resolveMs;
+            weighted += pixelFraction[tier] * extraMs;
+            squares += pixelFraction[tier] * pixelFraction[tier];
+        }
+        table.msaaMs[index] = std::max(weighted / squares, table.msaaMs[index - 1]);
+    }
+    
+    // Mesh LOD: the LOD mesh's scene pass over the cube's, unlit at full scale
+    for (int lod = 0; lod < 4; lod++) {
+        Burst burst = measure(fullTier, 0, ShadingModel::Unlit, lod, 0, true);
+        table.meshLodMs[lod] = std::max(burst.sceneMs - plain[(int)ShadingModel::Unlit][fullTier].sceneMs, 0.0f);
+    }
+    
+    // Effects (post effects included) run at the output resolution, so the low scale measures
+    // them as well as any; a full-scale checkerboard pass gives the fraction of shading it
+    // still pays
+    for (int bit = 0; bit < QualityEffect::kCount; bit++) {
+        table.effectMs[bit] = measure(lowTier, 0, ShadingModel::Phong, 0, 1u << bit, false).effectMs;
+    }
+    Burst checkerboard = measure(fullTier, 0, ShadingModel::Phong, 0, QualityEffect::Checkerboard, false);
+    if (phong[fullTier].sceneMs > 0.0f) {
+        table.checkerboardShadingScale = std::max(0.1f, std::min(1.0f, checkerboard.sceneMs / phong[fullTier].sceneMs));
+    }
+    
+    qualityVectorSolved = false;  // Re-solve with the new costs
+    
+    float elapsedMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - calibrationStart).count();
+    if (!valid) {
+        std::cerr << "[CALIBRATE] GPU timer queries returned no data; keeping the current knob costs" << std::endl;
+        return false;
+    }
+    qualitySolver.setCostTable(table);
+    costsCalibrated = true;
+    bool saved = table.save(QualitySolver::kCostTablePath, renderer);
+    std::cout << "[CALIBRATE] Done in " << (int)elapsedMs << " ms"
+              << (saved ? std::string(", saved to ") + QualitySolver::kCostTablePath : std::string(", not saved"))
+              << std::endl;
+    std::ostringstream printed;
+    table.print(printed);
+    std::istringstream lines(printed.str());
+    for (std::string line; std::getline(lines, line);) {
+        std::cout << "[CALIBRATE]   " << line << std::endl;
+    }
+    return true;
+}
+
+std::vector<FuzzyCubeApp::PipelineState> FuzzyCubeApp::enumeratePipelineStates() const {
+    // Grouped so consecutive states mostly differ in the tier alone, like controller switches
+    std::vector<PipelineState> states;
+    for (int scene = 0; scene < 3; scene++) {
+        for (bool msaa : {false, true}) {
+            for (int tier = 0; tier < qualityTiers.size(); tier++) {
+                if (msaa && qualityTiers[tier].msaaSamples == 0) continue;
+                states.push_back({tier, scene, msaa, false, false, -1});
+            }
+        }
+    }
+    for (int tier = 0; tier < qualityTiers.size(); tier++) {
+        states.push_back({tier, 0, false, true, false, -1});
+    }
+    for (int tier = 0; tier < qualityTiers.size(); tier++) {
+        if (qualityTiers[tier].renderScale < 1.0f) states.push_back({tier, 0, false, false, true, -1});
+    }
+    for (int shading = 0; shading < 3; shading++) {
+        for (int tier = 0; tier < qualityTiers.size(); tier++) {
+            states.push_back({tier, 0, false, false, false, shading});
+        }
+    }
+    return states;
+}
+
+void FuzzyCubeApp::applyPipelineState(const PipelineState& state) {
+    manualQuality = state.tier;
+    meshScene = state.scene == 1;
+    instancedScene = state.scene == 2;
+    msaaEnabled = state.msaa;
+    presentMode = (int)(state.spatialUpscale ? PresentMode::SpatialUpscale : PresentMode::Pixelate);
+    for (int tier = 0; tier < qualityTiers.size(); tier++) {
+        qualityTiers[tier].temporal = state.temporal && tier == state.tier;
+    }
+    qualityVectorMode = state.vectorShading >= 0;
+    qualityVectorPinned = qualityVectorMode;
+    if (qualityVectorMode) {
+        qualityVector = {state.tier, 0, (ShadingModel)state.vectorShading, 0, 0.0f, 0};
+    }
+}
+
+std::string FuzzyCubeApp::describePipelineState(const PipelineState& state) const {
+    static const char* const kScenes[3] = {"cube", "mesh", "instanced"};
+    static const char* const kShadingNames[3] = {"unlit", "lambert", "phong"};
+    std::string text = qualityTiers[state.tier].name + " " + kScenes[state.scene];
+    if (state.msaa) text += " +msaa";
+    if (state.spatialUpscale) text += " +upscale";
+    if (state.temporal) text += " +temporal";
+    if (state.vectorShading >= 0) text += std::string(" vector:") + kShadingNames[state.vectorShading];
+    return text;
+}
+
+// RenderStateGuard implementation
+FuzzyCubeApp::RenderStateGuard::RenderStateGuard(FuzzyCubeApp& app)
+    : app(app), manualQuality(app.manualQuality), lodSelectionMode(app.lodSelectionMode), swapMode(app.swapMode),
+      presentMode(app.presentMode), meshScene(app.meshScene), instancedScene(app.instancedScene),
+      msaaEnabled(app.msaaEnabled), checkerboardRendering(app.checkerboardRendering), postEnabled(app.postEnabled),
+      qualityVectorMode(app.qualityVectorMode), drawUI(app.drawUI), controllerFpsCap(app.controllerFpsCap),
+      rotationX(app.rotationX), rotationY(app.rotationY), cameraDistance(app.cameraDistance),
+      qualityVector(app.qualityVector), checkerboardFrame(app.checkerboardRenderer.getFrameIndex()) {
+    for (int tier = 0; tier < app.qualityTiers.size(); tier++) temporal.push_back(app.qualityTiers[tier].temporal);
+}
+
+FuzzyCubeApp::RenderStateGuard::~RenderStateGuard() {
+    app.manualQuality = manualQuality;
+    app.lodSelectionMode = lodSelectionMode;
+    app.swapMode = swapMode;
+    app.presentMode = presentMode;
+    app.meshScene = meshScene;
+    app.instancedScene = instancedScene;
+    app.msaaEnabled = msaaEnabled;
+    app.checkerboardRendering = checkerboardRendering;
+    app.postEnabled = postEnabled;
+    app.qualityVectorMode = qualityVectorMode;
+    app.qualityVectorPinned = false;
+    app.qualityVector = qualityVector;
+    app.drawUI = drawUI;
+    app.controllerFpsCap = controllerFpsCap;
+    app.rotationX = rotationX;
+    app.rotationY = rotationY;
+    app.cameraDistance = cameraDistance;
+    for (int tier = 0; tier < app.qualityTiers.size(); tier++) app.qualityTiers[tier].temporal = temporal[tier];
+    app.hasPreviousFrame = false;
+    app.temporalUpsampler.invalidateHistory();
+    app.checkerboardRenderer.invalidateHistory();
+    app.checkerboardRenderer.setFrameIndex(checkerboardFrame);
+}
+
+float FuzzyCubeApp::prewarmPipelines() {
+    auto warmupStart = std::chrono::steady_clock::now();
+    
+    {
+        // Everything the states change is restored at the end of this block
+        RenderStateGuard savedState(*this);
+        
+        // Into the back buffer without swapping, so nothing reaches the screen
+        drawUI = false;
+        for (const PipelineState& state : enumeratePipelineStates()) {
+            applyPipelineState(state);
+            hasPreviousFrame = false;
+            render();
+            frameQueue.endFrame();
+        }
+        frameQueue.waitIdle();  // Every slot's fence: the driver has finished all the warm-up work
+    }
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - warmupStart).count();
+}
+
+int FuzzyCubeApp::runTierSwitchBenchmark() {
+    const char* renderer = (const char*)glGetString(GL_RENDERER);
+    std::cout << "[BENCH] Tier switch spikes on " << (renderer ? renderer : "unknown renderer") << std::endl;
+    resourceLoader.waitIdle();
+    drawUI = false;
+    framePacer.setTargetFps(0.0f);
+    controllerFpsCap = false;
+    rotationX = 30.0f;
+    rotationY = 45.0f;
+    
+    // The frame that switches is compared with the median of the frames after it. glFinish
+    // puts the GPU side of the switch (deferred compiles, first FBO use) in the frame's time.
+    const int kFramesPerState = 6;
+    struct Pass { float worstSpikeMs, meanSpikeMs, worstFrameMs; std::string worstState; };
+    auto measurePass = [&]() {
+        Pass pass = {0.0f, 0.0f, 0.0f, ""};
+        std::vector<PipelineState> states = enumeratePipelineStates();
+        for (const PipelineState& state : states) {
+            applyPipelineState(state);
+            hasPreviousFrame = false;
+            std::vector<float> frameMs;
+            for (int frame = 0; frame < kFramesPerState; frame++) {
+                auto start = std::chrono::steady_clock::now();
+                render();
+                glfwSwapBuffers(window);
+                frameQueue.endFrame();
+                glFinish();
+                frameMs.push_back(std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count());
+            }
+            std::vector<float> steady(frameMs.begin() + 1, frameMs.end());
+            std::nth_element(steady.begin(), steady.begin() + steady.size() / 2, steady.end());
+            float spikeMs = std::max(frameMs[0] - steady[steady.size() / 2], 0.0f);
+            if (g_verbose) {
+                std::cout << "[BENCH]     " << describePipelineState(state) << ": switch " << frameMs[0]
+                          << " ms | steady " << steady[steady.size() / 2] << " ms" << std::endl;
+            }
+            pass.meanSpikeMs += spikeMs / states.size();
+            pass.worstFrameMs = std::max(pass.worstFrameMs, frameMs[0]);
+            if (spikeMs >= pass.worstSpikeMs) {
+                pass.worstSpikeMs = spikeMs;
+                pass.worstState = describePipelineState(state);
+            }
+        }
+        return pass;
+    };
+    // Fresh programs, FBOs, post-process passes and instance field, so the second pass does
+    // not inherit the first one's warm driver state
+    auto recreatePipelines = [&]() {
+        frameQueue.waitIdle();
+        deletePrograms();
+        framebufferManager.cleanup();
+        spatialUpscaler.cleanup();
+        temporalUpsampler.cleanup();
+        checkerboardRenderer.cleanup();
+        shadowMap.cleanup();
+        postChain.cleanup();
+        renderGraph.cleanup();
+        int highest = qualityTiers.highest();
+        bool created = createPrograms() && framebufferManager.initialize(qualityTiers) &&
+                       spatialUpscaler.initialize(1200, 800) && temporalUpsampler.initialize(1200, 800) &&
+                       checkerboardRenderer.initialize(qualityTiers[highest].renderWidth(),
+                                                       qualityTiers[highest].renderHeight()) &&
+                       shadowMap.initialize(1024) && postChain.initialize(1200, 800);
+        builtInstanceCount = 0;
+        return created;
+    };
+    
+    std::cout << "[BENCH] " << enumeratePipelineStates().size() << " forced transitions, " << kFramesPerState
+              << " frames each" << std::endl;
+    Pass cold = measurePass();
+    if (!recreatePipelines()) return 1;
+    float warmupMs = prewarmPipelines();
+    Pass warm = measurePass();
+    
+    auto report = [](const char* name, const Pass& pass) {
+        std::cout << "[BENCH]   " << name << ": worst spike " << pass.worstSpikeMs << " ms (" << pass.worstState
+                  << ") | mean spike " << pass.meanSpikeMs << " ms | worst switch frame " << pass.worstFrameMs
+                  << " ms" << std::endl;
+    };
+    report("no warm-up   ", cold);
+    report("after warm-up", warm);
+    std::cout << "[BENCH] Warm-up took " << warmupMs << " ms at startup" << std::endl;
+    if (warm.worstSpikeMs > 0.0f) {
+        std::cout << "[BENCH] Worst spike is " << cold.worstSpikeMs / warm.worstSpikeMs << "x smaller with warm-up"
+                  << std::endl;
+    }
+    printDriverCacheNote();
+    return 0;
+}
+
+int FuzzyCubeApp::runGoldenTests(const std::string& directory, bool update) {
+    // Fixed camera/quality/scene combinations covering the paths performance work touches.
+    // Frame counts are even so checkerboard parity is the same on every run, and long
+    // enough for the temporal history to converge.
+    struct Scenario {
+        const char* name;
+        const char* tier;  // Quality tier by name, so the tests survive tiers being added
+        int scene;  // 0 = cube, 1 = LOD mesh, 2 = instanced field
+        float rotationX, rotationY, distance;
+        PresentMode present;
+        bool temporal;
+        bool msaa;  // Tier sample counts from the presets
+        bool vector;  // Solved quality vector at the tier's budget (power budget, 60 FPS target)
+        int frames;
+    };
+    const Scenario scenarios[] = {
+        {"cube_ultra_low",   "Ultra Low", 0, 30.0f,  45.0f,  3.0f, PresentMode::Pixelate,       false, false, false, 4},
+        {"cube_low",         "Low",       0, 30.0f,  45.0f,  3.0f, PresentMode::Pixelate,       false, false, false, 4},
+        {"cube_medium",      "Medium",    0, 30.0f,  45.0f,  3.0f, PresentMode::Pixelate,       false, false, false, 4},
+        {"cube_high",        "High",      0, 30.0f,  45.0f,  3.0f, PresentMode::Pixelate,       false, false, false, 4},
+        {"cube_high_close",  "High",      0, -20.0f, 110.0f, 2.0f, PresentMode::Pixelate,       false, false, false, 4},
+        {"mesh_low",         "Low",       1, 25.0f,  -35.0f, 3.0f, PresentMode::Pixelate,       false, false, false, 4},
+        {"mesh_high",        "High",      1, 25.0f,  -35.0f, 3.0f, PresentMode::Pixelate,       false, false, false, 4},
+        {"instanced_medium", "Medium",    2, 10.0f,  20.0f,  3.0f, PresentMode::Pixelate,       false, false, false, 4},
+        {"instanced_high",   "High",      2, 10.0f,  20.0f,  3.0f, PresentMode::Pixelate,       false, false, false, 4},
+        {"upscale_low",      "Low",       0, 30.0f,  45.0f,  3.0f, PresentMode::SpatialUpscale, false, false, false, 4},
+        {"msaa_medium",      "Medium",    0, 30.0f,  45.0f,  3.0f, PresentMode::Pixelate,       false, true,  false, 4},
+        {"msaa_high",        "High",      0, 30.0f,  45.0f,  3.0f, PresentMode::Pixelate,       false, true,  false, 4},
+        {"vector_low",       "Low",       0, 30.0f,  45.0f,  3.0f, PresentMode::Pixelate,       false, false, true,  4},
+        {"vector_medium",    "Medium",    0, 30.0f,  45.0f,  3.0f, PresentMode::Pixelate,       false, false, true,  4},
+        {"temporal_low",     "Low",       0, 30.0f,  45.0f,  3.0f, PresentMode::Pixelate,       true,  false, false, 24},
+    };
+    // Pass criteria: per-channel tolerance for driver rounding, then structural similarity
+    const int kThreshold = 8;
+    const double kMaxDifferingFraction = 0.001;
+    const double kMinSSIM = 0.98;
+
+    if (update) {
+        std::error_code error;
+        std::filesystem::create_directories(directory, error);
+    }
+    drawUI = false;
+    framePacer.setTargetFps(0.0f);
+    controllerFpsCap = false;
+    qualitySolver.setCostTable(QualityCostTable());  // Solved scenarios must not depend on the GPU
+    bool useAVX2 = ImageDiff::cpuSupportsAVX2();
+    std::cout << "[GOLDEN] " << (update ? "Recording" : "Comparing") << " " << sizeof(scenarios) / sizeof(scenarios[0])
+              << " scenarios in " << directory << " | diff: " << (useAVX2 ? "AVX2" : "scalar") << ", "
+              << threadPool->getThreadCount() << " threads" << std::endl;
+
+    resourceLoader.waitIdle();  // Mesh scenarios must draw the real chain, not the stand-in cube
+    int failures = 0;
+    std::vector<uint8_t> actual(1200 * 800 * 4);
+    for (const Scenario& scenario : scenarios) {
+        manualQuality = qualityTiers.find(scenario.tier);
+        if (manualQuality < 0) {
+            std::cout << "[GOLDEN] " << std::left << std::setw(18) << scenario.name << "FAIL  no quality tier named "
+                      << scenario.tier << " in " << tiersPath << std::endl;
+            failures++;
+            continue;
+        }
+        meshScene = scenario.scene == 1;
+        instancedScene = scenario.scene == 2;
+        rotationX = scenario.rotationX;
+        rotationY = scenario.rotationY;
+        cameraDistance = scenario.distance;
+        presentMode = (int)scenario.present;
+        msaaEnabled = scenario.msaa;
+        qualityVectorMode = scenario.vector;
+        budgetMode = (int)BudgetMode::Power;
+        targetFps = 60.0f;
+        for (int tier = 0; tier < qualityTiers.size(); tier++) {
+            qualityTiers[tier].temporal = scenario.temporal && tier == manualQuality;
+        }
+        hasPreviousFrame = false;
+
+        // Time the second half of the frames (the first ones build fields and warm up)
+        float renderMs = 0.0f;
+        for (int frame = 0; frame < scenario.frames; frame++) {
+            auto start = std::chrono::steady_clock::now();
+            render();
+            if (frame == scenario.frames - 1) {
+                glBindFramebuffer(GL_READ_FRAMEBUFFER, offscreenFramebuffer);
+                glReadBuffer(offscreenFramebuffer ? GL_COLOR_ATTACHMENT0 : GL_BACK);
+                glPixelStorei(GL_PACK_ALIGNMENT, 4);
+                glReadPixels(0, 0, 1200, 800, GL_RGBA, GL_UNSIGNED_BYTE, actual.data());
+            }
+            glfwSwapBuffers(window);
+            frameQueue.endFrame();
+            glFinish();
+            if (frame >= scenario.frames / 2) {
+                renderMs += std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+            }
+        }
+        renderMs /= scenario.frames - scenario.frames / 2;
+
+        // Readbacks are bottom-up; goldens are stored top-down
+        std::vector<uint8_t> flipped(actual.size());
+        for (int y = 0; y < 800; y++) {
+            std::memcpy(&flipped[(size_t)y * 1200 * 4], &actual[(size_t)(799 - y) * 1200 * 4], 1200 * 4);
+        }
+        std::string goldenPath = (std::filesystem::path(directory) / (std::string(scenario.name) + ".png")).string();
+        std::vector<uint8_t> golden;
+        int goldenWidth = 0, goldenHeight = 0;
+        if (update) {
+            // Store RGB only; alpha is not part of the comparison
+            std::vector<uint8_t> rgb(1200 * 800 * 3);
+            for (size_t p = 0; p < (size_t)1200 * 800; p++) std::memcpy(&rgb[p * 3], &flipped[p * 4], 3);
+            bool written = ImageIO::writePNG(goldenPath, 1200, 800, 3, rgb.data(), false, 6);
+            std::cout << "[GOLDEN] " << std::left << std::setw(18) << scenario.name
+                      << (written ? "RECORDED" : "WRITE FAILED") << "  render " << std::fixed << std::setprecision(2)
+                      << renderMs << " ms/frame" << std::endl;
+            std::cout.unsetf(std::ios::fixed);
+            if (!written) failures++;
+            continue;
+        }
+        // A missing recording is a failure, never recorded here: otherwise a fresh checkout (or
+        // a deleted golden) would pass without comparing anything
+        if (!ImageIO::readPNG(goldenPath, goldenWidth, goldenHeight, golden)) {
+            std::cout << "[GOLDEN] " << std::left << std::setw(18) << scenario.name << "MISSING  no readable "
+                      << goldenPath << "; record it with --golden-update" << std::endl;
+            failures++;
+            continue;
+        }
+        if (goldenWidth != 1200 || goldenHeight != 800) {
+            std::cout << "[GOLDEN] " << std::left << std::setw(18) << scenario.name << "FAIL  golden is "
+                      << goldenWidth << "x" << goldenHeight << std::endl;
+            failures++;
+            continue;
+        }
+
+        auto diffStart = std::chrono::steady_clock::now();
+        ImageDiffResult diff = ImageDiff::compare(flipped.data(), golden.data(), 1200, 800, kThreshold,
+                                                  threadPool.get(), useAVX2);
+        float diffMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - diffStart).count();
+        bool pass = diff.differingFraction() <= kMaxDifferingFraction && diff.ssim >= kMinSSIM;
+        std::cout << "[GOLDEN] " << std::left << std::setw(18) << scenario.name << (pass ? "PASS" : "FAIL")
+                  << std::fixed << std::setprecision(5) << "  ssim " << diff.ssim << std::setprecision(3)
+                  << "  mae " << diff.meanAbsError << "  max " << diff.maxError << "  differing "
+                  << diff.differingPixels << std::setprecision(2) << "  render " << renderMs << " ms/frame"
+                  << "  diff " << diffMs << " ms" << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        if (!pass) {
+            // Keep the failing frame next to its golden for inspection
+            std::string actualPath = (std::filesystem::path(directory) / (std::string(scenario.name) + ".actual.png")).string();
+            ImageIO::writePNG(actualPath, 1200, 800, 4, flipped.data(), false);
+            failures++;
+        }
+    }
+    std::cout << "[GOLDEN] " << failures << " failure(s)" << std::endl;
+    drawUI = true;
+    return failures;
+}
+
 void FuzzyCubeApp::cleanup() {
+    resourceLoader.stop();  // Hands over anything still loading so it is released below
     pythonManager.cleanup();
     cubeRenderer.cleanup();
+    meshChain.cleanup();
     framebufferManager.cleanup();
+    spatialUpscaler.cleanup();
+    temporalUpsampler.cleanup();
+    checkerboardRenderer.cleanup();
+    shadowMap.cleanup();
+    postChain.cleanup();
+    renderGraph.cleanup();
     ImGuiManager::shutdown();
     
-    glDeleteProgram(cubeSimpleProgram);
-    glDeleteProgram(cubeMediumProgram);
-    glDeleteProgram(cubeHighProgram);
-    glDeleteProgram(pixelateProgram);
+    shaderReloader.stop();
+    deletePrograms();
+    threadPool.reset();
+    cubeRenderer.destroyInstancedVAO(gpuCubeVAO);
+    cubeRenderer.destroyInstancedVAO(gpuSimpleCubeVAO);
+    gpuCuller.cleanup();
     
-    glDeleteBuffers(1, &matricesUBO);
+    frameCapture.stop();
+    frameQueue.cleanup();
+    matricesRing.cleanup();
     glDeleteBuffers(1, &lightingUBO);
-    if (GLEW_ARB_timer_query || GLEW_VERSION_3_3) {
-        glDeleteQueries(2, queryIDs);
-    }
+    glDeleteTextures(1, &sampleTexture);
+    glDeleteFramebuffers(1, &offscreenFramebuffer);
+    glDeleteTextures(1, &offscreenTexture);
     
     glfwTerminate();
 }
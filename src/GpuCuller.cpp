@@ -0,0 +1,203 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/GpuCuller.h"
+#include "../include/HeadlessContext.h"
+#include <algorithm>
+#include <chrono>
+#include <iterator>
+
+// GpuCuller implementation
+bool GpuCuller::isContextCapable() {
+    return GLEW_VERSION_4_3 ||
+           (GLEW_ARB_compute_shader && GLEW_ARB_shader_storage_buffer_object && GLEW_ARB_multi_draw_indirect);
+}
+
+bool GpuCuller::initialize() {
+    if (!isContextCapable()) {
+        std::cout << "[GPU CULL] Compute shaders / indirect draws unavailable on this context, "
+                  << "using the CPU culler" << std::endl;
+        supported = false;
+        return false;
+    }
+
+    cullProgram = ShaderManager::createComputeProgram("shaders/cull_instances.comp");
+    planesLocation = glGetUniformLocation(cullProgram, "frustumPlanes");
+    instanceCountLocation = glGetUniformLocation(cullProgram, "instanceCount");
+
+    glGenBuffers(1, &boundsSSBO);
+    glGenBuffers(1, &sourceTransformsSSBO);
+    glGenBuffers(1, &visibleTransformsBuffer);
+    glGenBuffers(1, &visibleIdsSSBO);
+    glGenBuffers(1, &indirectBuffer);
+
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    DrawElementsIndirectCommand command = {0, 0, 0, 0, 0};
+    glBufferData(GL_DRAW_INDIRECT_BUFFER, sizeof(command), &command, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    checkGLError("GPU culler initialization");
+    supported = true;
+    std::cout << "[GPU CULL] Compute culling + glMultiDrawElementsIndirect available" << std::endl;
+    return true;
+}
+
+void GpuCuller::setInstances(const InstanceBoundsSoA& bounds, const std::vector<InstanceData>& instances) {
+    if (!supported) return;
+    instanceCount = instances.size();
+
+    // The shader wants AoS (std430 struct of three vec4s per instance)
+    std::vector<glm::vec4> packedBounds(instanceCount * 3);
+    for (size_t i = 0; i < instanceCount; i++) {
+        packedBounds[i * 3 + 0] = glm::vec4(bounds.centerX[i], bounds.centerY[i], bounds.centerZ[i], bounds.radius[i]);
+        packedBounds[i * 3 + 1] = glm::vec4(bounds.minX[i], bounds.minY[i], bounds.minZ[i], 0.0f);
+        packedBounds[i * 3 + 2] = glm::vec4(bounds.maxX[i], bounds.maxY[i], bounds.maxZ[i], 0.0f);
+    }
+
+    size_t boundsSize = std::max<size_t>(1, packedBounds.size()) * sizeof(glm::vec4);
+    size_t transformSize = std::max<size_t>(1, instanceCount) * sizeof(InstanceData);
+    size_t idSize = std::max<size_t>(1, instanceCount) * sizeof(GLuint);
+
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, boundsSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, boundsSize, packedBounds.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, sourceTransformsSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, transformSize, instances.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, visibleTransformsBuffer);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, transformSize, nullptr, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, visibleIdsSSBO);
+    glBufferData(GL_SHADER_STORAGE_BUFFER, idSize, nullptr, GL_DYNAMIC_COPY);
+    glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+
+    checkGLError("GPU culler instance upload");
+}
+
+void GpuCuller::cull(const Frustum& frustum, GLuint indexCount) {
+    if (!supported) return;
+
+    // Reset the command; the shader accumulates instanceCount with atomics
+    DrawElementsIndirectCommand command = {indexCount, 0, 0, 0, 0};
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(command), &command);
+
+    glUseProgram(cullProgram);
+    glUniform4fv(planesLocation, 6, &frustum.planes[0][0]);
+    glUniform1ui(instanceCountLocation, (GLuint)instanceCount);
+
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, boundsSSBO);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, sourceTransformsSSBO);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, visibleTransformsBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, indirectBuffer);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, visibleIdsSSBO);
+
+    GLuint groups = (GLuint)((instanceCount + kWorkgroupSize - 1) / kWorkgroupSize);
+    if (groups > 0) {
+        glDispatchCompute(groups, 1, 1);
+    }
+
+    // Survivors are consumed as vertex attributes and the count as an indirect command
+    glMemoryBarrier(GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+    if (g_verbose) {
+        checkGLError("GPU cull dispatch");
+    }
+}
+
+void GpuCuller::draw(GLuint program, GLuint vao) {
+    if (!supported) return;
+    glUseProgram(program);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, 1, 0);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+    if (g_verbose) {
+        checkGLError("GPU culled indirect draw");
+    }
+}
+
+std::vector<GLuint> GpuCuller::readVisibleIds() {
+    std::vector<GLuint> ids;
+    if (!supported) return ids;
+
+    glMemoryBarrier(GL_BUFFER_UPDATE_BARRIER_BIT);
+    DrawElementsIndirectCommand command;
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirectBuffer);
+    glGetBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, sizeof(command), &command);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+
+    ids.resize(command.instanceCount);
+    if (!ids.empty()) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, visibleIdsSSBO);
+        glGetBufferSubData(GL_SHADER_STORAGE_BUFFER, 0, ids.size() * sizeof(GLuint), ids.data());
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+    return ids;
+}
+
+void GpuCuller::cleanup() {
+    if (cullProgram) glDeleteProgram(cullProgram);
+    GLuint buffers[] = {boundsSSBO, sourceTransformsSSBO, visibleTransformsBuffer, visibleIdsSSBO, indirectBuffer};
+    for (GLuint buffer : buffers) {
+        if (buffer) glDeleteBuffers(1, &buffer);
+    }
+    cullProgram = boundsSSBO = sourceTransformsSSBO = visibleTransformsBuffer = visibleIdsSSBO = indirectBuffer = 0;
+    supported = false;
+}
+
+int GpuCuller::runSelfTest(int instanceCount) {
+    std::cout << "[GPU CULL TEST] Comparing compute-shader culling against the CPU culler ("
+              << instanceCount << " instances)" << std::endl;
+
+    HeadlessContext context;
+    if (!context.create("GPU cull self-test", "[GPU CULL TEST]")) return 1;
+
+    GpuCuller gpuCuller;
+    if (!gpuCuller.initialize()) {
+        std::cout << "[GPU CULL TEST] SKIPPED: context lacks GL 4.3 compute/indirect support" << std::endl;
+        return 0;
+    }
+
+    std::vector<glm::mat4> transforms = CubeData::generateInstanceField(instanceCount, 1337u);
+    FrustumCuller cpuCuller;
+    cpuCuller.setInstances(transforms, glm::vec3(-0.5f), glm::vec3(0.5f));
+    gpuCuller.setInstances(cpuCuller.getBounds(), cpuCuller.getInstances());
+
+    std::vector<uint32_t> cpuIds(transforms.size());
+    int failures = 0;
+
+    // Orbit the camera around the field so every plane gets exercised
+    for (int step = 0; step < 8; step++) {
+        float yaw = step * 45.0f;
+        glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.5f, 0.1f, 100.0f);
+        glm::mat4 model = glm::rotate(glm::mat4(1.0f), glm::radians(yaw), glm::vec3(0.3f, 1.0f, 0.0f));
+        Frustum frustum = Frustum::fromMatrix(projection * view * model);
+
+        size_t cpuCount = FrustumCuller::cullRangeScalar(cpuCuller.getBounds(), frustum, 0, transforms.size(), cpuIds.data());
+        std::vector<uint32_t> expected(cpuIds.begin(), cpuIds.begin() + cpuCount);
+
+        auto start = std::chrono::steady_clock::now();
+        gpuCuller.cull(frustum, 36);
+        std::vector<GLuint> actual = gpuCuller.readVisibleIds();
+        float gpuMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+        std::sort(actual.begin(), actual.end());
+
+        // Allow a handful of boundary disagreements from differing float evaluation order
+        std::vector<uint32_t> difference;
+        std::set_symmetric_difference(expected.begin(), expected.end(), actual.begin(), actual.end(),
+                                      std::back_inserter(difference));
+        bool pass = difference.size() <= std::max<size_t>(2, expected.size() / 10000);
+        if (!pass) failures++;
+
+        std::cout << "[GPU CULL TEST] yaw " << yaw << ": CPU " << cpuCount << " visible, GPU "
+                  << actual.size() << " visible, " << difference.size() << " mismatches ("
+                  << gpuMs << " ms incl. readback) " << (pass ? "OK" : "FAIL") << std::endl;
+    }
+
+    gpuCuller.cleanup();
+    context.destroy();
+
+    if (failures) {
+        std::cerr << "[GPU CULL TEST] ❌ " << failures << " camera positions disagreed" << std::endl;
+        return 1;
+    }
+    std::cout << "[GPU CULL TEST] ✅ GPU culling matches the CPU culler" << std::endl;
+    return 0;
+}
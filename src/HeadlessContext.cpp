@@ -0,0 +1,68 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/HeadlessContext.h"
+#include <algorithm>
+
+// HeadlessContext implementation
+bool HeadlessContext::create(const char* title, const char* tag) {
+    if (!glfwInit()) {
+        std::cerr << "Failed to initialize GLFW" << std::endl;
+        return false;
+    }
+    window = createGLWindow(64, 64, title, false, true);
+    if (!window) {
+        glfwTerminate();
+        return false;
+    }
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK) {
+        std::cerr << "Failed to initialize GLEW" << std::endl;
+        destroy();
+        return false;
+    }
+    glGetError();
+    std::cout << tag << " Renderer: " << glGetString(GL_RENDERER) << " | Version: " << glGetString(GL_VERSION)
+              << std::endl;
+    return true;
+}
+
+void HeadlessContext::createTarget(int size) {
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glGenRenderbuffers(1, &colorBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, size, size);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBuffer);
+    glGenRenderbuffers(1, &depthBuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, size, size);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    glViewport(0, 0, size, size);
+    glEnable(GL_DEPTH_TEST);
+}
+
+double HeadlessContext::timeMedianMs(const std::function<void()>& draw, int warmupFrames, int frames) {
+    if (!query) glGenQueries(1, &query);
+    std::vector<double> frameMs;
+    for (int frame = 0; frame < warmupFrames + frames; frame++) {
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        draw();
+        glEndQuery(GL_TIME_ELAPSED);
+        GLuint64 elapsedNs = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &elapsedNs);
+        if (frame >= warmupFrames) frameMs.push_back(elapsedNs / 1.0e6);
+    }
+    std::sort(frameMs.begin(), frameMs.end());
+    return frameMs[frameMs.size() / 2];
+}
+
+void HeadlessContext::destroy() {
+    if (!window) return;
+    if (query) glDeleteQueries(1, &query);
+    if (colorBuffer) glDeleteRenderbuffers(1, &colorBuffer);
+    if (depthBuffer) glDeleteRenderbuffers(1, &depthBuffer);
+    if (framebuffer) glDeleteFramebuffers(1, &framebuffer);
+    query = colorBuffer = depthBuffer = framebuffer = 0;
+    glfwDestroyWindow(window);
+    window = nullptr;
+    glfwTerminate();
+}
@@ -0,0 +1,299 @@
+#include "../include/ImageDiff.h"
+#include "../include/ThreadPool.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cstdlib>
+#include <chrono>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define IMAGE_DIFF_X86 1
+#endif
+
+namespace {
+    const int kBlockSize = 8;
+    // SSIM stabilizers for 8-bit data: (0.01 * 255)^2 and (0.03 * 255)^2
+    const double kC1 = 6.5025, kC2 = 58.5225;
+
+    // Sums over one band of rows
+    struct BandStats {
+        uint64_t absErrorSum = 0;
+        int maxError = 0;
+        size_t differingPixels = 0;
+        double ssimSum = 0.0;
+        size_t ssimBlocks = 0;
+    };
+
+    inline int luma(const uint8_t* p) {
+        return (77 * p[0] + 150 * p[1] + 29 * p[2]) >> 8;
+    }
+
+    double blockSSIM(double sumX, double sumY, double sumXX, double sumYY, double sumXY) {
+        const double n = kBlockSize * kBlockSize;
+        double meanX = sumX / n, meanY = sumY / n;
+        double varX = sumXX / n - meanX * meanX;
+        double varY = sumYY / n - meanY * meanY;
+        double covXY = sumXY / n - meanX * meanY;
+        return ((2.0 * meanX * meanY + kC1) * (2.0 * covXY + kC2)) /
+               ((meanX * meanX + meanY * meanY + kC1) * (varX + varY + kC2));
+    }
+
+    void compareBandScalar(const uint8_t* a, const uint8_t* b, int width, int rowBegin, int rowEnd,
+                           int threshold, BandStats& stats) {
+        size_t stride = (size_t)width * 4;
+        for (int y = rowBegin; y < rowEnd; y++) {
+            const uint8_t* pa = a + stride * y;
+            const uint8_t* pb = b + stride * y;
+            for (int x = 0; x < width; x++, pa += 4, pb += 4) {
+                int pixelMax = 0;
+                for (int c = 0; c < 3; c++) {
+                    int error = std::abs(pa[c] - pb[c]);
+                    stats.absErrorSum += error;
+                    pixelMax = std::max(pixelMax, error);
+                }
+                stats.maxError = std::max(stats.maxError, pixelMax);
+                if (pixelMax > threshold) stats.differingPixels++;
+            }
+        }
+
+        // SSIM over the full 8x8 blocks of this band
+        if (rowEnd - rowBegin < kBlockSize) return;
+        for (int bx = 0; bx + kBlockSize <= width; bx += kBlockSize) {
+            double sumX = 0, sumY = 0, sumXX = 0, sumYY = 0, sumXY = 0;
+            for (int y = rowBegin; y < rowBegin + kBlockSize; y++) {
+                for (int x = bx; x < bx + kBlockSize; x++) {
+                    int lx = luma(a + stride * y + x * 4);
+                    int ly = luma(b + stride * y + x * 4);
+                    sumX += lx;
+                    sumY += ly;
+                    sumXX += lx * lx;
+                    sumYY += ly * ly;
+                    sumXY += lx * ly;
+                }
+            }
+            stats.ssimSum += blockSSIM(sumX, sumY, sumXX, sumYY, sumXY);
+            stats.ssimBlocks++;
+        }
+    }
+
+#ifdef IMAGE_DIFF_X86
+    __attribute__((target("avx2")))
+    inline __m256i lumaAVX2(__m256i pixels) {
+        const __m256i byteMask = _mm256_set1_epi32(0xFF);
+        __m256i r = _mm256_and_si256(pixels, byteMask);
+        __m256i g = _mm256_and_si256(_mm256_srli_epi32(pixels, 8), byteMask);
+        __m256i b = _mm256_and_si256(_mm256_srli_epi32(pixels, 16), byteMask);
+        __m256i sum = _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi32(r, _mm256_set1_epi32(77)),
+                                                        _mm256_mullo_epi32(g, _mm256_set1_epi32(150))),
+                                       _mm256_mullo_epi32(b, _mm256_set1_epi32(29)));
+        return _mm256_srli_epi32(sum, 8);
+    }
+
+    __attribute__((target("avx2")))
+    inline uint64_t horizontalSum(__m256i v) {
+        __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(1, 0, 3, 2)));
+        sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, _MM_SHUFFLE(2, 3, 0, 1)));
+        return (uint32_t)_mm_cvtsi128_si32(sum);
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    void compareBandAVX2(const uint8_t* a, const uint8_t* b, int width, int rowBegin, int rowEnd,
+                         int threshold, BandStats& stats) {
+        size_t stride = (size_t)width * 4;
+        const __m256i colorMask = _mm256_set1_epi32(0x00FFFFFF);  // Drop alpha
+        const __m256i limit = _mm256_set1_epi8((char)std::min(threshold + 1, 255));
+        const __m256i zero = _mm256_setzero_si256();
+        int vectorWidth = width & ~7;
+
+        __m256i maxVector = zero;
+        __m256i sadVector = zero;
+        for (int y = rowBegin; y < rowEnd; y++) {
+            const uint8_t* pa = a + stride * y;
+            const uint8_t* pb = b + stride * y;
+            for (int x = 0; x < vectorWidth; x += 8) {
+                __m256i va = _mm256_loadu_si256((const __m256i*)(pa + x * 4));
+                __m256i vb = _mm256_loadu_si256((const __m256i*)(pb + x * 4));
+                __m256i diff = _mm256_or_si256(_mm256_subs_epu8(va, vb), _mm256_subs_epu8(vb, va));
+                diff = _mm256_and_si256(diff, colorMask);
+                sadVector = _mm256_add_epi64(sadVector, _mm256_sad_epu8(diff, zero));
+                maxVector = _mm256_max_epu8(maxVector, diff);
+                // A byte reaches the limit when max(diff, limit) == diff; any such byte flags its pixel
+                __m256i over = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_max_epu8(diff, limit), diff), colorMask);
+                __m256i pixelOver = _mm256_cmpeq_epi32(over, zero);
+                stats.differingPixels += 8 - _mm_popcnt_u32((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(pixelOver)));
+            }
+            // Tail pixels
+            for (int x = vectorWidth; x < width; x++) {
+                int pixelMax = 0;
+                for (int c = 0; c < 3; c++) {
+                    int error = std::abs(pa[x * 4 + c] - pb[x * 4 + c]);
+                    stats.absErrorSum += error;
+                    pixelMax = std::max(pixelMax, error);
+                }
+                stats.maxError = std::max(stats.maxError, pixelMax);
+                if (pixelMax > threshold) stats.differingPixels++;
+            }
+        }
+        alignas(32) uint64_t sads[4];
+        _mm256_store_si256((__m256i*)sads, sadVector);
+        stats.absErrorSum += sads[0] + sads[1] + sads[2] + sads[3];
+        alignas(32) uint8_t maxBytes[32];
+        _mm256_store_si256((__m256i*)maxBytes, maxVector);
+        for (uint8_t value : maxBytes) stats.maxError = std::max(stats.maxError, (int)value);
+
+        // SSIM: one 8-pixel block row per load; the moments fit 32-bit lanes (64 * 255^2)
+        if (rowEnd - rowBegin < kBlockSize) return;
+        for (int bx = 0; bx + kBlockSize <= width; bx += kBlockSize) {
+            __m256i sumX = zero, sumY = zero, sumXX = zero, sumYY = zero, sumXY = zero;
+            for (int y = rowBegin; y < rowBegin + kBlockSize; y++) {
+                __m256i lx = lumaAVX2(_mm256_loadu_si256((const __m256i*)(a + stride * y + bx * 4)));
+                __m256i ly = lumaAVX2(_mm256_loadu_si256((const __m256i*)(b + stride * y + bx * 4)));
+                sumX = _mm256_add_epi32(sumX, lx);
+                sumY = _mm256_add_epi32(sumY, ly);
+                sumXX = _mm256_add_epi32(sumXX, _mm256_mullo_epi32(lx, lx));
+                sumYY = _mm256_add_epi32(sumYY, _mm256_mullo_epi32(ly, ly));
+                sumXY = _mm256_add_epi32(sumXY, _mm256_mullo_epi32(lx, ly));
+            }
+            stats.ssimSum += blockSSIM((double)horizontalSum(sumX), (double)horizontalSum(sumY),
+                                       (double)horizontalSum(sumXX), (double)horizontalSum(sumYY),
+                                       (double)horizontalSum(sumXY));
+            stats.ssimBlocks++;
+        }
+    }
+#endif
+}
+
+bool ImageDiff::cpuSupportsAVX2() {
+#ifdef IMAGE_DIFF_X86
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+#else
+    return false;
+#endif
+}
+
+ImageDiffResult ImageDiff::compare(const uint8_t* a, const uint8_t* b, int width, int height,
+                                   int threshold, ThreadPool* pool, bool useAVX2) {
+    threshold = std::max(0, std::min(threshold, 254));
+    auto compareBand = compareBandScalar;
+#ifdef IMAGE_DIFF_X86
+    if (useAVX2 && cpuSupportsAVX2()) compareBand = compareBandAVX2;
+#endif
+
+    BandStats total;
+    std::mutex totalMutex;
+    // Each range covers whole 8-row bands; the last band may be short (no SSIM blocks)
+    size_t bands = ((size_t)height + kBlockSize - 1) / kBlockSize;
+    auto body = [&](size_t begin, size_t end) {
+        BandStats stats;
+        for (size_t band = begin; band < end; band++) {
+            int rowBegin = (int)band * kBlockSize;
+            compareBand(a, b, width, rowBegin, std::min(rowBegin + kBlockSize, height), threshold, stats);
+        }
+        std::lock_guard<std::mutex> lock(totalMutex);
+        total.absErrorSum += stats.absErrorSum;
+        total.maxError = std::max(total.maxError, stats.maxError);
+        total.differingPixels += stats.differingPixels;
+        total.ssimSum += stats.ssimSum;
+        total.ssimBlocks += stats.ssimBlocks;
+    };
+    if (pool) {
+        pool->parallelFor(bands, 8, 1, body);
+    } else {
+        body(0, bands);
+    }
+
+    ImageDiffResult result;
+    result.pixelCount = (size_t)width * height;
+    result.meanAbsError = result.pixelCount ? (double)total.absErrorSum / (result.pixelCount * 3) : 0.0;
+    result.maxError = total.maxError;
+    result.differingPixels = total.differingPixels;
+    result.ssim = total.ssimBlocks ? total.ssimSum / total.ssimBlocks : 1.0;
+    return result;
+}
+
+int ImageDiff::runBenchmark(int count) {
+    const int width = 1200, height = 800;
+    std::cout << "[BENCH] Image diff: " << count << " comparisons of " << width << "x" << height
+              << " RGBA per variant | AVX2: " << (cpuSupportsAVX2() ? "yes" : "no") << std::endl;
+
+    // A smooth gradient and a copy with sparse noise and one shifted block, like a small regression
+    std::vector<uint8_t> a((size_t)width * height * 4), b;
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            uint8_t* p = &a[((size_t)y * width + x) * 4];
+            p[0] = (uint8_t)(x * 255 / width);
+            p[1] = (uint8_t)(y * 255 / height);
+            p[2] = (uint8_t)((x + y) & 0xFF);
+            p[3] = 255;
+        }
+    }
+    b = a;
+    std::mt19937 rng(7);
+    for (int i = 0; i < width * height / 100; i++) {
+        b[(rng() % ((size_t)width * height)) * 4 + rng() % 3] ^= 0x10;
+    }
+    for (int y = 300; y < 400; y++) {
+        for (int x = 500; x < 600; x++) b[((size_t)y * width + x) * 4] += 40;
+    }
+    // Full-range differences (black left column against white) for the threshold edge cases
+    for (int y = 0; y < height; y += 2) {
+        for (int k = 0; k < 3; k++) b[(size_t)y * width * 4 + k] = 255;
+        a[(size_t)y * width * 4 + 2] = 0;
+    }
+
+    ThreadPool pool;
+    struct Variant { const char* name; bool avx2; bool threaded; };
+    const Variant variants[] = {
+        {"scalar, 1 thread ", false, false},
+        {"AVX2,   1 thread ", true, false},
+        {"scalar, pool     ", false, true},
+        {"AVX2,   pool     ", true, true},
+    };
+    ImageDiffResult reference = compare(a.data(), b.data(), width, height, 8, nullptr, false);
+    int mismatches = 0;
+    for (const Variant& variant : variants) {
+        if (variant.avx2 && !cpuSupportsAVX2()) continue;
+        ImageDiffResult result;
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < count; i++) {
+            result = compare(a.data(), b.data(), width, height, 8, variant.threaded ? &pool : nullptr, variant.avx2);
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        bool matches = result.maxError == reference.maxError && result.differingPixels == reference.differingPixels &&
+                       std::abs(result.meanAbsError - reference.meanAbsError) < 1e-9 &&
+                       std::abs(result.ssim - reference.ssim) < 1e-9;
+        std::cout << "[BENCH]   " << variant.name << ": " << std::fixed << std::setprecision(3)
+                  << seconds * 1000.0 / count << " ms/image, " << std::setprecision(0) << count / seconds
+                  << " images/s" << std::setprecision(6) << " | mae " << result.meanAbsError << " max "
+                  << result.maxError << " differing " << result.differingPixels << " ssim " << result.ssim
+                  << (matches ? "" : "  MISMATCH vs scalar") << std::endl;
+        std::cout.unsetf(std::ios::fixed);
+        if (!matches) mismatches++;
+    }
+    std::cout << "[BENCH] Threads: " << pool.getThreadCount() << std::endl;
+
+    // Out-of-range thresholds are clamped, so both ends must count the same pixels everywhere
+    const int thresholds[] = {-1000, -1, 0, 1, 8, 253, 254, 255, 1000};
+    for (int threshold : thresholds) {
+        ImageDiffResult expected = compare(a.data(), b.data(), width, height, threshold, nullptr, false);
+        for (const Variant& variant : variants) {
+            if (variant.avx2 && !cpuSupportsAVX2()) continue;
+            ImageDiffResult result = compare(a.data(), b.data(), width, height, threshold,
+                                             variant.threaded ? &pool : nullptr, variant.avx2);
+            if (result.differingPixels != expected.differingPixels) {
+                std::cout << "[BENCH] Threshold " << threshold << ": " << variant.name << " counts "
+                          << result.differingPixels << " differing pixels, scalar " << expected.differingPixels
+                          << "  MISMATCH" << std::endl;
+                mismatches++;
+            }
+        }
+    }
+    std::cout << "[BENCH] Threshold parity (" << sizeof(thresholds) / sizeof(thresholds[0]) << " edge values): "
+              << (mismatches ? "FAILED" : "all variants agree") << std::endl;
+    return mismatches ? 1 : 0;
+}
@@ -0,0 +1,199 @@
+#include "../include/ImageIO.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <zlib.h>
+
+namespace {
+    void appendBE32(std::vector<uint8_t>& out, uint32_t value) {
+        out.push_back((uint8_t)(value >> 24));
+        out.push_back((uint8_t)(value >> 16));
+        out.push_back((uint8_t)(value >> 8));
+        out.push_back((uint8_t)value);
+    }
+
+    void appendChunk(std::vector<uint8_t>& out, const char type[4], const uint8_t* data, size_t size) {
+        appendBE32(out, (uint32_t)size);
+        size_t typeStart = out.size();
+        out.insert(out.end(), type, type + 4);
+        if (size) out.insert(out.end(), data, data + size);
+        uLong crc = crc32(0L, out.data() + typeStart, (uInt)(size + 4));
+        appendBE32(out, (uint32_t)crc);
+    }
+}
+
+bool ImageIO::writePNG(const std::string& path, int width, int height, int channels,
+                       const uint8_t* pixels, bool flipY, int level) {
+    // Filtered scanlines: Sub filter (byte minus the same channel one pixel left), which is
+    // one subtraction per byte and roughly halves the deflate output for rendered frames
+    size_t rowBytes = (size_t)width * channels;
+    std::vector<uint8_t> filtered((rowBytes + 1) * height);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = pixels + rowBytes * (flipY ? height - 1 - y : y);
+        uint8_t* dst = &filtered[(rowBytes + 1) * y];
+        dst[0] = 1;
+        for (size_t i = 0; i < rowBytes; i++) {
+            dst[1 + i] = (uint8_t)(row[i] - (i >= (size_t)channels ? row[i - channels] : 0));
+        }
+    }
+
+    uLongf compressedSize = compressBound((uLong)filtered.size());
+    std::vector<uint8_t> compressed(compressedSize);
+    if (compress2(compressed.data(), &compressedSize, filtered.data(), (uLong)filtered.size(), level) != Z_OK) {
+        return false;
+    }
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    uint8_t header[13];
+    for (int i = 0; i < 4; i++) {
+        header[i] = (uint8_t)(width >> (24 - 8 * i));
+        header[4 + i] = (uint8_t)(height >> (24 - 8 * i));
+    }
+    header[8] = 8;                          // Bit depth
+    header[9] = channels == 4 ? 6 : 2;      // RGBA / RGB
+    header[10] = header[11] = header[12] = 0;  // Deflate, adaptive filtering, no interlace
+    appendChunk(png, "IHDR", header, sizeof(header));
+    appendChunk(png, "IDAT", compressed.data(), compressedSize);
+    appendChunk(png, "IEND", nullptr, 0);
+
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(png.data(), 1, png.size(), file) == png.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+bool ImageIO::readPNG(const std::string& path, int& width, int& height, std::vector<uint8_t>& rgba) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) return false;
+    std::vector<uint8_t> data;
+    uint8_t chunk[65536];
+    size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) data.insert(data.end(), chunk, chunk + read);
+    std::fclose(file);
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    if (data.size() < 8 || std::memcmp(data.data(), signature, 8) != 0) return false;
+
+    auto be32 = [](const uint8_t* p) {
+        return (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 | (uint32_t)p[2] << 8 | p[3];
+    };
+    int channels = 0;
+    std::vector<uint8_t> compressed;
+    for (size_t offset = 8; offset + 12 <= data.size();) {
+        uint32_t length = be32(&data[offset]);
+        const uint8_t* type = &data[offset + 4];
+        const uint8_t* body = &data[offset + 8];
+        if (offset + 12 + length > data.size()) return false;
+        if (std::memcmp(type, "IHDR", 4) == 0) {
+            width = (int)be32(body);
+            height = (int)be32(body + 4);
+            int bitDepth = body[8], colorType = body[9], interlace = body[12];
+            const int channelsByType[7] = {1, 0, 3, 0, 2, 0, 4};
+            channels = colorType <= 6 ? channelsByType[colorType] : 0;
+            if (bitDepth != 8 || channels == 0 || interlace != 0) return false;
+        } else if (std::memcmp(type, "IDAT", 4) == 0) {
+            compressed.insert(compressed.end(), body, body + length);
+        } else if (std::memcmp(type, "IEND", 4) == 0) {
+            break;
+        }
+        offset += 12 + length;
+    }
+    if (!channels || width <= 0 || height <= 0) return false;
+
+    size_t rowBytes = (size_t)width * channels;
+    std::vector<uint8_t> filtered((rowBytes + 1) * height);
+    uLongf filteredSize = (uLongf)filtered.size();
+    if (uncompress(filtered.data(), &filteredSize, compressed.data(), (uLong)compressed.size()) != Z_OK ||
+        filteredSize != filtered.size()) {
+        return false;
+    }
+
+    // Undo the per-row filters in place (the previous row is already reconstructed)
+    std::vector<uint8_t> pixels(rowBytes * height);
+    for (int y = 0; y < height; y++) {
+        uint8_t filter = filtered[(rowBytes + 1) * y];
+        const uint8_t* src = &filtered[(rowBytes + 1) * y + 1];
+        uint8_t* row = &pixels[rowBytes * y];
+        const uint8_t* up = y > 0 ? row - rowBytes : nullptr;
+        for (size_t i = 0; i < rowBytes; i++) {
+            int a = i >= (size_t)channels ? row[i - channels] : 0;
+            int b = up ? up[i] : 0;
+            int c = up && i >= (size_t)channels ? up[i - channels] : 0;
+            int predictor = 0;
+            switch (filter) {
+                case 0: predictor = 0; break;
+                case 1: predictor = a; break;
+                case 2: predictor = b; break;
+                case 3: predictor = (a + b) / 2; break;
+                case 4: {
+                    int p = a + b - c, pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+                    predictor = pa <= pb && pa <= pc ? a : (pb <= pc ? b : c);
+                    break;
+                }
+                default: return false;
+            }
+            row[i] = (uint8_t)(src[i] + predictor);
+        }
+    }
+
+    rgba.resize((size_t)width * height * 4);
+    for (size_t p = 0; p < (size_t)width * height; p++) {
+        const uint8_t* in = &pixels[p * channels];
+        uint8_t* out = &rgba[p * 4];
+        if (channels <= 2) {
+            out[0] = out[1] = out[2] = in[0];
+            out[3] = channels == 2 ? in[1] : 255;
+        } else {
+            out[0] = in[0];
+            out[1] = in[1];
+            out[2] = in[2];
+            out[3] = channels == 4 ? in[3] : 255;
+        }
+    }
+    return true;
+}
+
+void ImageIO::convertRGBAToI420(const uint8_t* rgba, int width, int height, bool flipY,
+                                std::vector<uint8_t>& out) {
+    int chromaWidth = (width + 1) / 2, chromaHeight = (height + 1) / 2;
+    out.resize((size_t)width * height + 2 * (size_t)chromaWidth * chromaHeight);
+    uint8_t* planeY = out.data();
+    uint8_t* planeU = planeY + (size_t)width * height;
+    uint8_t* planeV = planeU + (size_t)chromaWidth * chromaHeight;
+
+    auto pixel = [&](int x, int y) {
+        int row = flipY ? height - 1 - y : y;
+        return rgba + ((size_t)row * width + x) * 4;
+    };
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            const uint8_t* p = pixel(x, y);
+            planeY[(size_t)y * width + x] = (uint8_t)(((66 * p[0] + 129 * p[1] + 25 * p[2] + 128) >> 8) + 16);
+        }
+    }
+    // Chroma from the 2x2 average (edge pixels repeat on odd sizes)
+    for (int cy = 0; cy < chromaHeight; cy++) {
+        for (int cx = 0; cx < chromaWidth; cx++) {
+            int r = 0, g = 0, b = 0;
+            for (int dy = 0; dy < 2; dy++) {
+                for (int dx = 0; dx < 2; dx++) {
+                    int x = cx * 2 + dx < width ? cx * 2 + dx : width - 1;
+                    int y = cy * 2 + dy < height ? cy * 2 + dy : height - 1;
+                    const uint8_t* p = pixel(x, y);
+                    r += p[0];
+                    g += p[1];
+                    b += p[2];
+                }
+            }
+            size_t index = (size_t)cy * chromaWidth + cx;
+            planeU[index] = (uint8_t)(((-38 * r - 74 * g + 112 * b + 512) >> 10) + 128);
+            planeV[index] = (uint8_t)(((112 * r - 94 * g - 18 * b + 512) >> 10) + 128);
+        }
+    }
+}
+
+std::string ImageIO::y4mHeader(int width, int height, int fps) {
+    char header[96];
+    std::snprintf(header, sizeof(header), "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", width, height, fps);
+    return header;
+}
@@ -0,0 +1,236 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/InstanceData.h"
+#include "../include/HeadlessContext.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define INSTANCE_TRANSFORMS_X86 1
+#endif
+
+// InstanceTransforms implementation
+glm::mat3 InstanceTransforms::normalMatrix(const glm::mat4& model) {
+    // inverse(A)^T has columns (c1 x c2, c2 x c0, c0 x c1) / det(A) for A = [c0 c1 c2]
+    glm::vec3 c0(model[0]), c1(model[1]), c2(model[2]);
+    glm::vec3 n0 = glm::cross(c1, c2);
+    glm::vec3 n1 = glm::cross(c2, c0);
+    glm::vec3 n2 = glm::cross(c0, c1);
+    float invDet = 1.0f / glm::dot(c0, n0);
+    return glm::mat3(n0 * invDet, n1 * invDet, n2 * invDet);
+}
+
+void InstanceTransforms::computeScalar(const glm::mat4* models, size_t count, InstanceData* out) {
+    for (size_t i = 0; i < count; i++) {
+        glm::mat3 normal = normalMatrix(models[i]);
+        out[i].model = models[i];
+        for (int column = 0; column < 3; column++) {
+            out[i].normalMatrix[column] = glm::vec4(normal[column], 0.0f);
+        }
+    }
+}
+
+#ifdef INSTANCE_TRANSFORMS_X86
+__attribute__((target("avx2,fma")))
+static inline void cross8(const __m256* u, const __m256* v, __m256* result) {
+    result[0] = _mm256_fmsub_ps(u[1], v[2], _mm256_mul_ps(u[2], v[1]));
+    result[1] = _mm256_fmsub_ps(u[2], v[0], _mm256_mul_ps(u[0], v[2]));
+    result[2] = _mm256_fmsub_ps(u[0], v[1], _mm256_mul_ps(u[1], v[0]));
+}
+
+__attribute__((target("avx2,fma")))
+void InstanceTransforms::computeAVX2(const glm::mat4* models, size_t count, InstanceData* out) {
+    // Lane k reads matrix i + k: consecutive mat4s are 16 floats apart
+    const __m256i matrixStride = _mm256_setr_epi32(0, 16, 32, 48, 64, 80, 96, 112);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    alignas(32) float normals[3][3][8];
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        // Upper 3x3 of 8 matrices transposed to SoA: a[column][row]
+        const float* base = &models[i][0][0];
+        __m256 a[3][3];
+        for (int column = 0; column < 3; column++) {
+            for (int row = 0; row < 3; row++) {
+                a[column][row] = _mm256_i32gather_ps(base + column * 4 + row, matrixStride, 4);
+            }
+        }
+
+        __m256 n[3][3];
+        cross8(a[1], a[2], n[0]);
+        cross8(a[2], a[0], n[1]);
+        cross8(a[0], a[1], n[2]);
+        __m256 det = _mm256_fmadd_ps(a[0][0], n[0][0],
+            _mm256_fmadd_ps(a[0][1], n[0][1], _mm256_mul_ps(a[0][2], n[0][2])));
+        __m256 invDet = _mm256_div_ps(one, det);
+        for (int column = 0; column < 3; column++) {
+            for (int row = 0; row < 3; row++) {
+                _mm256_store_ps(normals[column][row], _mm256_mul_ps(n[column][row], invDet));
+            }
+        }
+
+        for (int k = 0; k < 8; k++) {
+            out[i + k].model = models[i + k];
+            for (int column = 0; column < 3; column++) {
+                out[i + k].normalMatrix[column] = glm::vec4(normals[column][0][k], normals[column][1][k],
+                                                            normals[column][2][k], 0.0f);
+            }
+        }
+    }
+    computeScalar(models + i, count - i, out + i);
+}
+#else
+void InstanceTransforms::computeAVX2(const glm::mat4* models, size_t count, InstanceData* out) {
+    computeScalar(models, count, out);
+}
+#endif
+
+std::vector<InstanceData> InstanceTransforms::build(const std::vector<glm::mat4>& models, bool useAVX2) {
+    std::vector<InstanceData> instances(models.size());
+    if (useAVX2 && FrustumCuller::cpuSupportsAVX2()) {
+        computeAVX2(models.data(), models.size(), instances.data());
+    } else {
+        computeScalar(models.data(), models.size(), instances.data());
+    }
+    return instances;
+}
+
+void InstanceTransforms::setupAttributes() {
+    // mat4 model = 4 vec4 attributes, mat3 normal matrix = 3 vec3 attributes (vec4-padded)
+    for (int column = 0; column < 4; column++) {
+        glVertexAttribPointer(3 + column, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                              (void*)(offsetof(InstanceData, model) + column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(3 + column);
+        glVertexAttribDivisor(3 + column, 1);
+    }
+    for (int column = 0; column < 3; column++) {
+        glVertexAttribPointer(7 + column, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
+                              (void*)(offsetof(InstanceData, normalMatrix) + column * sizeof(glm::vec4)));
+        glEnableVertexAttribArray(7 + column);
+        glVertexAttribDivisor(7 + column, 1);
+    }
+}
+
+int InstanceTransforms::runBenchmark(int instanceCount) {
+    const int kCpuMatrices = 1000000;
+    const int kCpuIterations = 20;
+    const int kWarmupFrames = 3;
+    const int kFrames = 20;
+    const int kTargetSize = 64;
+
+    // CPU side: batch throughput, and accuracy with non-uniform scale (N^T * A must be I)
+    std::vector<glm::mat4> models = CubeData::generateInstanceField(kCpuMatrices, 1337u);
+    for (size_t i = 0; i < models.size(); i++) {
+        models[i] = glm::scale(models[i], glm::vec3(1.0f + (i % 7) * 0.25f, 0.5f + (i % 3) * 0.5f, 1.0f));
+    }
+    std::vector<InstanceData> scalarOut(models.size()), simdOut(models.size());
+
+    std::cout << "[BENCH] Normal matrices: " << kCpuMatrices << " instances on the CPU" << std::endl;
+    struct Kernel { const char* name; bool avx2; std::vector<InstanceData>* out; };
+    const Kernel kernels[] = {{"scalar", false, &scalarOut}, {"AVX2  ", true, &simdOut}};
+    for (const Kernel& kernel : kernels) {
+        if (kernel.avx2 && !FrustumCuller::cpuSupportsAVX2()) continue;
+        auto start = std::chrono::steady_clock::now();
+        for (int iteration = 0; iteration < kCpuIterations; iteration++) {
+            if (kernel.avx2) {
+                computeAVX2(models.data(), models.size(), kernel.out->data());
+            } else {
+                computeScalar(models.data(), models.size(), kernel.out->data());
+            }
+        }
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        std::cout << "[BENCH]   " << kernel.name << ": " << std::fixed << std::setprecision(1)
+                  << (double)kCpuMatrices * kCpuIterations / seconds / 1.0e6 << " M matrices/sec ("
+                  << std::setprecision(3) << seconds * 1000.0 / kCpuIterations << " ms per batch)" << std::endl;
+    }
+
+    float maxIdentityError = 0.0f, maxKernelDifference = 0.0f;
+    bool compareKernels = FrustumCuller::cpuSupportsAVX2();
+    for (size_t i = 0; i < models.size(); i++) {
+        for (int column = 0; column < 3; column++) {
+            for (int row = 0; row < 3; row++) {
+                // (N^T A)[column][row] = dot(N column 'row', A column 'column')
+                float value = glm::dot(glm::vec3(scalarOut[i].normalMatrix[row]), glm::vec3(models[i][column]));
+                maxIdentityError = std::max(maxIdentityError, std::abs(value - (row == column ? 1.0f : 0.0f)));
+                if (compareKernels) {
+                    maxKernelDifference = std::max(maxKernelDifference,
+                        std::abs(scalarOut[i].normalMatrix[column][row] - simdOut[i].normalMatrix[column][row]));
+                }
+            }
+        }
+    }
+    std::cout << "[BENCH]   max |N^T A - I| = " << std::scientific << std::setprecision(2) << maxIdentityError
+              << ", max scalar/AVX2 difference = " << maxKernelDifference << std::defaultfloat << std::endl;
+
+    // GPU side: same draw with the per-vertex inverse and with the per-instance attribute
+    std::cout << "[BENCH] Vertex stage: rounded cube x " << instanceCount << " instances, diffuse lighting" << std::endl;
+    HeadlessContext context;
+    if (!context.create("Normal matrix benchmark", "[BENCH]")) return 1;
+
+    MeshData mesh = MeshBuilder::generateRoundedCube(48, 0.3f);
+    MeshOptimizer::optimizeVertexCache(mesh.indices, mesh.vertices.size());
+    std::vector<PackedVertex> packed = VertexPacking::packMesh(mesh.vertices);
+    std::vector<InstanceData> instances = build(CubeData::generateInstanceField(instanceCount, 1337u), true);
+
+    context.createTarget(kTargetSize);  // Tiny, so the vertex stage dominates
+
+    GLuint vao, vbo, ebo, instanceBuffer;
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glGenBuffers(1, &vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(PackedVertex), packed.data(), GL_STATIC_DRAW);
+    VertexPacking::setupPackedAttributes();
+    glGenBuffers(1, &ebo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(uint32_t), mesh.indices.data(), GL_STATIC_DRAW);
+    glGenBuffers(1, &instanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(InstanceData), instances.data(), GL_STATIC_DRAW);
+    setupAttributes();
+
+    glm::mat4 model = glm::rotate(glm::mat4(1.0f), glm::radians(30.0f), glm::vec3(0.3f, 1.0f, 0.0f));
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f);
+    glm::mat3 sceneNormalMatrix = normalMatrix(model);
+
+    uint32_t features = ShaderFeature::VertexColors | ShaderFeature::Diffuse | ShaderFeature::Instanced;
+    struct Variant { const char* name; std::string defines; };
+    const Variant variants[] = {
+        {"inverse per vertex  ", ShaderFeature::toDefines(features) + "#define PER_VERTEX_NORMAL_MATRIX\n"},
+        {"CPU normal matrices ", ShaderFeature::toDefines(features)},
+    };
+
+    double baselineMs = 0.0;
+    for (const Variant& variant : variants) {
+        GLuint program = ShaderManager::createShaderProgram("shaders/cube.vert", "shaders/cube.frag", variant.defines);
+        glUseProgram(program);
+        glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, glm::value_ptr(model));
+        glUniformMatrix4fv(glGetUniformLocation(program, "view"), 1, GL_FALSE, glm::value_ptr(view));
+        glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+        glUniformMatrix3fv(glGetUniformLocation(program, "normalMatrix"), 1, GL_FALSE, glm::value_ptr(sceneNormalMatrix));
+        glUniform3f(glGetUniformLocation(program, "lightPos"), -2.0f, 3.0f, 2.0f);
+        glUniform3f(glGetUniformLocation(program, "lightColor"), 1.0f, 1.0f, 1.0f);
+
+        double medianMs = context.timeMedianMs([&]() {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            glDrawElementsInstanced(GL_TRIANGLES, (GLsizei)mesh.indices.size(), GL_UNSIGNED_INT, 0, instanceCount);
+        }, kWarmupFrames, kFrames);
+        checkGLError("Normal matrix benchmark draw");
+        if (baselineMs == 0.0) baselineMs = medianMs;
+
+        double vertices = (double)mesh.vertices.size() * instanceCount;
+        std::cout << "[BENCH]   " << variant.name << ": " << std::fixed << std::setprecision(3) << medianMs
+                  << " ms/frame GPU, " << std::setprecision(2) << medianMs * 1.0e6 / vertices << " ns per unique vertex, "
+                  << std::setprecision(0) << 100.0 * medianMs / baselineMs << "% of per-vertex time" << std::endl;
+        glDeleteProgram(program);
+    }
+
+    glBindVertexArray(0);
+    glDeleteVertexArrays(1, &vao);
+    glDeleteBuffers(1, &vbo);
+    glDeleteBuffers(1, &ebo);
+    glDeleteBuffers(1, &instanceBuffer);
+    return 0;
+}
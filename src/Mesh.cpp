@@ -0,0 +1,744 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/Mesh.h"
+#include "../include/VertexFormat.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+    // Symmetric 4x4 plane quadric (upper triangle), accumulated with triangle-area weights
+    struct Quadric {
+        double m[10] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+        double weight = 0.0;
+
+        void addPlane(double a, double b, double c, double d, double w) {
+            m[0] += w * a * a; m[1] += w * a * b; m[2] += w * a * c; m[3] += w * a * d;
+            m[4] += w * b * b; m[5] += w * b * c; m[6] += w * b * d;
+            m[7] += w * c * c; m[8] += w * c * d;
+            m[9] += w * d * d;
+            weight += w;
+        }
+        void add(const Quadric& other) {
+            for (int i = 0; i < 10; i++) m[i] += other.m[i];
+            weight += other.weight;
+        }
+        // Area-weighted sum of squared distances from p to the accumulated planes
+        double evaluate(const glm::vec3& p) const {
+            double x = p.x, y = p.y, z = p.z;
+            return m[0] * x * x + 2.0 * m[1] * x * y + 2.0 * m[2] * x * z + 2.0 * m[3] * x
+                 + m[4] * y * y + 2.0 * m[5] * y * z + 2.0 * m[6] * y
+                 + m[7] * z * z + 2.0 * m[8] * z
+                 + m[9];
+        }
+    };
+
+    struct Collapse {
+        double cost;
+        uint32_t from, to;
+        uint32_t fromStamp, toStamp;
+        bool operator>(const Collapse& other) const { return cost > other.cost; }
+    };
+
+    uint64_t edgeKey(uint32_t a, uint32_t b) {
+        return a < b ? ((uint64_t)a << 32) | b : ((uint64_t)b << 32) | a;
+    }
+
+    const int kForsythCacheSize = 32;
+
+    float forsythVertexScore(int cachePosition, uint32_t liveTriangles) {
+        if (liveTriangles == 0) return 0.0f;
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            // The last triangle's vertices get a fixed score so the next one does not simply reuse them
+            if (cachePosition < 3) {
+                score = 0.75f;
+            } else {
+                score = std::pow(1.0f - (cachePosition - 3) * (1.0f / (kForsythCacheSize - 3)), 1.5f);
+            }
+        }
+        // Favour vertices with few triangles left so they get finished and leave the cache
+        return score + 2.0f * std::pow((float)liveTriangles, -0.5f);
+    }
+}
+
+// MeshBuilder implementation
+glm::vec3 MeshBuilder::paletteColor(const glm::vec3& normal) {
+    glm::vec3 weights = normal * normal;
+    float total = weights.x + weights.y + weights.z;
+    if (total <= 0.0f) return glm::vec3(0.7f);
+    // Same face colors as CubeData::cubeVertices
+    glm::vec3 x = normal.x >= 0.0f ? glm::vec3(0.2f, 0.8f, 0.3f) : glm::vec3(0.9f, 0.7f, 0.2f);
+    glm::vec3 y = normal.y >= 0.0f ? glm::vec3(0.3f, 0.4f, 0.9f) : glm::vec3(0.2f, 0.8f, 0.8f);
+    glm::vec3 z = normal.z >= 0.0f ? glm::vec3(0.9f, 0.3f, 0.2f) : glm::vec3(0.6f, 0.2f, 0.8f);
+    return (x * weights.x + y * weights.y + z * weights.z) / total;
+}
+
+MeshData MeshBuilder::generateRoundedCube(int segments, float edgeRadius) {
+    MeshData mesh;
+    segments = std::max(segments, 2);
+    edgeRadius = std::min(std::max(edgeRadius, 0.0f), 1.0f);
+
+    // Grid points are keyed by their integer lattice coordinates, which welds the face
+    // grids exactly along the shared cube edges
+    std::unordered_map<uint64_t, uint32_t> lattice;
+    auto vertexAt = [&](int ix, int iy, int iz) -> uint32_t {
+        uint64_t key = ((uint64_t)ix << 42) | ((uint64_t)iy << 21) | (uint64_t)iz;
+        auto found = lattice.find(key);
+        if (found != lattice.end()) return found->second;
+
+        glm::vec3 p(ix * 2.0f / segments - 1.0f, iy * 2.0f / segments - 1.0f, iz * 2.0f / segments - 1.0f);
+        glm::vec3 inner = glm::clamp(p, edgeRadius - 1.0f, 1.0f - edgeRadius);
+        glm::vec3 offset = p - inner;
+        float offsetLength = glm::length(offset);
+        glm::vec3 normal = offsetLength > 0.0f ? offset / offsetLength : glm::normalize(p);
+
+        MeshVertex vertex;
+        vertex.position = (inner + normal * edgeRadius) * 0.5f;
+        vertex.normal = normal;
+        vertex.color = paletteColor(normal);
+        uint32_t index = (uint32_t)mesh.vertices.size();
+        mesh.vertices.push_back(vertex);
+        lattice[key] = index;
+        return index;
+    };
+
+    for (int axis = 0; axis < 3; axis++) {
+        int u = (axis + 1) % 3;
+        int v = (axis + 2) % 3;
+        for (int side = 0; side < 2; side++) {
+            for (int i = 0; i < segments; i++) {
+                for (int j = 0; j < segments; j++) {
+                    uint32_t corners[4];
+                    const int cornerOffsets[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+                    for (int c = 0; c < 4; c++) {
+                        int coords[3];
+                        coords[axis] = side ? segments : 0;
+                        coords[u] = i + cornerOffsets[c][0];
+                        coords[v] = j + cornerOffsets[c][1];
+                        corners[c] = vertexAt(coords[0], coords[1], coords[2]);
+                    }
+                    // (u, v, axis) is right-handed, so this order is CCW seen from the positive side
+                    if (side) {
+                        mesh.indices.insert(mesh.indices.end(), {corners[0], corners[1], corners[2], corners[2], corners[3], corners[0]});
+                    } else {
+                        mesh.indices.insert(mesh.indices.end(), {corners[0], corners[2], corners[1], corners[2], corners[0], corners[3]});
+                    }
+                }
+            }
+        }
+    }
+
+    std::cout << "[MESH] Generated rounded cube: " << mesh.vertices.size() << " vertices, "
+              << mesh.indices.size() / 3 << " triangles" << std::endl;
+    return mesh;
+}
+
+bool MeshBuilder::loadOBJ(const std::string& path, MeshData& mesh) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[MESH] Failed to open mesh file: " << path << std::endl;
+        return false;
+    }
+
+    mesh = MeshData();
+    std::vector<glm::vec3> positions, normals;
+    // File index -> first identical value, so duplicated positions/normals weld together
+    std::vector<int> positionRemap, normalRemap;
+    std::map<std::tuple<float, float, float>, int> positionLookup, normalLookup;
+    std::map<std::pair<int, int>, uint32_t> cornerLookup;  // (position, normal) -> vertex
+    auto resolve = [](int index, size_t count) { return index < 0 ? (int)count + index : index - 1; };
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream in(line);
+        std::string tag;
+        in >> tag;
+        if (tag == "v") {
+            glm::vec3 p(0.0f);
+            in >> p.x >> p.y >> p.z;
+            auto found = positionLookup.emplace(std::make_tuple(p.x, p.y, p.z), (int)positions.size()).first;
+            positionRemap.push_back(found->second);
+            positions.push_back(p);
+        } else if (tag == "vn") {
+            glm::vec3 n(0.0f);
+            in >> n.x >> n.y >> n.z;
+            auto found = normalLookup.emplace(std::make_tuple(n.x, n.y, n.z), (int)normals.size()).first;
+            normalRemap.push_back(found->second);
+            normals.push_back(n);
+        } else if (tag == "f") {
+            std::vector<uint32_t> polygon;
+            std::string corner;
+            while (in >> corner) {
+                // v, v/t, v//n or v/t/n
+                int position = resolve(std::atoi(corner.c_str()), positions.size());
+                int normal = -1;
+                size_t firstSlash = corner.find('/');
+                size_t secondSlash = firstSlash == std::string::npos ? std::string::npos : corner.find('/', firstSlash + 1);
+                if (secondSlash != std::string::npos && secondSlash + 1 < corner.size()) {
+                    normal = resolve(std::atoi(corner.c_str() + secondSlash + 1), normals.size());
+                    if (normal < 0 || normal >= (int)normals.size()) normal = -1;
+                }
+                if (position < 0 || position >= (int)positions.size()) {
+                    std::cerr << "[MESH] Invalid vertex reference '" << corner << "' in " << path << std::endl;
+                    return false;
+                }
+
+                auto key = std::make_pair(positionRemap[position], normal >= 0 ? normalRemap[normal] : -1);
+                auto found = cornerLookup.find(key);
+                if (found == cornerLookup.end()) {
+                    MeshVertex vertex;
+                    vertex.position = positions[position];
+                    vertex.normal = normal >= 0 ? normals[normal] : glm::vec3(0.0f);
+                    vertex.color = glm::vec3(0.0f);
+                    found = cornerLookup.emplace(key, (uint32_t)mesh.vertices.size()).first;
+                    mesh.vertices.push_back(vertex);
+                }
+                polygon.push_back(found->second);
+            }
+            for (size_t k = 1; k + 1 < polygon.size(); k++) {
+                uint32_t a = polygon[0], b = polygon[k], c = polygon[k + 1];
+                if (a == b || b == c || a == c) continue;  // Degenerate after welding
+                mesh.indices.insert(mesh.indices.end(), {a, b, c});
+            }
+        }
+    }
+
+    if (mesh.indices.empty()) {
+        std::cerr << "[MESH] No triangles found in " << path << std::endl;
+        return false;
+    }
+
+    // Rebuild area-weighted smooth normals wherever the file did not provide one
+    std::vector<glm::vec3> accumulated(mesh.vertices.size(), glm::vec3(0.0f));
+    for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+        const glm::vec3& a = mesh.vertices[mesh.indices[i]].position;
+        const glm::vec3& b = mesh.vertices[mesh.indices[i + 1]].position;
+        const glm::vec3& c = mesh.vertices[mesh.indices[i + 2]].position;
+        glm::vec3 faceNormal = glm::cross(b - a, c - a);
+        for (int k = 0; k < 3; k++) accumulated[mesh.indices[i + k]] += faceNormal;
+    }
+
+    // Fit into the unit cube the camera is set up for
+    glm::vec3 boundsMin(1e30f), boundsMax(-1e30f);
+    for (const MeshVertex& vertex : mesh.vertices) {
+        boundsMin = glm::min(boundsMin, vertex.position);
+        boundsMax = glm::max(boundsMax, vertex.position);
+    }
+    glm::vec3 extent = boundsMax - boundsMin;
+    float scale = 1.0f / std::max(std::max(extent.x, extent.y), std::max(extent.z, 1e-6f));
+    glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+
+    for (size_t i = 0; i < mesh.vertices.size(); i++) {
+        MeshVertex& vertex = mesh.vertices[i];
+        vertex.position = (vertex.position - center) * scale;
+        if (glm::length(vertex.normal) == 0.0f && glm::length(accumulated[i]) > 0.0f) {
+            vertex.normal = accumulated[i];
+        }
+        vertex.normal = glm::length(vertex.normal) > 0.0f ? glm::normalize(vertex.normal) : glm::vec3(0.0f, 1.0f, 0.0f);
+        vertex.color = paletteColor(vertex.normal);
+    }
+
+    std::cout << "[MESH] Loaded " << path << ": " << mesh.vertices.size() << " vertices, "
+              << mesh.indices.size() / 3 << " triangles" << std::endl;
+    return true;
+}
+
+// MeshOptimizer implementation
+std::vector<uint32_t> MeshOptimizer::simplify(const std::vector<MeshVertex>& vertices,
+                                              const std::vector<uint32_t>& indices,
+                                              size_t targetIndexCount, float* resultError) {
+    size_t vertexCount = vertices.size();
+    size_t triangleCount = indices.size() / 3;
+    std::vector<uint32_t> triangles(indices);
+    std::vector<char> triangleAlive(triangleCount, 1);
+    std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+    std::vector<Quadric> quadrics(vertexCount);
+
+    for (size_t t = 0; t < triangleCount; t++) {
+        uint32_t a = triangles[t * 3], b = triangles[t * 3 + 1], c = triangles[t * 3 + 2];
+        vertexTriangles[a].push_back((uint32_t)t);
+        vertexTriangles[b].push_back((uint32_t)t);
+        vertexTriangles[c].push_back((uint32_t)t);
+
+        glm::vec3 normal = glm::cross(vertices[b].position - vertices[a].position,
+                                      vertices[c].position - vertices[a].position);
+        float length = glm::length(normal);
+        if (length > 0.0f) {
+            normal /= length;
+            double d = -glm::dot(normal, vertices[a].position);
+            double area = 0.5 * length;
+            quadrics[a].addPlane(normal.x, normal.y, normal.z, d, area);
+            quadrics[b].addPlane(normal.x, normal.y, normal.z, d, area);
+            quadrics[c].addPlane(normal.x, normal.y, normal.z, d, area);
+        }
+    }
+
+    // Edges not shared by exactly two triangles are open borders, attribute seams (split
+    // vertices) or non-manifold; their vertices stay put so LODs never crack
+    std::unordered_map<uint64_t, int> edgeUse;
+    edgeUse.reserve(indices.size());
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < 3; k++) {
+            edgeUse[edgeKey(triangles[t * 3 + k], triangles[t * 3 + (k + 1) % 3])]++;
+        }
+    }
+    std::vector<char> locked(vertexCount, 0);
+    for (const auto& edge : edgeUse) {
+        if (edge.second != 2) {
+            locked[edge.first >> 32] = 1;
+            locked[edge.first & 0xffffffffu] = 1;
+        }
+    }
+
+    std::vector<uint32_t> stamp(vertexCount, 0);
+    std::vector<char> removed(vertexCount, 0);
+    std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> heap;
+
+    // Collapsing 'from' onto 'to' keeps to's position; the merged quadric measures the damage
+    auto pushCollapse = [&](uint32_t from, uint32_t to) {
+        if (locked[from]) return;
+        Quadric merged = quadrics[from];
+        merged.add(quadrics[to]);
+        double cost = merged.evaluate(vertices[to].position) / std::max(merged.weight, 1e-12);
+        heap.push({std::max(cost, 0.0), from, to, stamp[from], stamp[to]});
+    };
+    for (const auto& edge : edgeUse) {
+        uint32_t a = (uint32_t)(edge.first >> 32), b = (uint32_t)(edge.first & 0xffffffffu);
+        pushCollapse(a, b);
+        pushCollapse(b, a);
+    }
+
+    auto gatherNeighbours = [&](uint32_t vertex, std::vector<uint32_t>& out) {
+        out.clear();
+        for (uint32_t t : vertexTriangles[vertex]) {
+            if (!triangleAlive[t]) continue;
+            for (int k = 0; k < 3; k++) {
+                if (triangles[t * 3 + k] != vertex) out.push_back(triangles[t * 3 + k]);
+            }
+        }
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    };
+
+    std::vector<uint32_t> fromNeighbours, toNeighbours, shared;
+    size_t aliveTriangles = triangleCount;
+    double maxCost = 0.0;
+
+    while (aliveTriangles * 3 > targetIndexCount && !heap.empty()) {
+        Collapse collapse = heap.top();
+        heap.pop();
+        uint32_t from = collapse.from, to = collapse.to;
+        if (removed[from] || removed[to] || stamp[from] != collapse.fromStamp || stamp[to] != collapse.toStamp) {
+            continue;  // Stale entry
+        }
+
+        // Link condition: the two endpoints may only share the vertices opposite the edge,
+        // otherwise the collapse pinches the surface into a non-manifold fin
+        gatherNeighbours(from, fromNeighbours);
+        gatherNeighbours(to, toNeighbours);
+        shared.clear();
+        std::set_intersection(fromNeighbours.begin(), fromNeighbours.end(),
+                              toNeighbours.begin(), toNeighbours.end(), std::back_inserter(shared));
+        int edgeTriangles = 0;
+        bool valid = true;
+        for (uint32_t t : vertexTriangles[from]) {
+            if (!triangleAlive[t]) continue;
+            uint32_t* tri = &triangles[t * 3];
+            if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                edgeTriangles++;
+                continue;
+            }
+            // Reject collapses that flip or crush a surviving triangle
+            glm::vec3 p[3], q[3];
+            for (int k = 0; k < 3; k++) {
+                p[k] = vertices[tri[k]].position;
+                q[k] = tri[k] == from ? vertices[to].position : p[k];
+            }
+            glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+            glm::vec3 after = glm::cross(q[1] - q[0], q[2] - q[0]);
+            float beforeLength = glm::length(before), afterLength = glm::length(after);
+            if (afterLength <= 1e-12f || glm::dot(before, after) < 0.2f * beforeLength * afterLength) {
+                valid = false;
+                break;
+            }
+        }
+        if (!valid || (int)shared.size() != edgeTriangles) continue;
+
+        for (uint32_t t : vertexTriangles[from]) {
+            if (!triangleAlive[t]) continue;
+            uint32_t* tri = &triangles[t * 3];
+            if (tri[0] == to || tri[1] == to || tri[2] == to) {
+                triangleAlive[t] = 0;
+                aliveTriangles--;
+            } else {
+                for (int k = 0; k < 3; k++) {
+                    if (tri[k] == from) tri[k] = to;
+                }
+                vertexTriangles[to].push_back(t);
+            }
+        }
+        vertexTriangles[from].clear();
+        quadrics[to].add(quadrics[from]);
+        removed[from] = 1;
+        stamp[to]++;
+        maxCost = std::max(maxCost, collapse.cost);
+
+        // Drop dead triangles from the survivor and re-queue every edge around it
+        auto& survivorTriangles = vertexTriangles[to];
+        survivorTriangles.erase(std::remove_if(survivorTriangles.begin(), survivorTriangles.end(),
+                                               [&](uint32_t t) { return !triangleAlive[t]; }),
+                                survivorTriangles.end());
+        gatherNeighbours(to, toNeighbours);
+        for (uint32_t neighbour : toNeighbours) {
+            pushCollapse(to, neighbour);
+            pushCollapse(neighbour, to);
+        }
+    }
+
+    std::vector<uint32_t> result;
+    result.reserve(aliveTriangles * 3);
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (triangleAlive[t]) {
+            result.insert(result.end(), {triangles[t * 3], triangles[t * 3 + 1], triangles[t * 3 + 2]});
+        }
+    }
+    if (resultError) *resultError = (float)std::sqrt(maxCost);
+    return result;
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<uint32_t>& indices, size_t vertexCount) {
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    // Per-vertex triangle lists; the first liveTriangles[v] entries are the ones not yet emitted
+    std::vector<uint32_t> liveTriangles(vertexCount, 0), offsets(vertexCount + 1, 0);
+    for (uint32_t index : indices) liveTriangles[index]++;
+    for (size_t v = 0; v < vertexCount; v++) offsets[v + 1] = offsets[v] + liveTriangles[v];
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (int k = 0; k < 3; k++) adjacency[cursor[indices[t * 3 + k]]++] = (uint32_t)t;
+    }
+
+    std::vector<int> cachePosition(vertexCount, -1);
+    std::vector<float> vertexScore(vertexCount);
+    for (size_t v = 0; v < vertexCount; v++) vertexScore[v] = forsythVertexScore(-1, liveTriangles[v]);
+    std::vector<float> triangleScore(triangleCount);
+    for (size_t t = 0; t < triangleCount; t++) {
+        triangleScore[t] = vertexScore[indices[t * 3]] + vertexScore[indices[t * 3 + 1]] + vertexScore[indices[t * 3 + 2]];
+    }
+
+    std::vector<char> emitted(triangleCount, 0);
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    std::vector<uint32_t> cache, nextCache;
+    size_t scanCursor = 0;
+    int best = -1;
+
+    while (output.size() < indices.size()) {
+        if (best < 0) {
+            // Nothing useful in the cache: restart from the next unemitted triangle
+            while (emitted[scanCursor]) scanCursor++;
+            best = (int)scanCursor;
+        }
+
+        emitted[best] = 1;
+        const uint32_t* tri = &indices[best * 3];
+        output.insert(output.end(), {tri[0], tri[1], tri[2]});
+
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = tri[k];
+            uint32_t* list = &adjacency[offsets[v]];
+            for (uint32_t i = 0; i < liveTriangles[v]; i++) {
+                if (list[i] == (uint32_t)best) {
+                    std::swap(list[i], list[liveTriangles[v] - 1]);
+                    break;
+                }
+            }
+            liveTriangles[v]--;
+        }
+
+        // Emitted vertices move to the front of the LRU cache
+        nextCache.assign(tri, tri + 3);
+        for (uint32_t v : cache) {
+            if (v != tri[0] && v != tri[1] && v != tri[2]) nextCache.push_back(v);
+        }
+        for (size_t i = 0; i < nextCache.size(); i++) {
+            cachePosition[nextCache[i]] = i < (size_t)kForsythCacheSize ? (int)i : -1;
+        }
+
+        // Rescore everything that moved (including evicted vertices) and pick the best
+        // triangle that touches the cache
+        for (uint32_t v : nextCache) {
+            float score = forsythVertexScore(cachePosition[v], liveTriangles[v]);
+            float delta = score - vertexScore[v];
+            vertexScore[v] = score;
+            for (uint32_t i = 0; i < liveTriangles[v]; i++) triangleScore[adjacency[offsets[v] + i]] += delta;
+        }
+        if (nextCache.size() > (size_t)kForsythCacheSize) nextCache.resize(kForsythCacheSize);
+        cache.swap(nextCache);
+
+        best = -1;
+        float bestScore = 0.0f;
+        for (uint32_t v : cache) {
+            for (uint32_t i = 0; i < liveTriangles[v]; i++) {
+                uint32_t t = adjacency[offsets[v] + i];
+                if (triangleScore[t] > bestScore) {
+                    bestScore = triangleScore[t];
+                    best = (int)t;
+                }
+            }
+        }
+    }
+
+    indices.swap(output);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<MeshVertex>& vertices,
+                                     float threshold) {
+    const int kCacheSize = 16;
+    size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) return;
+
+    // FIFO cache simulation via insertion timestamps
+    std::vector<uint32_t> timestamp(vertices.size(), 0);
+    uint32_t time = kCacheSize + 1;
+    auto triangleMisses = [&](size_t t) {
+        int misses = 0;
+        for (int k = 0; k < 3; k++) {
+            uint32_t v = indices[t * 3 + k];
+            if (time - timestamp[v] > (uint32_t)kCacheSize) {
+                timestamp[v] = time++;
+                misses++;
+            }
+        }
+        return misses;
+    };
+    auto flushCache = [&]() { time += kCacheSize + 1; };
+
+    // Hard boundaries: the cache optimizer restarted (all three vertices missed)
+    std::vector<size_t> hardClusters;
+    for (size_t t = 0; t < triangleCount; t++) {
+        if (triangleMisses(t) == 3 || t == 0) hardClusters.push_back(t);
+    }
+    hardClusters.push_back(triangleCount);
+
+    // Soft boundaries: split a cluster wherever the running ACMR is already within the
+    // threshold of the whole cluster's, so reordering costs little cache efficiency
+    std::vector<size_t> clusters;
+    for (size_t c = 0; c + 1 < hardClusters.size(); c++) {
+        size_t start = hardClusters[c], end = hardClusters[c + 1];
+        flushCache();
+        int clusterMisses = 0;
+        for (size_t t = start; t < end; t++) clusterMisses += triangleMisses(t);
+        float clusterACMR = (float)clusterMisses / (float)(end - start);
+
+        flushCache();
+        clusters.push_back(start);
+        int runningMisses = 0;
+        size_t runningTriangles = 0;
+        for (size_t t = start; t < end; t++) {
+            runningMisses += triangleMisses(t);
+            runningTriangles++;
+            if (t + 1 < end && runningMisses <= threshold * clusterACMR * runningTriangles) {
+                clusters.push_back(t + 1);
+                runningMisses = 0;
+                runningTriangles = 0;
+                flushCache();
+            }
+        }
+    }
+    clusters.push_back(triangleCount);
+
+    // Clusters facing away from the mesh centre are likely occluders: draw them first
+    size_t clusterCount = clusters.size() - 1;
+    std::vector<glm::vec3> clusterCentroid(clusterCount, glm::vec3(0.0f)), clusterNormal(clusterCount, glm::vec3(0.0f));
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    for (size_t c = 0; c < clusterCount; c++) {
+        float clusterArea = 0.0f;
+        for (size_t t = clusters[c]; t < clusters[c + 1]; t++) {
+            const glm::vec3& a = vertices[indices[t * 3]].position;
+            const glm::vec3& b = vertices[indices[t * 3 + 1]].position;
+            const glm::vec3& d = vertices[indices[t * 3 + 2]].position;
+            glm::vec3 normal = glm::cross(b - a, d - a);
+            float area = glm::length(normal);
+            clusterCentroid[c] += (a + b + d) * (area / 3.0f);
+            clusterNormal[c] += normal;
+            clusterArea += area;
+        }
+        meshCentroid += clusterCentroid[c];
+        meshArea += clusterArea;
+        if (clusterArea > 0.0f) clusterCentroid[c] /= clusterArea;
+    }
+    if (meshArea > 0.0f) meshCentroid /= meshArea;
+
+    std::vector<float> sortKey(clusterCount);
+    std::vector<size_t> order(clusterCount);
+    for (size_t c = 0; c < clusterCount; c++) {
+        float normalLength = glm::length(clusterNormal[c]);
+        glm::vec3 normal = normalLength > 0.0f ? clusterNormal[c] / normalLength : glm::vec3(0.0f);
+        sortKey[c] = glm::dot(clusterCentroid[c] - meshCentroid, normal);
+        order[c] = c;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return sortKey[a] > sortKey[b]; });
+
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    for (size_t c : order) {
+        output.insert(output.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+    }
+    indices.swap(output);
+}
+
+float MeshOptimizer::computeACMR(const std::vector<uint32_t>& indices, size_t vertexCount, int cacheSize) {
+    if (indices.empty()) return 0.0f;
+    std::vector<uint32_t> timestamp(vertexCount, 0);
+    uint32_t time = cacheSize + 1;
+    size_t misses = 0;
+    for (uint32_t index : indices) {
+        if (time - timestamp[index] > (uint32_t)cacheSize) {
+            timestamp[index] = time++;
+            misses++;
+        }
+    }
+    return (float)misses / (float)(indices.size() / 3);
+}
+
+// MeshLODChain implementation
+void MeshLODChain::build(const MeshData& source, int lodCount, float reductionPerLevel) {
+    auto start = std::chrono::steady_clock::now();
+    const int kACMRCacheSize = 16;
+    size_t vertexCount = source.vertices.size();
+
+    std::vector<std::vector<uint32_t>> levels;
+    std::vector<float> errors;
+    std::vector<uint32_t> current = source.indices;
+    float accumulatedError = 0.0f;
+
+    for (int level = 0; level < lodCount; level++) {
+        if (level > 0) {
+            // Each level simplifies the previous one, so errors add up
+            size_t target = (size_t)(current.size() / 3 * reductionPerLevel) * 3;
+            float error = 0.0f;
+            std::vector<uint32_t> simplified = MeshOptimizer::simplify(source.vertices, current, target, &error);
+            if (simplified.empty() || simplified.size() >= current.size()) break;  // Nothing left to remove
+            accumulatedError += error;
+            current.swap(simplified);
+        }
+
+        float acmrBefore = MeshOptimizer::computeACMR(current, vertexCount, kACMRCacheSize);
+        MeshOptimizer::optimizeVertexCache(current, vertexCount);
+        MeshOptimizer::optimizeOverdraw(current, source.vertices, 1.05f);
+        float acmrAfter = MeshOptimizer::computeACMR(current, vertexCount, kACMRCacheSize);
+        std::cout << "[MESH] LOD " << level << ": " << current.size() / 3 << " triangles | error "
+                  << accumulatedError << " | ACMR " << acmrBefore << " -> " << acmrAfter << std::endl;
+
+        levels.push_back(current);
+        errors.push_back(accumulatedError);
+    }
+
+    // Order vertices by first use from the coarsest level down, so coarse levels fetch from
+    // a compact prefix of the vertex buffer; unused vertices are dropped
+    std::vector<uint32_t> remap(vertexCount, UINT32_MAX);
+    combined = MeshData();
+    for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+        for (uint32_t index : *level) {
+            if (remap[index] == UINT32_MAX) {
+                remap[index] = (uint32_t)combined.vertices.size();
+                combined.vertices.push_back(source.vertices[index]);
+            }
+        }
+    }
+
+    lods.clear();
+    boundingRadius = 0.0f;
+    for (size_t level = 0; level < levels.size(); level++) {
+        MeshLOD lod;
+        lod.firstIndex = (GLuint)combined.indices.size();
+        lod.indexCount = (GLsizei)levels[level].size();
+        lod.error = errors[level];
+        for (uint32_t index : levels[level]) combined.indices.push_back(remap[index]);
+        lods.push_back(lod);
+    }
+    for (const MeshVertex& vertex : combined.vertices) {
+        boundingRadius = std::max(boundingRadius, glm::length(vertex.position));
+    }
+
+    float buildMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "[MESH] Built " << lods.size() << " LODs (" << combined.vertices.size()
+              << " shared vertices) in " << buildMs << " ms" << std::endl;
+}
+
+bool MeshLODChain::upload() {
+    return uploadBuffers() && createVertexArray();
+}
+
+bool MeshLODChain::uploadBuffers() {
+    if (lods.empty()) return false;
+
+    glGenBuffers(1, &vbo);
+    glGenBuffers(1, &ebo);
+    std::vector<PackedVertex> packed = VertexPacking::packMesh(combined.vertices);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, packed.size() * sizeof(PackedVertex), packed.data(), GL_STATIC_DRAW);
+    // The element binding is VAO state and no VAO exists yet, so the indices go through the
+    // array binding too (the target a buffer is filled through does not type it)
+    glBindBuffer(GL_ARRAY_BUFFER, ebo);
+    glBufferData(GL_ARRAY_BUFFER, combined.indices.size() * sizeof(uint32_t), combined.indices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    checkGLError("Mesh LOD upload");
+
+    // The GPU copy is all we draw from
+    combined = MeshData();
+    return true;
+}
+
+bool MeshLODChain::createVertexArray() {
+    if (!vbo || !ebo) return false;
+
+    glGenVertexArrays(1, &vao);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+    VertexPacking::setupPackedAttributes();
+    glBindVertexArray(0);
+    checkGLError("Mesh LOD vertex array");
+    return true;
+}
+
+void MeshLODChain::draw(GLuint program, int lod) const {
+    if (!vao || lods.empty()) return;
+    lod = std::max(0, std::min(lod, (int)lods.size() - 1));
+    glUseProgram(program);  // Polygon mode is the scene pass's (wireframe tiers)
+    glBindVertexArray(vao);
+    glDrawElements(GL_TRIANGLES, lods[lod].indexCount, GL_UNSIGNED_INT,
+                   (void*)(lods[lod].firstIndex * sizeof(uint32_t)));
+    if (g_verbose) {
+        checkGLError("Mesh LOD draw");
+    }
+}
+
+int MeshLODChain::selectLOD(float distance, float fovY, int viewportHeight, float maxPixelError) const {
+    // Nearest point of the bounding sphere, kept in front of the near plane
+    float nearest = std::max(distance - boundingRadius, 0.1f);
+    float pixelsPerUnit = viewportHeight / (2.0f * nearest * std::tan(fovY * 0.5f));
+    for (int lod = (int)lods.size() - 1; lod > 0; lod--) {
+        if (lods[lod].error * pixelsPerUnit <= maxPixelError) return lod;
+    }
+    return 0;
+}
+
+void MeshLODChain::cleanup() {
+    if (vao) glDeleteVertexArrays(1, &vao);
+    if (vbo) glDeleteBuffers(1, &vbo);
+    if (ebo) glDeleteBuffers(1, &ebo);
+    vao = vbo = ebo = 0;
+    lods.clear();
+}
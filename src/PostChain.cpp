@@ -0,0 +1,218 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/PostChain.h"
+
+namespace {
+    // Per post bit, from QualityEffect::kFirstPost
+    const char* const kEffectLabels[] = {"Bloom", "Tone Map", "Color Grade", "Vignette"};
+
+    int postIndex(uint32_t effect) {
+        int bit = 0;
+        while (bit < QualityEffect::kCount && effect != (1u << bit)) bit++;
+        return bit - QualityEffect::kFirstPost;
+    }
+}
+
+// PostChain implementation
+bool PostChain::initialize(int outputWidth, int outputHeight) {
+    width = outputWidth;
+    height = outputHeight;
+
+    // Every pass draws the screen quad, so they share pixelate.vert
+    blurProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/bloom_blur.frag");
+    upsampleProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/bloom_upsample.frag");
+    compositeProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/bloom_composite.frag");
+    toneMapProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/tonemap.frag");
+    colorGradeProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/color_grade.frag");
+    vignetteProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/vignette.frag");
+    if (!blurProgram || !upsampleProgram || !compositeProgram || !toneMapProgram || !colorGradeProgram ||
+        !vignetteProgram) {
+        return false;
+    }
+
+    checkGLError("Post chain initialization");
+    std::cout << "[POST] Post chain ready (" << width << "x" << height << ", " << kBloomLevels
+              << " bloom levels)" << std::endl;
+    return true;
+}
+
+RenderTargetDesc PostChain::getTargetDesc() const {
+    // Half floats: the bloom composite goes above 1 until tone mapping brings it back
+    RenderTargetDesc desc;
+    desc.width = width;
+    desc.height = height;
+    desc.format = GL_RGBA16F;
+    desc.filter = GL_LINEAR;  // Bloom's first level samples it between texels
+    return desc;
+}
+
+RenderTargetDesc PostChain::getBloomDesc(int level) const {
+    RenderTargetDesc desc = getTargetDesc();
+    desc.width = std::max(width >> (level + 1), 1);
+    desc.height = std::max(height >> (level + 1), 1);
+    return desc;
+}
+
+void PostChain::drawQuad(GLuint program, GLuint texture, CubeRenderer& renderer) {
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glUniform1i(glGetUniformLocation(program, "sourceTexture"), 0);
+    glUniform1i(glGetUniformLocation(program, "screenTexture"), 0);
+    glDisable(GL_DEPTH_TEST);
+    renderer.renderScreenQuad();
+    glEnable(GL_DEPTH_TEST);
+}
+
+void PostChain::declareBloom(RenderGraph& graph, RenderGraph::Resource source, RenderGraph::Resource output,
+                             CubeRenderer& renderer) {
+    typedef RenderGraph::Resource Resource;
+    Resource blurred[kBloomLevels], levels[kBloomLevels];
+    for (int level = 0; level < kBloomLevels; level++) {
+        std::string suffix = std::to_string(level);
+        blurred[level] = graph.createTarget("Bloom Blur " + suffix, getBloomDesc(level));
+        levels[level] = graph.createTarget("Bloom " + suffix, getBloomDesc(level));
+    }
+
+    // Down: the horizontal pass halves the previous level (bright pass on the first), the
+    // vertical one finishes the blur at that size
+    for (int level = 0; level < kBloomLevels; level++) {
+        Resource input = level == 0 ? source : levels[level - 1];
+        RenderTargetDesc desc = getBloomDesc(level);
+        std::string suffix = std::to_string(level);
+        graph.addPass("Bloom H" + suffix, {input}, {blurred[level]}, [this, &graph, &renderer, input, desc, level,
+                                                                      target = blurred[level]]() {
+            glBindFramebuffer(GL_FRAMEBUFFER, graph.getFramebuffer(target));
+            glViewport(0, 0, desc.width, desc.height);
+            glUseProgram(blurProgram);
+            glUniform2f(glGetUniformLocation(blurProgram, "direction"), 1.0f / desc.width, 0.0f);
+            glUniform1f(glGetUniformLocation(blurProgram, "threshold"), level == 0 ? bloomThreshold : -1.0f);
+            glUniform1f(glGetUniformLocation(blurProgram, "knee"), bloomKnee);
+            drawQuad(blurProgram, graph.getTexture(input), renderer);
+        });
+        graph.addPass("Bloom V" + suffix, {blurred[level]}, {levels[level]}, [this, &graph, &renderer, desc,
+                                                                           input = blurred[level],
+                                                                           target = levels[level]]() {
+            glBindFramebuffer(GL_FRAMEBUFFER, graph.getFramebuffer(target));
+            glViewport(0, 0, desc.width, desc.height);
+            glUseProgram(blurProgram);
+            glUniform2f(glGetUniformLocation(blurProgram, "direction"), 0.0f, 1.0f / desc.height);
+            glUniform1f(glGetUniformLocation(blurProgram, "threshold"), -1.0f);
+            drawQuad(blurProgram, graph.getTexture(input), renderer);
+        });
+    }
+
+    // Up: each coarser level is added onto the next finer one, so the top level carries
+    // every radius
+    for (int level = kBloomLevels - 1; level > 0; level--) {
+        RenderTargetDesc coarse = getBloomDesc(level), fine = getBloomDesc(level - 1);
+        graph.addPass("Bloom Up " + std::to_string(level), {levels[level], levels[level - 1]}, {levels[level - 1]},
+                      [this, &graph, &renderer, coarse, fine, input = levels[level], target = levels[level - 1]]() {
+            glBindFramebuffer(GL_FRAMEBUFFER, graph.getFramebuffer(target));
+            glViewport(0, 0, fine.width, fine.height);
+            glUseProgram(upsampleProgram);
+            glUniform2f(glGetUniformLocation(upsampleProgram, "texelSize"), 1.0f / coarse.width, 1.0f / coarse.height);
+            glEnable(GL_BLEND);
+            glBlendFunc(GL_ONE, GL_ONE);
+            drawQuad(upsampleProgram, graph.getTexture(input), renderer);
+            glDisable(GL_BLEND);
+        });
+    }
+
+    graph.addPass("Bloom Composite", {source, levels[0]}, {output}, [this, &graph, &renderer, source, output,
+                                                                    bloom = levels[0]]() {
+        glBindFramebuffer(GL_FRAMEBUFFER, graph.getFramebuffer(output));
+        glViewport(0, 0, width, height);
+        glUseProgram(compositeProgram);
+        glActiveTexture(GL_TEXTURE1);
+        glBindTexture(GL_TEXTURE_2D, graph.getTexture(bloom));
+        glUniform1i(glGetUniformLocation(compositeProgram, "bloomTexture"), 1);
+        glUniform1f(glGetUniformLocation(compositeProgram, "intensity"), bloomIntensity);
+        drawQuad(compositeProgram, graph.getTexture(source), renderer);
+    });
+}
+
+void PostChain::declare(RenderGraph& graph, uint32_t effects, RenderGraph::Resource source,
+                        RenderGraph::Resource output, CubeRenderer& renderer) {
+    std::vector<uint32_t> enabled;
+    for (int bit = QualityEffect::kFirstPost; bit < QualityEffect::kCount; bit++) {
+        if (effects & (1u << bit)) enabled.push_back(1u << bit);
+    }
+
+    RenderGraph::Resource current = source;
+    for (size_t i = 0; i < enabled.size(); i++) {
+        uint32_t effect = enabled[i];
+        RenderGraph::Resource target = i + 1 == enabled.size()
+            ? output
+            : graph.createTarget(std::string(kEffectLabels[postIndex(effect)]) + " Output", getTargetDesc());
+        if (effect == QualityEffect::Bloom) {
+            declareBloom(graph, current, target, renderer);
+            current = target;
+            continue;
+        }
+
+        GLuint program = effect == QualityEffect::ToneMap ? toneMapProgram
+                       : effect == QualityEffect::ColorGrade ? colorGradeProgram
+                       : vignetteProgram;
+        graph.addPass(kEffectLabels[postIndex(effect)], {current}, {target}, [this, &graph, &renderer, effect, program,
+                                                                             input = current, target]() {
+            glBindFramebuffer(GL_FRAMEBUFFER, graph.getFramebuffer(target));
+            glViewport(0, 0, width, height);
+            glUseProgram(program);
+            if (effect == QualityEffect::ToneMap) {
+                glUniform1f(glGetUniformLocation(program, "exposure"), exposure);
+            } else if (effect == QualityEffect::ColorGrade) {
+                glUniform3fv(glGetUniformLocation(program, "colorBalance"), 1, glm::value_ptr(colorBalance));
+                glUniform1f(glGetUniformLocation(program, "contrast"), contrast);
+                glUniform1f(glGetUniformLocation(program, "saturation"), saturation);
+            } else {
+                glUniform1f(glGetUniformLocation(program, "aspect"), (float)width / height);
+                glUniform1f(glGetUniformLocation(program, "intensity"), vignetteIntensity);
+                glUniform1f(glGetUniformLocation(program, "radius"), vignetteRadius);
+                glUniform1f(glGetUniformLocation(program, "softness"), vignetteSoftness);
+            }
+            drawQuad(program, graph.getTexture(input), renderer);
+        });
+        current = target;
+    }
+}
+
+std::vector<std::string> PostChain::getPassNames(uint32_t effect) {
+    if (effect != QualityEffect::Bloom) {
+        return {kEffectLabels[postIndex(effect)]};
+    }
+    std::vector<std::string> names;
+    for (int level = 0; level < kBloomLevels; level++) {
+        names.push_back("Bloom H" + std::to_string(level));
+        names.push_back("Bloom V" + std::to_string(level));
+    }
+    for (int level = kBloomLevels - 1; level > 0; level--) {
+        names.push_back("Bloom Up " + std::to_string(level));
+    }
+    names.push_back("Bloom Composite");
+    return names;
+}
+
+float PostChain::getEffectMs(const RenderGraph& graph, uint32_t effects) {
+    float ms = 0.0f;
+    for (int bit = QualityEffect::kFirstPost; bit < QualityEffect::kCount; bit++) {
+        if (!(effects & (1u << bit))) continue;
+        for (const std::string& name : getPassNames(1u << bit)) ms += graph.getPassMs(name);
+    }
+    return ms;
+}
+
+void PostChain::watch(ShaderHotReloader& reloader) {
+    reloader.watch(&blurProgram, "shaders/pixelate.vert", "shaders/bloom_blur.frag");
+    reloader.watch(&upsampleProgram, "shaders/pixelate.vert", "shaders/bloom_upsample.frag");
+    reloader.watch(&compositeProgram, "shaders/pixelate.vert", "shaders/bloom_composite.frag");
+    reloader.watch(&toneMapProgram, "shaders/pixelate.vert", "shaders/tonemap.frag");
+    reloader.watch(&colorGradeProgram, "shaders/pixelate.vert", "shaders/color_grade.frag");
+    reloader.watch(&vignetteProgram, "shaders/pixelate.vert", "shaders/vignette.frag");
+}
+
+void PostChain::cleanup() {
+    for (GLuint* program : {&blurProgram, &upsampleProgram, &compositeProgram, &toneMapProgram, &colorGradeProgram,
+                            &vignetteProgram}) {
+        if (*program) glDeleteProgram(*program);
+        *program = 0;
+    }
+}
@@ -0,0 +1,312 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/QualitySolver.h"
+#include <algorithm>
+#include <filesystem>
+
+namespace {
+    const char* const kEffectNames[QualityEffect::kCount] = {"SPATIAL", "TEMPORAL", "CHECKERBOARD", "BLOOM",
+                                                             "TONE_MAP", "COLOR_GRADE", "VIGNETTE"};
+    const int kSampleCounts[3] = {0, 2, 4};
+    const float kDefaultFps = 60.0f;  // Frame rate assumed when the user's target is unlimited
+    const int kPostCount = QualityEffect::kCount - QualityEffect::kFirstPost;
+    // Post effects are worth less than any resolution step, so they are the first to go
+    const float kPostScore[kPostCount] = {0.2f, 0.2f, 0.15f, 0.1f};
+
+    int sampleIndex(int samples) {
+        for (int i = 2; i > 0; i--) {
+            if (samples >= kSampleCounts[i]) return i;
+        }
+        return 0;
+    }
+}
+
+// QualityEffect implementation
+std::string QualityEffect::toString(uint32_t effects) {
+    std::string result;
+    for (int bit = 0; bit < kCount; bit++) {
+        if (effects & (1u << bit)) {
+            if (!result.empty()) result += "|";
+            result += kEffectNames[bit];
+        }
+    }
+    return result.empty() ? "NONE" : result;
+}
+
+bool QualityEffect::fromString(const std::string& names, uint32_t& effects) {
+    effects = 0;
+    if (names == "NONE") return true;
+    std::istringstream parts(names);
+    for (std::string part; std::getline(parts, part, '|');) {
+        int bit = 0;
+        while (bit < kCount && part != kEffectNames[bit]) bit++;
+        if (bit == kCount) return false;
+        effects |= 1u << bit;
+    }
+    return effects != 0;
+}
+
+// QualityCostTable implementation
+bool QualityCostTable::load(const std::string& path, const std::string& renderer) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    QualityCostTable table = *this;
+    bool inSection = false, found = false;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+        if (line[0] == '[') {
+            inSection = line == "[" + renderer + "]";
+            found = found || inSection;
+            continue;
+        }
+        if (!inSection) continue;
+
+        std::istringstream fields(line);
+        std::string key;
+        fields >> key;
+        if (key == "baseMs") {
+            fields >> table.baseMs;
+        } else if (key == "shadingMs") {
+            for (float& ms : table.shadingMs) fields >> ms;
+        } else if (key == "msaaMs") {
+            for (float& ms : table.msaaMs) fields >> ms;
+        } else if (key == "meshLodMs") {
+            for (float& ms : table.meshLodMs) fields >> ms;
+        } else if (key == "effectMs") {
+            for (float& ms : table.effectMs) fields >> ms;
+        } else if (key == "checkerboardShadingScale") {
+            fields >> table.checkerboardShadingScale;
+        }
+        if (fields.fail()) {
+            std::cerr << "[CALIBRATE] Malformed line in " << path << ": " << line << std::endl;
+            return false;
+        }
+    }
+    if (found) *this = table;
+    return found;
+}
+
+bool QualityCostTable::save(const std::string& path, const std::string& renderer) const {
+    // Keep every other renderer's section
+    std::vector<std::string> kept;
+    {
+        std::ifstream file(path);
+        std::string line;
+        bool inSection = false;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line[0] == '[') inSection = line == "[" + renderer + "]";
+            if (!inSection && !(line.empty() || line[0] == '#')) kept.push_back(line);
+        }
+    }
+
+    // Write then rename, like the program binary cache
+    std::string tempPath = makeTempPath(path);
+    {
+        std::ofstream file(tempPath, std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "[CALIBRATE] Cannot write " << tempPath << std::endl;
+            return false;
+        }
+        file << "# GPU ms per frame at 1200x800 for each quality knob, measured by --calibrate\n";
+        for (const std::string& line : kept) file << line << "\n";
+        file << "[" << renderer << "]\n";
+        print(file);
+    }
+    std::error_code error;
+    std::filesystem::rename(tempPath, path, error);
+    if (error) {
+        std::filesystem::remove(tempPath, error);
+        return false;
+    }
+    return true;
+}
+
+void QualityCostTable::print(std::ostream& out) const {
+    out << "baseMs " << baseMs << "\n";
+    out << "shadingMs";
+    for (float ms : shadingMs) out << " " << ms;
+    out << "\nmsaaMs";
+    for (float ms : msaaMs) out << " " << ms;
+    out << "\nmeshLodMs";
+    for (float ms : meshLodMs) out << " " << ms;
+    out << "\neffectMs";
+    for (float ms : effectMs) out << " " << ms;
+    out << "\ncheckerboardShadingScale " << checkerboardShadingScale << "\n";
+}
+
+// QualityVector implementation
+bool QualityVector::operator==(const QualityVector& other) const {
+    return scaleTier == other.scaleTier && msaaSamples == other.msaaSamples && shading == other.shading &&
+           meshLOD == other.meshLOD && fpsCap == other.fpsCap && effects == other.effects;
+}
+
+// QualitySolver implementation
+const float QualitySolver::kFpsCaps[3] = {30.0f, 45.0f, 0.0f};
+const float QualitySolver::kTierBudgets[3] = {0.1f, 0.4f, 1.0f};
+const char* const QualitySolver::kCostTablePath = "quality_costs.txt";
+
+float QualitySolver::frameRate(const QualityVector& vector, float targetFps) const {
+    float fps = targetFps > 0.0f ? targetFps : kDefaultFps;
+    return vector.fpsCap > 0.0f ? std::min(fps, vector.fpsCap) : fps;
+}
+
+float QualitySolver::estimateFrameMs(const QualityVector& vector) const {
+    float scale = renderScales[vector.scaleTier];
+    float shadingMs = costs.shadingMs[(int)vector.shading];
+    if (vector.effects & QualityEffect::Checkerboard) {
+        shadingMs *= costs.checkerboardShadingScale;
+    }
+    float ms = costs.baseMs + scale * scale * (shadingMs + costs.msaaMs[sampleIndex(vector.msaaSamples)]);
+    ms += costs.meshLodMs[vector.meshLOD];
+    for (int bit = 0; bit < QualityEffect::kCount; bit++) {
+        if (vector.effects & (1u << bit)) ms += costs.effectMs[bit];
+    }
+    return ms;
+}
+
+float QualitySolver::estimateCost(const QualityVector& vector, BudgetMode mode, float targetFps) const {
+    float ms = estimateFrameMs(vector);
+    return mode == BudgetMode::Power ? ms * frameRate(vector, targetFps) : ms;
+}
+
+float QualitySolver::score(const QualityVector& vector, float targetFps) const {
+    // Perceptual weights: resolution and frame rate dominate, then lighting, then edges
+    static const float kSampleScore[3] = {0.0f, 0.8f, 1.2f};
+    static const float kShadingScore[3] = {0.0f, 1.2f, 2.0f};
+    static const float kLodScore[4] = {1.5f, 1.3f, 0.9f, 0.4f};
+
+    float scale = renderScales[vector.scaleTier];
+    float upscale = 1.0f - scale;  // How much a reconstruction pass recovers
+    bool temporal = (vector.effects & QualityEffect::TemporalUpsample) != 0;
+    // Resolution: 0 at 50%, 2 at 75%, 3 at 100%, falling on steeply below 50%
+    float scaleScore = scale < 0.75f ? 8.0f * (scale - 0.5f) : 2.0f + 4.0f * (scale - 0.75f);
+    float result = scaleScore + kShadingScore[(int)vector.shading] + kLodScore[vector.meshLOD];
+    // The temporal resolve already anti-aliases, so extra samples are worth less under it
+    result += kSampleScore[sampleIndex(vector.msaaSamples)] * (temporal ? 0.5f : 1.0f);
+    result += 2.0f * frameRate(vector, targetFps) / (targetFps > 0.0f ? targetFps : kDefaultFps);
+    if (vector.effects & QualityEffect::SpatialUpscale) result += 0.1f + 0.9f * upscale;
+    if (temporal) result += 0.3f + 1.2f * upscale;
+    if (vector.effects & QualityEffect::Checkerboard) result -= 0.7f;
+    for (int bit = QualityEffect::kFirstPost; bit < QualityEffect::kCount; bit++) {
+        if (vector.effects & (1u << bit)) result += kPostScore[bit - QualityEffect::kFirstPost];
+    }
+    return result;
+}
+
+QualityVector QualitySolver::maximum() const {
+    int largest = (int)(std::max_element(renderScales.begin(), renderScales.end()) - renderScales.begin());
+    QualityVector vector = {largest, kSampleCounts[sampleIndex(maxSamples)], ShadingModel::Phong, 0, 0.0f,
+                            QualityEffect::SpatialUpscale | QualityEffect::kPost};
+    return vector;
+}
+
+QualityVector QualitySolver::minimum() const {
+    int smallest = (int)(std::min_element(renderScales.begin(), renderScales.end()) - renderScales.begin());
+    QualityVector vector = {smallest, 0, ShadingModel::Unlit, 3, kFpsCaps[0], 0};
+    return vector;
+}
+
+QualityVector QualitySolver::solve(BudgetMode mode, float budget, float targetFps) const {
+    float limit = budget * estimateCost(maximum(), mode, targetFps) * 1.0001f;
+    QualityVector best = minimum();
+    float bestScore = -1.0f, bestCost = 0.0f;
+
+    // Post effects add their own cost and score whatever the other knobs are, so instead of
+    // multiplying the search by their 16 subsets, the subsets are ranked once (best score,
+    // then cheapest) and each vector of the other knobs takes the first one that fits
+    std::vector<uint32_t> postSubsets;
+    auto subsetMs = [this](uint32_t post) {
+        float ms = 0.0f;
+        for (int bit = QualityEffect::kFirstPost; bit < QualityEffect::kCount; bit++) {
+            if (post & (1u << bit)) ms += costs.effectMs[bit];
+        }
+        return ms;
+    };
+    auto subsetScore = [](uint32_t post) {
+        float score = 0.0f;
+        for (int i = 0; i < kPostCount; i++) {
+            if (post & (1u << (QualityEffect::kFirstPost + i))) score += kPostScore[i];
+        }
+        return score;
+    };
+    for (uint32_t subset = 0; subset < (1u << kPostCount); subset++) {
+        postSubsets.push_back(subset << QualityEffect::kFirstPost);
+    }
+    std::stable_sort(postSubsets.begin(), postSubsets.end(), [&](uint32_t a, uint32_t b) {
+        float scoreA = subsetScore(a), scoreB = subsetScore(b);
+        return scoreA != scoreB ? scoreA > scoreB : subsetMs(a) < subsetMs(b);
+    });
+
+    QualityVector candidate;
+    for (candidate.scaleTier = 0; candidate.scaleTier < (int)renderScales.size(); candidate.scaleTier++) {
+        for (int samples : kSampleCounts) {
+            if (samples > maxSamples) continue;
+            candidate.msaaSamples = samples;
+            for (int shading = 0; shading < 3; shading++) {
+                candidate.shading = (ShadingModel)shading;
+                for (candidate.meshLOD = 0; candidate.meshLOD < 4; candidate.meshLOD++) {
+                    for (float cap : kFpsCaps) {
+                        // A cap at or above the target is the same vector as uncapped
+                        if (cap > 0.0f && targetFps > 0.0f && cap >= targetFps) continue;
+                        candidate.fpsCap = cap;
+                        for (uint32_t effects = 0; effects < (1u << QualityEffect::kFirstPost); effects++) {
+                            // Temporal upsampling replaces the present path and the checkerboard
+                            if ((effects & QualityEffect::TemporalUpsample) &&
+                                (effects & (QualityEffect::SpatialUpscale | QualityEffect::Checkerboard))) {
+                                continue;
+                            }
+                            candidate.effects = effects;
+                            float fps = frameRate(candidate, targetFps);
+                            float baseMs = estimateFrameMs(candidate);
+                            float baseScore = score(candidate, targetFps);
+
+                            for (uint32_t post : postSubsets) {
+                                // Added bit by bit, in the order estimateFrameMs() and score() do
+                                float ms = baseMs, candidateScore = baseScore;
+                                for (int i = 0; i < kPostCount; i++) {
+                                    int bit = QualityEffect::kFirstPost + i;
+                                    if (!(post & (1u << bit))) continue;
+                                    ms += costs.effectMs[bit];
+                                    candidateScore += kPostScore[i];
+                                }
+                                // Must fit the budget and its own frame interval
+                                if (ms > 1000.0f / fps) continue;
+                                float cost = mode == BudgetMode::Power ? ms * fps : ms;
+                                if (cost > limit) continue;
+
+                                if (candidateScore > bestScore || (candidateScore == bestScore && cost < bestCost)) {
+                                    best = candidate;
+                                    best.effects = effects | post;
+                                    bestScore = candidateScore;
+                                    bestCost = cost;
+                                }
+                                break;  // Later subsets score no higher
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+std::string QualitySolver::toString(const QualityVector& vector) const {
+    static const char* const kShadingNames[3] = {"Unlit", "Lambert", "Phong"};
+    std::ostringstream out;
+    out << (int)std::lround(renderScales[vector.scaleTier] * 100.0f) << "% | ";
+    if (vector.msaaSamples > 0) {
+        out << vector.msaaSamples << "x MSAA | ";
+    } else {
+        out << "no MSAA | ";
+    }
+    out << kShadingNames[(int)vector.shading] << " | LOD " << vector.meshLOD << " | ";
+    if (vector.fpsCap > 0.0f) {
+        out << (int)vector.fpsCap << " FPS cap | ";
+    } else {
+        out << "uncapped | ";
+    }
+    out << QualityEffect::toString(vector.effects);
+    return out.str();
+}
@@ -0,0 +1,229 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/QualityTiers.h"
+#include <algorithm>
+#include <cctype>
+
+namespace {
+    // The legacy per-tier shaders, now über-shader variants
+    struct NamedProgram { const char* name; uint32_t features; bool wireframe; };
+    const NamedProgram kNamedPrograms[] = {
+        {"unlit",     ShaderFeature::VertexColors, false},
+        {"wireframe", ShaderFeature::VertexColors, true},
+        {"flat",      ShaderFeature::VertexColors | ShaderFeature::Diffuse, false},
+        {"smooth",    ShaderFeature::VertexColors | ShaderFeature::Diffuse | ShaderFeature::Specular |
+                      ShaderFeature::Attenuation, false},
+    };
+
+    std::string lowercase(std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+        return text;
+    }
+
+    QualityTier makeTier(const char* name, float scale, const char* program, bool simple, float pixelSize,
+                         int meshLOD, bool checkerboard, int samples, int shadowMapSize, int shadowPCF,
+                         uint32_t postEffects, float fpsCap, float budget) {
+        QualityTier tier;
+        tier.name = name;
+        tier.renderScale = scale;
+        tier.program = program;
+        tier.simpleGeometry = simple;
+        tier.pixelSize = pixelSize;
+        tier.meshLOD = meshLOD;
+        tier.checkerboard = checkerboard;
+        tier.msaaSamples = samples;
+        tier.shadowMapSize = shadowMapSize;
+        tier.shadowPCF = shadowPCF;
+        tier.postEffects = postEffects;
+        tier.fpsCap = fpsCap;
+        tier.budget = budget;
+        return tier;
+    }
+}
+
+// QualityTier implementation
+int QualityTier::renderWidth() const {
+    return std::max(1, (int)std::lround(QualityTierRegistry::kOutputWidth * renderScale));
+}
+
+int QualityTier::renderHeight() const {
+    return std::max(1, (int)std::lround(QualityTierRegistry::kOutputHeight * renderScale));
+}
+
+// QualityTierRegistry implementation
+const char* const QualityTierRegistry::kDefaultPath = "quality_tiers.cfg";
+
+QualityTierRegistry::QualityTierRegistry() {
+    // Under load, a steady 30 beats an erratic 40-60; the high tier only has the user's target
+    const uint32_t kMediumPost = QualityEffect::ToneMap | QualityEffect::Vignette;
+    tiers.push_back(makeTier("Low",    0.5f,  "unlit",  true,  32.0f,  3, false, 0, 0,    0, 0,
+                             30.0f, 0.1f));
+    tiers.push_back(makeTier("Medium", 0.75f, "flat",   false, 64.0f,  1, true,  2, 1024, 0, kMediumPost,
+                             45.0f, 0.4f));
+    tiers.push_back(makeTier("High",   1.0f,  "smooth", false, 200.0f, 0, false, 4, 2048, 2, QualityEffect::kPost,
+                             0.0f,  1.0f));
+    for (QualityTier& tier : tiers) {
+        resolveProgram(tier);
+        resolveShadows(tier);
+    }
+}
+
+bool QualityTierRegistry::resolveProgram(QualityTier& tier) {
+    for (const NamedProgram& named : kNamedPrograms) {
+        if (tier.program == named.name) {
+            tier.shaderFeatures = named.features;
+            tier.wireframe = named.wireframe;
+            return true;
+        }
+    }
+    tier.wireframe = false;
+    // Instanced and motion vectors are added per frame, shadows from shadowMap
+    const uint32_t kDerived = ShaderFeature::Instanced | ShaderFeature::MotionVectors | ShaderFeature::Shadows;
+    return ShaderFeature::fromString(tier.program, tier.shaderFeatures) && !(tier.shaderFeatures & kDerived);
+}
+
+void QualityTierRegistry::resolveShadows(QualityTier& tier) {
+    // Shadows only darken the diffuse and specular terms, so unlit programs skip the pass
+    bool lit = (tier.shaderFeatures & (ShaderFeature::Diffuse | ShaderFeature::Specular)) != 0;
+    if (tier.shadowMapSize > 0 && lit) {
+        tier.shaderFeatures |= ShaderFeature::Shadows;
+    } else {
+        tier.shaderFeatures &= ~ShaderFeature::Shadows;
+        tier.shadowMapSize = 0;
+    }
+}
+
+bool QualityTierRegistry::load(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) return false;
+
+    std::vector<QualityTier> loaded;
+    int lineNumber = 0;
+    std::string line;
+    auto fail = [&](const std::string& message) {
+        std::cerr << "[TIERS] " << path << ":" << lineNumber << ": " << message << "; keeping the current tiers"
+                  << std::endl;
+        return false;
+    };
+    while (std::getline(file, line)) {
+        lineNumber++;
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line[start] == '#') continue;
+        line = line.substr(start, line.find_last_not_of(" \t\r") - start + 1);
+        if (line[0] == '[') {
+            if (line.back() != ']' || line.size() < 3) return fail("malformed section header");
+            QualityTier tier;
+            tier.name = line.substr(1, line.size() - 2);
+            loaded.push_back(tier);
+            continue;
+        }
+        if (loaded.empty()) return fail("key outside a [tier] section");
+
+        QualityTier& tier = loaded.back();
+        std::istringstream fields(line);
+        std::string key, text;
+        fields >> key;
+        if (key == "scale") {
+            fields >> tier.renderScale;
+            if (!(tier.renderScale > 0.0f && tier.renderScale <= 1.0f)) return fail("scale must be in (0, 1]");
+        } else if (key == "program") {
+            fields >> tier.program;
+            if (!resolveProgram(tier)) return fail("unknown program '" + tier.program + "'");
+        } else if (key == "geometry") {
+            fields >> text;
+            if (text != "simple" && text != "indexed") return fail("geometry must be simple or indexed");
+            tier.simpleGeometry = text == "simple";
+        } else if (key == "pixelSize") {
+            fields >> tier.pixelSize;
+        } else if (key == "present") {
+            fields >> tier.present;
+        } else if (key == "meshLOD") {
+            fields >> tier.meshLOD;
+            tier.meshLOD = std::max(0, tier.meshLOD);
+        } else if (key == "checkerboard") {
+            fields >> tier.checkerboard;
+        } else if (key == "msaa") {
+            fields >> tier.msaaSamples;
+            if (tier.msaaSamples != 0 && tier.msaaSamples != 2 && tier.msaaSamples != 4 && tier.msaaSamples != 8) {
+                return fail("msaa must be 0, 2, 4 or 8");
+            }
+        } else if (key == "shadowMap") {
+            fields >> tier.shadowMapSize;
+            if (tier.shadowMapSize != 0 && (tier.shadowMapSize < ShadowMapRenderer::kMinSize ||
+                                            tier.shadowMapSize > ShadowMapRenderer::kMaxSize)) {
+                return fail("shadowMap must be 0 or " + std::to_string(ShadowMapRenderer::kMinSize) + "-" +
+                            std::to_string(ShadowMapRenderer::kMaxSize));
+            }
+        } else if (key == "shadowPCF") {
+            fields >> tier.shadowPCF;
+            if (tier.shadowPCF < 0 || tier.shadowPCF > ShadowMapRenderer::kMaxPcfRadius) {
+                return fail("shadowPCF must be 0-" + std::to_string(ShadowMapRenderer::kMaxPcfRadius));
+            }
+        } else if (key == "post") {
+            fields >> text;
+            if (!QualityEffect::fromString(text, tier.postEffects) || (tier.postEffects & ~QualityEffect::kPost)) {
+                return fail("post must be NONE or BLOOM, TONE_MAP, COLOR_GRADE and VIGNETTE joined by '|'");
+            }
+        } else if (key == "fpsCap") {
+            fields >> tier.fpsCap;
+        } else if (key == "budget") {
+            fields >> tier.budget;
+        } else {
+            return fail("unknown key '" + key + "'");
+        }
+        if (fields.fail()) return fail("missing or malformed value for '" + key + "'");
+    }
+
+    if (loaded.empty()) {
+        lineNumber = 0;
+        return fail("no tiers");
+    }
+    if ((int)loaded.size() > kMaxTiers) {
+        lineNumber = 0;
+        return fail("more than " + std::to_string(kMaxTiers) + " tiers");
+    }
+    for (QualityTier& tier : loaded) {
+        if (tier.shaderFeatures == 0) resolveProgram(tier);  // No 'program' line: the default
+        resolveShadows(tier);
+    }
+    tiers = loaded;
+    return true;
+}
+
+int QualityTierRegistry::find(const std::string& name) const {
+    for (int index = 0; index < size(); index++) {
+        if (lowercase(tiers[index].name) == lowercase(name)) return index;
+    }
+    return -1;
+}
+
+int QualityTierRegistry::clamp(int index) const {
+    return std::max(0, std::min(size() - 1, index));
+}
+
+int QualityTierRegistry::selectForBudget(float budget) const {
+    // With the controller's budget piecewise linear in the estimated power, the midpoints
+    // between neighbouring budgets fall where compute_quality's power thresholds do
+    int best = 0;
+    for (int index = 1; index < size(); index++) {
+        float distance = std::fabs(tiers[index].budget - budget);
+        float bestDistance = std::fabs(tiers[best].budget - budget);
+        if (distance < bestDistance || (distance == bestDistance && tiers[index].budget > tiers[best].budget)) {
+            best = index;
+        }
+    }
+    return best;
+}
+
+int QualityTierRegistry::highest() const {
+    int best = 0;
+    for (int index = 1; index < size(); index++) {
+        if (tiers[index].renderScale >= tiers[best].renderScale) best = index;
+    }
+    return best;
+}
+
+std::vector<float> QualityTierRegistry::getRenderScales() const {
+    std::vector<float> scales;
+    for (const QualityTier& tier : tiers) scales.push_back(tier.renderScale);
+    return scales;
+}
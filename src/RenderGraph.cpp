@@ -0,0 +1,272 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/RenderGraph.h"
+
+namespace {
+    size_t bytesPerPixel(GLenum format) {
+        switch (format) {
+            case GL_R8: return 1;
+            case GL_RG8: case GL_R16F: return 2;
+            case GL_RG16F: case GL_R32F: return 4;
+            case GL_RGBA16F: return 8;
+            case GL_RGBA32F: return 16;
+            default: return 4;
+        }
+    }
+
+    GLenum baseFormat(GLenum format) {
+        switch (format) {
+            case GL_R8: case GL_R16F: case GL_R32F: return GL_RED;
+            case GL_RG8: case GL_RG16F: return GL_RG;
+            default: return GL_RGBA;
+        }
+    }
+}
+
+// RenderTargetDesc implementation
+bool RenderTargetDesc::operator==(const RenderTargetDesc& other) const {
+    return width == other.width && height == other.height && format == other.format && filter == other.filter;
+}
+
+// RenderGraph implementation
+void RenderGraph::initialize() {
+    timestampsSupported = GLEW_ARB_timer_query || GLEW_VERSION_3_3;
+    if (!timestampsSupported) {
+        std::cout << "[GRAPH] Timestamp queries unsupported; passes are not timed" << std::endl;
+    }
+}
+
+void RenderGraph::reset() {
+    resources.clear();
+    passes.clear();
+}
+
+RenderGraph::Resource RenderGraph::importTarget(const std::string& name, GLuint texture, GLuint framebuffer) {
+    ResourceNode node = {name, false, RenderTargetDesc(), texture, framebuffer, false, 0, -1, -1, -1};
+    resources.push_back(node);
+    return (Resource)resources.size() - 1;
+}
+
+RenderGraph::Resource RenderGraph::createTarget(const std::string& name, const RenderTargetDesc& desc) {
+    ResourceNode node = {name, true, desc, 0, 0, false, 0, -1, -1, -1};
+    resources.push_back(node);
+    return (Resource)resources.size() - 1;
+}
+
+void RenderGraph::markOutput(Resource resource) {
+    resources[resource].output = true;
+}
+
+void RenderGraph::addPass(const std::string& name, const std::vector<Resource>& reads,
+                          const std::vector<Resource>& writes, std::function<void()> execute, bool sideEffect) {
+    PassNode pass;
+    pass.name = name;
+    for (Resource resource : reads) {
+        if (resource != kNone) pass.reads.push_back(resource);
+    }
+    for (Resource resource : writes) {
+        if (resource != kNone) pass.writes.push_back(resource);
+    }
+    pass.execute = std::move(execute);
+    pass.sideEffect = sideEffect;
+    pass.liveWrites = 0;
+    pass.culled = false;
+    passes.push_back(std::move(pass));
+}
+
+void RenderGraph::compile() {
+    // Reference counts: a resource is live while a live pass reads it (or it is an output),
+    // a pass while one of its writes is live
+    for (ResourceNode& resource : resources) {
+        resource.readers = resource.output ? 1 : 0;
+        resource.firstPass = resource.lastPass = -1;
+    }
+    for (PassNode& pass : passes) {
+        pass.liveWrites = (int)pass.writes.size();
+        pass.culled = false;
+        for (Resource read : pass.reads) resources[read].readers++;
+    }
+
+    // Flood from the unread resources back through their writers
+    std::vector<Resource> unread;
+    for (int i = 0; i < (int)resources.size(); i++) {
+        if (resources[i].readers == 0) unread.push_back(i);
+    }
+    auto cull = [&](PassNode& pass) {
+        pass.culled = true;
+        for (Resource read : pass.reads) {
+            if (--resources[read].readers == 0) unread.push_back(read);
+        }
+    };
+    for (PassNode& pass : passes) {
+        if (pass.liveWrites == 0 && !pass.sideEffect) cull(pass);
+    }
+    while (!unread.empty()) {
+        Resource resource = unread.back();
+        unread.pop_back();
+        for (PassNode& pass : passes) {
+            if (pass.culled || pass.sideEffect) continue;
+            for (Resource write : pass.writes) {
+                if (write == resource && --pass.liveWrites == 0) cull(pass);
+            }
+        }
+    }
+
+    // Lifetimes of the transient targets over the live passes
+    for (int index = 0; index < (int)passes.size(); index++) {
+        const PassNode& pass = passes[index];
+        if (pass.culled) continue;
+        for (const std::vector<Resource>* list : {&pass.reads, &pass.writes}) {
+            for (Resource resource : *list) {
+                ResourceNode& node = resources[resource];
+                if (node.firstPass < 0) node.firstPass = index;
+                node.lastPass = index;
+            }
+        }
+    }
+}
+
+int RenderGraph::acquire(const RenderTargetDesc& desc) {
+    for (int i = 0; i < (int)pool.size(); i++) {
+        PoolEntry& entry = pool[i];
+        if (entry.inUse || !(entry.desc == desc)) continue;
+        if (entry.lastUsedFrame == frame) aliasedTargets++;  // An earlier target this frame held it
+        entry.inUse = true;
+        entry.lastUsedFrame = frame;
+        return i;
+    }
+
+    PoolEntry entry;
+    entry.desc = desc;
+    glGenTextures(1, &entry.texture);
+    glBindTexture(GL_TEXTURE_2D, entry.texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, desc.format, desc.width, desc.height, 0, baseFormat(desc.format), GL_FLOAT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, desc.filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, desc.filter);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glGenFramebuffers(1, &entry.framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, entry.framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, entry.texture, 0);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "[GRAPH] Transient target " << desc.width << "x" << desc.height << " is not complete!" << std::endl;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    checkGLError("Render graph target allocation");
+    entry.inUse = true;
+    entry.lastUsedFrame = frame;
+    pool.push_back(entry);
+    if (g_verbose) {
+        std::cout << "[GRAPH] Pooled target " << desc.width << "x" << desc.height << " (" << pool.size()
+                  << " in pool)" << std::endl;
+    }
+    return (int)pool.size() - 1;
+}
+
+void RenderGraph::collectTimings(TimingSlot& slot) {
+    if (slot.issued == 0) return;
+    // FrameQueue retired the slot, so this only fails if it was executed outside the queue
+    GLuint available = GL_FALSE;
+    glGetQueryObjectuiv(slot.queries[2 * slot.issued - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return;
+    passMs.clear();
+    for (int i = 0; i < slot.issued; i++) {
+        GLuint64 start = 0, end = 0;
+        glGetQueryObjectui64v(slot.queries[2 * i], GL_QUERY_RESULT, &start);
+        glGetQueryObjectui64v(slot.queries[2 * i + 1], GL_QUERY_RESULT, &end);
+        float ms = (end - start) / 1000000.0f;
+        passMs[slot.passNames[i]] += ms;
+    }
+    for (const auto& entry : passMs) lastKnownMs[entry.first] = entry.second;
+    slot.issued = 0;
+}
+
+void RenderGraph::trimPool() {
+    for (int i = (int)pool.size() - 1; i >= 0; i--) {
+        if (frame - pool[i].lastUsedFrame < kPoolRetainFrames) continue;
+        glDeleteFramebuffers(1, &pool[i].framebuffer);
+        glDeleteTextures(1, &pool[i].texture);
+        pool.erase(pool.begin() + i);
+    }
+}
+
+void RenderGraph::execute(int slot) {
+    frame++;
+    aliasedTargets = 0;
+    trimPool();
+    if (slot >= (int)timingSlots.size()) timingSlots.resize(slot + 1);
+    TimingSlot& timing = timingSlots[slot];
+    collectTimings(timing);
+    timing.passNames.clear();
+
+    for (int index = 0; index < (int)passes.size(); index++) {
+        PassNode& pass = passes[index];
+        if (pass.culled) continue;
+        for (ResourceNode& resource : resources) {
+            if (!resource.transient || resource.firstPass != index) continue;
+            resource.poolEntry = acquire(resource.desc);
+            resource.texture = pool[resource.poolEntry].texture;
+            resource.framebuffer = pool[resource.poolEntry].framebuffer;
+        }
+
+        int query = (int)timing.passNames.size();
+        if (timestampsSupported) {
+            while ((int)timing.queries.size() < 2 * (query + 1)) {
+                GLuint id = 0;
+                glGenQueries(1, &id);
+                timing.queries.push_back(id);
+            }
+            glQueryCounter(timing.queries[2 * query], GL_TIMESTAMP);
+        }
+        pass.execute();
+        if (timestampsSupported) {
+            glQueryCounter(timing.queries[2 * query + 1], GL_TIMESTAMP);
+        }
+        timing.passNames.push_back(pass.name);
+
+        // Targets whose last user this was go back to the pool for the passes after it
+        for (ResourceNode& resource : resources) {
+            if (!resource.transient || resource.lastPass != index) continue;
+            pool[resource.poolEntry].inUse = false;
+            resource.texture = resource.framebuffer = 0;
+            resource.poolEntry = -1;
+        }
+    }
+    timing.issued = timestampsSupported ? (int)timing.passNames.size() : 0;
+}
+
+float RenderGraph::getPassMs(const std::string& name) const {
+    auto found = passMs.find(name);
+    return found != passMs.end() ? found->second : 0.0f;
+}
+
+std::vector<RenderGraph::PassInfo> RenderGraph::describe() const {
+    std::vector<PassInfo> info;
+    for (const PassNode& pass : passes) {
+        auto found = lastKnownMs.find(pass.name);
+        info.push_back({pass.name, pass.culled, found != lastKnownMs.end() ? found->second : 0.0f});
+    }
+    return info;
+}
+
+size_t RenderGraph::getPoolBytes() const {
+    size_t bytes = 0;
+    for (const PoolEntry& entry : pool) {
+        bytes += (size_t)entry.desc.width * entry.desc.height * bytesPerPixel(entry.desc.format);
+    }
+    return bytes;
+}
+
+void RenderGraph::cleanup() {
+    for (PoolEntry& entry : pool) {
+        glDeleteFramebuffers(1, &entry.framebuffer);
+        glDeleteTextures(1, &entry.texture);
+    }
+    pool.clear();
+    for (TimingSlot& slot : timingSlots) {
+        if (!slot.queries.empty()) glDeleteQueries((GLsizei)slot.queries.size(), slot.queries.data());
+    }
+    timingSlots.clear();
+    passMs.clear();
+    lastKnownMs.clear();
+    reset();
+}
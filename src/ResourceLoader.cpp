@@ -0,0 +1,215 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/ResourceLoader.h"
+#define STB_IMAGE_IMPLEMENTATION
+#include "../include/stb_image.h"
+
+// ResourceLoader implementation
+const char* ResourceLoader::getModeName(Mode mode) {
+    switch (mode) {
+        case Mode::LoaderThread: return "shared-context loader thread";
+        default: return "render thread, one job per frame";
+    }
+}
+
+bool ResourceLoader::start(GLFWwindow* mainWindow) {
+    // GLFW windows must be created on the main thread; the loader thread only makes it current
+    loaderContext = createGLWindow(1, 1, "Resource loader", false, GLEW_VERSION_4_3, mainWindow);
+    glfwMakeContextCurrent(mainWindow);
+    if (!loaderContext) {
+        std::cerr << "[LOADER] Failed to create a shared context, loading on the render thread" << std::endl;
+        return false;
+    }
+
+    mode = Mode::LoaderThread;
+    running = true;
+    loaderThread = std::thread(&ResourceLoader::loaderLoop, this);
+    std::cout << "[LOADER] Loading resources on a " << getModeName(mode) << std::endl;
+    return true;
+}
+
+void ResourceLoader::stop() {
+    if (mode == Mode::LoaderThread) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            running = false;
+        }
+        loaderWake.notify_all();
+        if (loaderThread.joinable()) loaderThread.join();
+        glfwDestroyWindow(loaderContext);
+        loaderContext = nullptr;
+        mode = Mode::Synchronous;
+
+        // Hand over what was loaded, so its owners can release it like everything else
+        while (!loaded.empty()) {
+            LoadedJob job = std::move(loaded.front());
+            loaded.pop_front();
+            if (job.fence) glClientWaitSync(job.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+            finish(job);
+        }
+    }
+
+    if (!queued.empty()) {
+        std::cout << "[LOADER] Dropped " << queued.size() << " job(s) that never started" << std::endl;
+    }
+    for (Job& job : queued) {
+        job.finish(false);
+        unfinished.erase(job.ticket);
+    }
+    queued.clear();
+}
+
+ResourceLoader::Ticket ResourceLoader::submit(const std::string& name, LoadStep load, FinishStep finish) {
+    Ticket ticket = nextTicket++;
+    unfinished.insert(ticket);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queued.push_back({ticket, name, std::move(load), std::move(finish)});
+    }
+    loaderWake.notify_one();
+    return ticket;
+}
+
+ResourceLoader::Ticket ResourceLoader::loadTexture(const std::string& path, GLuint& texture) {
+    std::shared_ptr<GLuint> loaded = std::make_shared<GLuint>(0);
+    std::shared_ptr<std::string> error = std::make_shared<std::string>();
+    return submit("texture " + path, [path, loaded, error]() {
+        int width, height, channels;
+        stbi_uc* pixels = stbi_load(path.c_str(), &width, &height, &channels, 4);
+        if (!pixels) {
+            *error = stbi_failure_reason();
+            return false;
+        }
+        glGenTextures(1, loaded.get());
+        glBindTexture(GL_TEXTURE_2D, *loaded);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);  // RGBA rows are always 4-byte aligned
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        glGenerateMipmap(GL_TEXTURE_2D);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        stbi_image_free(pixels);
+        return true;
+    }, [path, loaded, error, &texture](bool success) {
+        if (!success) {
+            std::cerr << "[LOADER] Cannot read " << path << ": " << *error << std::endl;
+            return;
+        }
+        if (texture) glDeleteTextures(1, &texture);
+        texture = *loaded;
+    });
+}
+
+void ResourceLoader::loaderLoop() {
+    glfwMakeContextCurrent(loaderContext);
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            loaderWake.wait(lock, [this] { return !running || !queued.empty(); });
+            if (!running) break;
+            job = std::move(queued.front());
+            queued.pop_front();
+        }
+        LoadedJob result = runLoad(job);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            loaded.push_back(std::move(result));
+        }
+        jobLoaded.notify_all();
+    }
+    glfwMakeContextCurrent(nullptr);
+}
+
+ResourceLoader::LoadedJob ResourceLoader::runLoad(Job& job) {
+    auto loadStart = std::chrono::steady_clock::now();
+    bool success = job.load();
+    // The render thread finishes the job only after this fence signals, i.e. once the driver
+    // has completed the uploads and compiles issued in the loader's context
+    GLsync fence = nullptr;
+    if (mode == Mode::LoaderThread) {
+        fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+    }
+    float loadMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+    return {job.ticket, job.name, std::move(job.finish), success, fence, loadMs};
+}
+
+void ResourceLoader::finish(LoadedJob& job) {
+    if (job.fence) glDeleteSync(job.fence);
+    job.finish(job.success);
+    unfinished.erase(job.ticket);
+    finishedJobs++;
+    if (!job.success) {
+        std::cerr << "[LOADER] Failed to load " << job.name << std::endl;
+    } else if (g_verbose) {
+        std::cout << "[LOADER] " << job.name << " ready (" << job.loadMs << " ms"
+                  << (mode == Mode::LoaderThread ? " off the frame)" : " on the render thread)") << std::endl;
+    }
+}
+
+int ResourceLoader::update() {
+    if (mode == Mode::Synchronous) {
+        if (queued.empty()) return 0;
+        Job job = std::move(queued.front());
+        queued.pop_front();
+        LoadedJob result = runLoad(job);
+        finish(result);
+        return 1;
+    }
+
+    // Finish in load order; stop at the first fence still pending
+    int finished = 0;
+    while (true) {
+        LoadedJob job;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (loaded.empty()) break;
+            GLsync fence = loaded.front().fence;
+            if (fence && glClientWaitSync(fence, 0, 0) == GL_TIMEOUT_EXPIRED) break;
+            job = std::move(loaded.front());
+            loaded.pop_front();
+        }
+        finish(job);
+        finished++;
+    }
+    return finished;
+}
+
+void ResourceLoader::wait(Ticket ticket) {
+    while (!isFinished(ticket)) {
+        std::unique_lock<std::mutex> lock(mutex);
+        for (auto it = queued.begin(); it != queued.end(); ++it) {
+            if (it->ticket != ticket) continue;
+            if (it != queued.begin()) {
+                Job job = std::move(*it);
+                queued.erase(it);
+                queued.push_front(std::move(job));
+            }
+            break;
+        }
+
+        if (mode == Mode::Synchronous) {
+            if (queued.empty()) return;
+            Job job = std::move(queued.front());
+            queued.pop_front();
+            lock.unlock();
+            LoadedJob result = runLoad(job);
+            finish(result);
+            continue;
+        }
+
+        // Whatever the loader finishes first (an earlier job, or the one in its load step)
+        jobLoaded.wait(lock, [this] { return !loaded.empty(); });
+        LoadedJob job = std::move(loaded.front());
+        loaded.pop_front();
+        lock.unlock();
+        if (job.fence) glClientWaitSync(job.fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        finish(job);
+    }
+}
+
+void ResourceLoader::waitIdle() {
+    while (!unfinished.empty()) {
+        wait(*unfinished.begin());
+    }
+}
@@ -0,0 +1,308 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/ShaderHotReload.h"
+#include <cerrno>
+#include <cstring>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+// ShaderHotReloader implementation
+const char* ShaderHotReloader::getModeName(Mode mode) {
+    switch (mode) {
+        case Mode::ParallelCompile: return "parallel shader compile";
+        case Mode::LoaderThread: return "shared-context loader thread";
+        default: return "disabled";
+    }
+}
+
+bool ShaderHotReloader::start(GLFWwindow* mainWindow, const std::string& shaderDirectory) {
+#ifdef __linux__
+    directory = shaderDirectory;
+    inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    // Editors either rewrite in place (close-after-write) or save to a temp file and rename
+    if (inotifyFd < 0 || inotify_add_watch(inotifyFd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+        std::cerr << "[HOT RELOAD] Cannot watch " << directory << ": " << std::strerror(errno) << std::endl;
+        if (inotifyFd >= 0) close(inotifyFd);
+        inotifyFd = -1;
+        return false;
+    }
+
+    if (GLEW_KHR_parallel_shader_compile || GLEW_ARB_parallel_shader_compile) {
+        // Let the driver choose how many compiler threads to use
+        if (GLEW_KHR_parallel_shader_compile) {
+            glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+        } else {
+            glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+        }
+        mode = Mode::ParallelCompile;
+    } else {
+        // GLFW windows must be created on the main thread; the loader thread only makes it current
+        loaderContext = createGLWindow(1, 1, "Shader loader", false, GLEW_VERSION_4_3, mainWindow);
+        glfwMakeContextCurrent(mainWindow);
+        if (!loaderContext) {
+            std::cerr << "[HOT RELOAD] Failed to create a shared context, shader hot-reload disabled" << std::endl;
+            close(inotifyFd);
+            inotifyFd = -1;
+            return false;
+        }
+        mode = Mode::LoaderThread;
+    }
+
+    running = true;
+    watcherThread = std::thread(&ShaderHotReloader::watcherLoop, this);
+    if (mode == Mode::LoaderThread) {
+        loaderThread = std::thread(&ShaderHotReloader::loaderLoop, this);
+    }
+    std::cout << "[HOT RELOAD] Watching " << directory << "/ for " << programs.size()
+              << " programs (" << getModeName(mode) << ")" << std::endl;
+    return true;
+#else
+    (void)mainWindow;
+    (void)shaderDirectory;
+    std::cout << "[HOT RELOAD] inotify unavailable on this platform, shader hot-reload disabled" << std::endl;
+    return false;
+#endif
+}
+
+void ShaderHotReloader::stop() {
+    if (mode == Mode::Disabled) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    loaderWake.notify_all();
+    if (watcherThread.joinable()) watcherThread.join();
+    if (loaderThread.joinable()) loaderThread.join();
+    if (loaderContext) {
+        glfwDestroyWindow(loaderContext);
+        loaderContext = nullptr;
+    }
+
+    for (const ReadyProgram& program : ready) {
+        if (program.fence) glDeleteSync(program.fence);
+        glDeleteProgram(program.program);
+    }
+    for (const PendingBuild& build : inFlight) {
+        glDeleteProgram(build.program);
+        glDeleteShader(build.vertexShader);
+        glDeleteShader(build.fragmentShader);
+    }
+    ready.clear();
+    inFlight.clear();
+    dirty.clear();
+#ifdef __linux__
+    close(inotifyFd);
+#endif
+    inotifyFd = -1;
+    mode = Mode::Disabled;
+}
+
+void ShaderHotReloader::watch(GLuint* handle, const std::string& vertexPath, const std::string& fragmentPath,
+                              const std::string& defines, const std::string& variantName) {
+    std::string name = vertexPath + " + " + fragmentPath;
+    if (!variantName.empty()) name += " [" + variantName + "]";
+    std::lock_guard<std::mutex> lock(programsMutex);
+    programs.push_back({handle, vertexPath, fragmentPath, defines, name});
+}
+
+void ShaderHotReloader::unwatch(GLuint* handle) {
+    // Entries stay in place (builds in flight refer to them by index); a null handle drops
+    // any build that completes later
+    std::lock_guard<std::mutex> lock(programsMutex);
+    for (WatchedProgram& watched : programs) {
+        if (watched.handle == handle) watched.handle = nullptr;
+    }
+}
+
+ShaderHotReloader::WatchedProgram ShaderHotReloader::getProgram(size_t index) {
+    std::lock_guard<std::mutex> lock(programsMutex);
+    return programs[index];
+}
+
+void ShaderHotReloader::watcherLoop() {
+#ifdef __linux__
+    alignas(inotify_event) char buffer[4096];
+    std::set<std::string> changed;
+    while (running) {
+        // Once a change arrives, wait for a quiet 50 ms so multi-step saves land as one rebuild
+        pollfd descriptor = {inotifyFd, POLLIN, 0};
+        if (poll(&descriptor, 1, changed.empty() ? 200 : 50) > 0) {
+            ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+            for (ssize_t offset = 0; offset < length;) {
+                const inotify_event* event = (const inotify_event*)(buffer + offset);
+                if (event->len > 0) changed.insert(directory + "/" + event->name);
+                offset += sizeof(inotify_event) + event->len;
+            }
+            continue;
+        }
+        if (changed.empty()) continue;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        std::lock_guard<std::mutex> programsLock(programsMutex);
+        for (size_t i = 0; i < programs.size(); i++) {
+            if (!programs[i].handle) continue;
+            if (changed.count(programs[i].vertexPath) || changed.count(programs[i].fragmentPath)) {
+                std::cout << "[HOT RELOAD] Rebuilding " << programs[i].name << std::endl;
+                dirty.insert(i);
+            }
+        }
+        changed.clear();
+        loaderWake.notify_one();
+    }
+#endif
+}
+
+void ShaderHotReloader::loaderLoop() {
+    glfwMakeContextCurrent(loaderContext);
+    while (true) {
+        std::set<size_t> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            loaderWake.wait(lock, [this] { return !running || !dirty.empty(); });
+            if (!running) break;
+            batch.swap(dirty);
+        }
+        for (size_t index : batch) {
+            PendingBuild build = startBuild(index);
+            GLuint program = finishBuild(build);
+            if (!program) continue;
+
+            // The render thread swaps only after this fence signals, i.e. once the driver
+            // has finished with the program in this context
+            GLsync fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            glFlush();
+            float buildMs = std::chrono::duration<float, std::milli>(
+                std::chrono::steady_clock::now() - build.startTime).count();
+            std::lock_guard<std::mutex> lock(mutex);
+            ready.push_back({index, program, fence, buildMs});
+        }
+    }
+    glfwMakeContextCurrent(nullptr);
+}
+
+ShaderHotReloader::PendingBuild ShaderHotReloader::startBuild(size_t index) {
+    PendingBuild build = {index, 0, 0, 0, std::chrono::steady_clock::now()};
+    WatchedProgram watched = getProgram(index);
+    std::string vertexSource = ShaderManager::loadShaderSource(watched.vertexPath);
+    std::string fragmentSource = ShaderManager::loadShaderSource(watched.fragmentPath);
+    if (vertexSource.empty() || fragmentSource.empty()) return build;
+    vertexSource = ShaderManager::injectDefines(vertexSource, watched.defines);
+    fragmentSource = ShaderManager::injectDefines(fragmentSource, watched.defines);
+
+    // No status queries here: with parallel compile they would block on the compiler threads
+    const char* vertexText = vertexSource.c_str();
+    const char* fragmentText = fragmentSource.c_str();
+    build.vertexShader = glCreateShader(GL_VERTEX_SHADER);
+    glShaderSource(build.vertexShader, 1, &vertexText, nullptr);
+    glCompileShader(build.vertexShader);
+    build.fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
+    glShaderSource(build.fragmentShader, 1, &fragmentText, nullptr);
+    glCompileShader(build.fragmentShader);
+
+    build.program = glCreateProgram();
+    glAttachShader(build.program, build.vertexShader);
+    glAttachShader(build.program, build.fragmentShader);
+    glLinkProgram(build.program);
+    return build;
+}
+
+GLuint ShaderHotReloader::finishBuild(const PendingBuild& build) {
+    WatchedProgram watched = getProgram(build.index);
+    bool success = build.program != 0;
+    const GLuint shaders[2] = {build.vertexShader, build.fragmentShader};
+    const std::string* paths[2] = {&watched.vertexPath, &watched.fragmentPath};
+    for (int i = 0; i < 2 && success; i++) {
+        GLint compiled = GL_FALSE;
+        glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &compiled);
+        if (!compiled) {
+            GLchar infoLog[1024];
+            glGetShaderInfoLog(shaders[i], 1024, nullptr, infoLog);
+            std::cerr << "[HOT RELOAD] Compilation failed for " << *paths[i] << ":" << std::endl << infoLog << std::endl;
+            success = false;
+        }
+    }
+    if (success) {
+        GLint linked = GL_FALSE;
+        glGetProgramiv(build.program, GL_LINK_STATUS, &linked);
+        if (!linked) {
+            GLchar infoLog[1024];
+            glGetProgramInfoLog(build.program, 1024, nullptr, infoLog);
+            std::cerr << "[HOT RELOAD] Linking failed for " << watched.name << ":" << std::endl << infoLog << std::endl;
+            success = false;
+        }
+    }
+
+    glDeleteShader(build.vertexShader);
+    glDeleteShader(build.fragmentShader);
+    if (!success) {
+        glDeleteProgram(build.program);
+        std::cerr << "[HOT RELOAD] Keeping the previous program" << std::endl;
+        return 0;
+    }
+    return build.program;
+}
+
+int ShaderHotReloader::update() {
+    if (mode == Mode::Disabled) return 0;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (mode == Mode::ParallelCompile) {
+        for (size_t index : dirty) {
+            // A newer edit supersedes a build still in flight for the same program
+            for (auto it = inFlight.begin(); it != inFlight.end();) {
+                if (it->index != index) {
+                    ++it;
+                    continue;
+                }
+                glDeleteProgram(it->program);
+                glDeleteShader(it->vertexShader);
+                glDeleteShader(it->fragmentShader);
+                it = inFlight.erase(it);
+            }
+            inFlight.push_back(startBuild(index));
+        }
+        dirty.clear();
+
+        for (auto it = inFlight.begin(); it != inFlight.end();) {
+            GLint complete = GL_TRUE;
+            if (it->program) glGetProgramiv(it->program, GL_COMPLETION_STATUS_KHR, &complete);
+            if (!complete) {
+                ++it;
+                continue;
+            }
+            GLuint program = finishBuild(*it);
+            if (program) {
+                float buildMs = std::chrono::duration<float, std::milli>(
+                    std::chrono::steady_clock::now() - it->startTime).count();
+                ready.push_back({it->index, program, nullptr, buildMs});
+            }
+            it = inFlight.erase(it);
+        }
+    }
+
+    // Swap in completion order; stop at the first fence still pending so an older build
+    // can never replace a newer one
+    int swapped = 0;
+    while (!ready.empty()) {
+        ReadyProgram& next = ready.front();
+        if (next.fence) {
+            if (glClientWaitSync(next.fence, 0, 0) == GL_TIMEOUT_EXPIRED) break;
+            glDeleteSync(next.fence);
+        }
+        WatchedProgram watched = getProgram(next.index);
+        if (!watched.handle) {
+            glDeleteProgram(next.program);  // Unwatched while it was building
+            ready.erase(ready.begin());
+            continue;
+        }
+        glDeleteProgram(*watched.handle);
+        *watched.handle = next.program;
+        std::cout << "[HOT RELOAD] ✅ Swapped " << watched.name << " (ID: " << next.program
+                  << ", built in " << next.buildMs << " ms off the frame)" << std::endl;
+        ready.erase(ready.begin());
+        swapped++;
+    }
+    return swapped;
+}
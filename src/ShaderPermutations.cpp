@@ -0,0 +1,117 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/ShaderPermutations.h"
+
+namespace {
+    const char* const kFeatureNames[ShaderFeature::kCount] = {
+        "VERTEX_COLORS", "DIFFUSE", "SPECULAR", "ATTENUATION", "INSTANCED", "MOTION_VECTORS", "SHADOWS"
+    };
+}
+
+// ShaderFeature implementation
+std::string ShaderFeature::toDefines(uint32_t features) {
+    std::string defines;
+    for (int bit = 0; bit < kCount; bit++) {
+        if (features & (1u << bit)) {
+            defines += std::string("#define FEATURE_") + kFeatureNames[bit] + "\n";
+        }
+    }
+    return defines;
+}
+
+std::string ShaderFeature::toString(uint32_t features) {
+    std::string name;
+    for (int bit = 0; bit < kCount; bit++) {
+        if (features & (1u << bit)) {
+            if (!name.empty()) name += "|";
+            name += kFeatureNames[bit];
+        }
+    }
+    return name.empty() ? "NONE" : name;
+}
+
+bool ShaderFeature::fromString(const std::string& names, uint32_t& features) {
+    features = 0;
+    std::istringstream parts(names);
+    for (std::string part; std::getline(parts, part, '|');) {
+        int bit = 0;
+        while (bit < kCount && part != kFeatureNames[bit]) bit++;
+        if (bit == kCount) return false;
+        features |= 1u << bit;
+    }
+    return features != 0;
+}
+
+// ShaderPermutations implementation
+GLuint ShaderPermutations::get(uint32_t features) {
+    auto pending = loading.find(features);
+    if (pending != loading.end()) loader->wait(pending->second);
+    auto found = programs.find(features);
+    if (found != programs.end()) return found->second;
+
+    std::cout << "[SHADER] Variant " << ShaderFeature::toString(features) << std::endl;
+    GLuint program = ShaderManager::createShaderProgram(vertexPath, fragmentPath, ShaderFeature::toDefines(features));
+    programs[features] = program;
+    track(features);
+    return program;
+}
+
+void ShaderPermutations::load(uint32_t features, ResourceLoader& resourceLoader) {
+    if (programs.count(features)) return;
+    loader = &resourceLoader;
+    programs[features] = 0;
+    track(features);
+
+    std::shared_ptr<GLuint> built = std::make_shared<GLuint>(0);
+    std::shared_ptr<std::string> errors = std::make_shared<std::string>();
+    std::string vertex = vertexPath, fragment = fragmentPath, defines = ShaderFeature::toDefines(features);
+    loading[features] = loader->submit("variant " + ShaderFeature::toString(features),
+        [built, errors, vertex, fragment, defines]() {
+            // Never the fatal path: exiting here would tear down GL and Python under the render thread
+            *built = ShaderManager::createShaderProgram(vertex, fragment, defines, errors.get());
+            return *built != 0;
+        },
+        [this, features, built, errors](bool success) {
+            loading.erase(features);
+            if (!success) {
+                // The handle stays 0 (nothing is drawn with it); when watched, a fixed source
+                // is swapped in by the hot-reloader
+                std::cerr << "[SHADER] Variant " << ShaderFeature::toString(features) << " failed to build:"
+                          << std::endl << *errors << std::endl;
+                return;
+            }
+            GLuint& handle = programs[features];
+            if (handle) {
+                glDeleteProgram(*built);  // The hot-reloader already swapped in a newer build
+            } else {
+                handle = *built;
+            }
+        });
+}
+
+std::vector<GLuint> ShaderPermutations::getPrograms() const {
+    std::vector<GLuint> result;
+    for (const auto& entry : programs) result.push_back(entry.second);
+    return result;
+}
+
+void ShaderPermutations::track(uint32_t features) {
+    if (!reloader) return;
+    // Map nodes never move, so the handle stays valid until cleanup() unwatches it
+    reloader->watch(&programs[features], vertexPath, fragmentPath, ShaderFeature::toDefines(features),
+                    ShaderFeature::toString(features));
+}
+
+void ShaderPermutations::watch(ShaderHotReloader& hotReloader) {
+    reloader = &hotReloader;
+    for (const auto& entry : programs) track(entry.first);
+}
+
+void ShaderPermutations::cleanup() {
+    // Programs still building would land in the map after it is cleared
+    while (!loading.empty()) loader->wait(loading.begin()->second);
+    for (auto& entry : programs) {
+        if (reloader) reloader->unwatch(&entry.second);
+        glDeleteProgram(entry.second);
+    }
+    programs.clear();
+}
@@ -0,0 +1,90 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/ShadowMap.h"
+
+// ShadowMapRenderer implementation
+bool ShadowMapRenderer::initialize(int mapSize) {
+    depthProgram = ShaderManager::createShaderProgram("shaders/shadow_depth.vert", "shaders/shadow_depth.frag");
+    if (!depthProgram) return false;
+
+    glGenFramebuffers(1, &framebuffer);
+    glGenTextures(1, &depthTexture);
+    resize(mapSize);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, depthTexture, 0);
+    glDrawBuffer(GL_NONE);
+    glReadBuffer(GL_NONE);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        std::cerr << "[SHADOW] Shadow map target is not complete!" << std::endl;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        return false;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    checkGLError("Shadow map initialization");
+    std::cout << "[SHADOW] Shadow map ready (" << size << "x" << size << ")" << std::endl;
+    return true;
+}
+
+void ShadowMapRenderer::resize(int mapSize) {
+    mapSize = std::max(kMinSize, std::min(mapSize, kMaxSize));
+    if (mapSize == size) return;
+    size = mapSize;
+    glBindTexture(GL_TEXTURE_2D, depthTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, size, size, 0, GL_DEPTH_COMPONENT, GL_FLOAT, NULL);
+    // Linear filtering with compare mode gives a bilinear 2x2 PCF per tap on most hardware
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    // Outside the light's frustum is lit
+    const GLfloat border[4] = {1.0f, 1.0f, 1.0f, 1.0f};
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, border);
+    checkGLError("Shadow map resize");
+}
+
+GLuint ShadowMapRenderer::begin(const glm::vec3& lightPos, float sceneRadius) {
+    // Directional light through the origin; the ortho box just encloses the object
+    float distance = glm::length(lightPos);
+    glm::mat4 lightView = glm::lookAt(lightPos, glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 lightProjection = glm::ortho(-sceneRadius, sceneRadius, -sceneRadius, sceneRadius,
+                                           std::max(distance - sceneRadius, 0.1f), distance + sceneRadius);
+    lightSpaceMatrix = lightProjection * lightView;
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, size, size);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    // Slope-scaled offset against acne; the receiver adds a small normal-dependent bias
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(2.0f, 4.0f);
+
+    glUseProgram(depthProgram);
+    glUniformMatrix4fv(glGetUniformLocation(depthProgram, "lightSpaceMatrix"), 1, GL_FALSE,
+                       glm::value_ptr(lightSpaceMatrix));
+    return depthProgram;
+}
+
+void ShadowMapRenderer::end() {
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void ShadowMapRenderer::bindTexture(int unit) const {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_2D, depthTexture);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+void ShadowMapRenderer::watch(ShaderHotReloader& reloader) {
+    reloader.watch(&depthProgram, "shaders/shadow_depth.vert", "shaders/shadow_depth.frag");
+}
+
+void ShadowMapRenderer::cleanup() {
+    if (depthProgram) glDeleteProgram(depthProgram);
+    if (framebuffer) glDeleteFramebuffers(1, &framebuffer);
+    if (depthTexture) glDeleteTextures(1, &depthTexture);
+    depthProgram = framebuffer = depthTexture = 0;
+    size = 0;
+}
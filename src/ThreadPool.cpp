@@ -0,0 +1,95 @@
+#include "../include/ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount) {
+    if (threadCount <= 0) {
+        threadCount = (int)std::thread::hardware_concurrency();
+        if (threadCount <= 0) threadCount = 1;
+    }
+    // Worker 0 is the calling thread, so only spawn threadCount - 1 workers
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wakeCondition.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop(int workerIndex) {
+    unsigned int seenGeneration = 0;
+    while (true) {
+        std::function<void(int)> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wakeCondition.wait(lock, [&] { return stopping || jobGeneration != seenGeneration; });
+            if (stopping) return;
+            seenGeneration = jobGeneration;
+            job = currentJob;
+        }
+
+        job(workerIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--pendingWorkers == 0) {
+                doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::runOnAll(const std::function<void(int)>& job) {
+    if (workers.empty()) {
+        job(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        currentJob = job;
+        pendingWorkers = (int)workers.size();
+        jobGeneration++;
+    }
+    wakeCondition.notify_all();
+
+    // The calling thread does its share instead of idling
+    job(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [&] { return pendingWorkers == 0; });
+    currentJob = nullptr;
+}
+
+void ThreadPool::parallelFor(size_t count, size_t minPerThread, size_t alignment,
+                             const std::function<void(size_t, size_t)>& body) {
+    if (count == 0) return;
+    if (alignment == 0) alignment = 1;
+
+    size_t threads = (size_t)getThreadCount();
+    if (minPerThread > 0) {
+        threads = std::min(threads, std::max<size_t>(1, count / minPerThread));
+    }
+    if (threads <= 1) {
+        body(0, count);
+        return;
+    }
+
+    // Round the per-thread chunk up to the alignment so SIMD loops only see a tail on the last chunk
+    size_t chunk = (count + threads - 1) / threads;
+    chunk = (chunk + alignment - 1) / alignment * alignment;
+
+    runOnAll([&](int threadIndex) {
+        size_t begin = (size_t)threadIndex * chunk;
+        if (begin >= count) return;
+        size_t end = std::min(count, begin + chunk);
+        body(begin, end);
+    });
+}
@@ -0,0 +1,294 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/Upscaler.h"
+
+// SpatialUpscaler implementation
+bool SpatialUpscaler::initialize(int width, int height) {
+    outputWidth = width;
+    outputHeight = height;
+
+    // Both passes draw the screen quad, so they share pixelate.vert
+    upscaleProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/upscale_easu.frag");
+    sharpenProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/sharpen_cas.frag");
+    if (!upscaleProgram || !sharpenProgram) return false;
+
+    checkGLError("Spatial upscaler initialization");
+    std::cout << "[UPSCALE] Spatial upscaler ready (" << outputWidth << "x" << outputHeight << " output)" << std::endl;
+    return true;
+}
+
+RenderTargetDesc SpatialUpscaler::getTargetDesc() const {
+    RenderTargetDesc desc;
+    desc.width = outputWidth;
+    desc.height = outputHeight;
+    desc.format = GL_RGBA8;
+    desc.filter = GL_NEAREST;  // The sharpening pass reads it texel for texel
+    return desc;
+}
+
+void SpatialUpscaler::upscale(GLuint sourceTexture, int sourceWidth, int sourceHeight, CubeRenderer& renderer) {
+    glDisable(GL_DEPTH_TEST);
+    glViewport(0, 0, outputWidth, outputHeight);
+    glUseProgram(upscaleProgram);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, sourceTexture);
+    glUniform1i(glGetUniformLocation(upscaleProgram, "sourceTexture"), 0);
+    glUniform2f(glGetUniformLocation(upscaleProgram, "sourceSize"), (float)sourceWidth, (float)sourceHeight);
+    renderer.renderScreenQuad();
+    glEnable(GL_DEPTH_TEST);
+}
+
+void SpatialUpscaler::sharpen(GLuint sourceTexture, float sharpness, CubeRenderer& renderer) {
+    glDisable(GL_DEPTH_TEST);
+    glViewport(0, 0, outputWidth, outputHeight);
+    glUseProgram(sharpenProgram);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, sourceTexture);
+    glUniform1i(glGetUniformLocation(sharpenProgram, "sourceTexture"), 0);
+    glUniform1f(glGetUniformLocation(sharpenProgram, "sharpness"), sharpness);
+    renderer.renderScreenQuad();
+    glEnable(GL_DEPTH_TEST);
+}
+
+void SpatialUpscaler::watch(ShaderHotReloader& reloader) {
+    reloader.watch(&upscaleProgram, "shaders/pixelate.vert", "shaders/upscale_easu.frag");
+    reloader.watch(&sharpenProgram, "shaders/pixelate.vert", "shaders/sharpen_cas.frag");
+}
+
+void SpatialUpscaler::cleanup() {
+    if (upscaleProgram) glDeleteProgram(upscaleProgram);
+    if (sharpenProgram) glDeleteProgram(sharpenProgram);
+    upscaleProgram = sharpenProgram = 0;
+}
+
+// TemporalUpsampler implementation
+bool TemporalUpsampler::initialize(int width, int height) {
+    outputWidth = width;
+    outputHeight = height;
+
+    resolveProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/temporal_resolve.frag");
+    if (!resolveProgram) return false;
+
+    // Half floats so the slow exponential blend does not band
+    glGenFramebuffers(2, historyFramebuffers);
+    glGenTextures(2, historyTextures);
+    for (int i = 0; i < 2; i++) {
+        glBindFramebuffer(GL_FRAMEBUFFER, historyFramebuffers[i]);
+        glBindTexture(GL_TEXTURE_2D, historyTextures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, outputWidth, outputHeight, 0, GL_RGBA, GL_HALF_FLOAT, NULL);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, historyTextures[i], 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "[TEMPORAL] History target " << i << " is not complete!" << std::endl;
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            return false;
+        }
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    checkGLError("Temporal upsampler initialization");
+    std::cout << "[TEMPORAL] Temporal upsampler ready (" << outputWidth << "x" << outputHeight
+              << " history, " << kJitterPhases << " jitter phases)" << std::endl;
+    return true;
+}
+
+static float haltonSequence(unsigned int index, unsigned int base) {
+    float result = 0.0f;
+    float fraction = 1.0f;
+    while (index > 0) {
+        fraction /= base;
+        result += fraction * (index % base);
+        index /= base;
+    }
+    return result;
+}
+
+glm::vec2 TemporalUpsampler::nextJitter() {
+    // Skip index 0, which would put the first sample at the texel corner
+    unsigned int index = jitterIndex % kJitterPhases + 1;
+    jitterIndex++;
+    return glm::vec2(haltonSequence(index, 2) - 0.5f, haltonSequence(index, 3) - 0.5f);
+}
+
+glm::mat4 TemporalUpsampler::jitterProjection(const glm::mat4& projection, glm::vec2 jitter,
+                                              int renderWidth, int renderHeight) {
+    glm::vec3 offset(2.0f * jitter.x / renderWidth, 2.0f * jitter.y / renderHeight, 0.0f);
+    return glm::translate(glm::mat4(1.0f), offset) * projection;
+}
+
+void TemporalUpsampler::resolve(GLuint colorTexture, GLuint velocityTexture, int sourceWidth, int sourceHeight,
+                                glm::vec2 jitter, GLuint targetFramebuffer, CubeRenderer& renderer) {
+    // History from another tier was accumulated from a different source resolution
+    if (sourceWidth != historySourceWidth || sourceHeight != historySourceHeight) {
+        historyValid = false;
+        historySourceWidth = sourceWidth;
+        historySourceHeight = sourceHeight;
+    }
+
+    int writeIndex = 1 - historyIndex;
+    glBindFramebuffer(GL_FRAMEBUFFER, historyFramebuffers[writeIndex]);
+    glViewport(0, 0, outputWidth, outputHeight);
+    glDisable(GL_DEPTH_TEST);
+
+    glUseProgram(resolveProgram);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, velocityTexture);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, historyTextures[historyIndex]);
+    glUniform1i(glGetUniformLocation(resolveProgram, "currentColor"), 0);
+    glUniform1i(glGetUniformLocation(resolveProgram, "velocityTexture"), 1);
+    glUniform1i(glGetUniformLocation(resolveProgram, "historyTexture"), 2);
+    glUniform2f(glGetUniformLocation(resolveProgram, "renderSize"), (float)sourceWidth, (float)sourceHeight);
+    glUniform2f(glGetUniformLocation(resolveProgram, "jitter"), jitter.x, jitter.y);
+    glUniform1i(glGetUniformLocation(resolveProgram, "historyValid"), historyValid ? 1 : 0);
+    renderer.renderScreenQuad();
+    glActiveTexture(GL_TEXTURE0);
+
+    // Present the resolve; it stays in the history for the next frame
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, historyFramebuffers[writeIndex]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, targetFramebuffer);
+    glBlitFramebuffer(0, 0, outputWidth, outputHeight, 0, 0, outputWidth, outputHeight,
+                      GL_COLOR_BUFFER_BIT, GL_NEAREST);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glEnable(GL_DEPTH_TEST);
+
+    historyIndex = writeIndex;
+    historyValid = true;
+}
+
+void TemporalUpsampler::watch(ShaderHotReloader& reloader) {
+    reloader.watch(&resolveProgram, "shaders/pixelate.vert", "shaders/temporal_resolve.frag");
+}
+
+void TemporalUpsampler::cleanup() {
+    if (resolveProgram) glDeleteProgram(resolveProgram);
+    if (historyFramebuffers[0]) glDeleteFramebuffers(2, historyFramebuffers);
+    if (historyTextures[0]) glDeleteTextures(2, historyTextures);
+    resolveProgram = 0;
+    historyFramebuffers[0] = historyFramebuffers[1] = 0;
+    historyTextures[0] = historyTextures[1] = 0;
+}
+
+// CheckerboardRenderer implementation
+bool CheckerboardRenderer::initialize(int targetWidth, int targetHeight) {
+    width = targetWidth;
+    height = targetHeight;
+
+    maskProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/checkerboard_mask.frag");
+    resolveProgram = ShaderManager::createShaderProgram("shaders/pixelate.vert", "shaders/checkerboard_resolve.frag");
+    if (!maskProgram || !resolveProgram) return false;
+
+    glGenFramebuffers(2, resolvedFramebuffers);
+    glGenTextures(2, resolvedTextures);
+    for (int i = 0; i < 2; i++) {
+        glBindFramebuffer(GL_FRAMEBUFFER, resolvedFramebuffers[i]);
+        glBindTexture(GL_TEXTURE_2D, resolvedTextures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+        // Linear like the quality FBOs, which the present passes expect
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, resolvedTextures[i], 0);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+            std::cerr << "[CHECKERBOARD] Resolve target " << i << " is not complete!" << std::endl;
+            glBindFramebuffer(GL_FRAMEBUFFER, 0);
+            return false;
+        }
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    checkGLError("Checkerboard renderer initialization");
+    std::cout << "[CHECKERBOARD] Checkerboard renderer ready (" << width << "x" << height << ")" << std::endl;
+    return true;
+}
+
+void CheckerboardRenderer::resize(int targetWidth, int targetHeight) {
+    if (targetWidth == width && targetHeight == height) return;
+    width = targetWidth;
+    height = targetHeight;
+    for (int i = 0; i < 2; i++) {
+        glBindTexture(GL_TEXTURE_2D, resolvedTextures[i]);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, NULL);
+    }
+    historyValid = false;
+    maskedFramebuffer = 0;
+    checkGLError("Checkerboard resize");
+}
+
+void CheckerboardRenderer::beginFrame(GLuint framebuffer, CubeRenderer& renderer) {
+    glEnable(GL_STENCIL_TEST);
+    if (maskedFramebuffer != framebuffer) {
+        // One-time pattern: clear to 2, then stamp 1 on the even cells
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glDisable(GL_DEPTH_TEST);
+        glClearStencil(2);
+        glClear(GL_STENCIL_BUFFER_BIT);
+        glStencilFunc(GL_ALWAYS, 1, 0xFF);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_REPLACE);
+        glUseProgram(maskProgram);
+        renderer.renderScreenQuad();
+        glEnable(GL_DEPTH_TEST);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glClearStencil(0);
+        maskedFramebuffer = framebuffer;
+    }
+
+    parity = frameIndex & 1;
+    frameIndex++;
+    glStencilFunc(GL_EQUAL, 1 + parity, 0xFF);
+    glStencilOp(GL_KEEP, GL_KEEP, GL_KEEP);
+}
+
+void CheckerboardRenderer::endFrame() {
+    glDisable(GL_STENCIL_TEST);
+}
+
+GLuint CheckerboardRenderer::resolve(GLuint colorTexture, GLuint velocityTexture, CubeRenderer& renderer) {
+    int writeIndex = 1 - resolvedIndex;
+    glBindFramebuffer(GL_FRAMEBUFFER, resolvedFramebuffers[writeIndex]);
+    glViewport(0, 0, width, height);
+    glDisable(GL_DEPTH_TEST);
+
+    glUseProgram(resolveProgram);
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, colorTexture);
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, velocityTexture);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, resolvedTextures[resolvedIndex]);
+    glUniform1i(glGetUniformLocation(resolveProgram, "currentColor"), 0);
+    glUniform1i(glGetUniformLocation(resolveProgram, "velocityTexture"), 1);
+    glUniform1i(glGetUniformLocation(resolveProgram, "historyTexture"), 2);
+    glUniform1i(glGetUniformLocation(resolveProgram, "parity"), parity);
+    glUniform1i(glGetUniformLocation(resolveProgram, "historyValid"), historyValid ? 1 : 0);
+    renderer.renderScreenQuad();
+    glActiveTexture(GL_TEXTURE0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glEnable(GL_DEPTH_TEST);
+
+    resolvedIndex = writeIndex;
+    historyValid = true;
+    return resolvedTextures[resolvedIndex];
+}
+
+void CheckerboardRenderer::watch(ShaderHotReloader& reloader) {
+    reloader.watch(&maskProgram, "shaders/pixelate.vert", "shaders/checkerboard_mask.frag");
+    reloader.watch(&resolveProgram, "shaders/pixelate.vert", "shaders/checkerboard_resolve.frag");
+}
+
+void CheckerboardRenderer::cleanup() {
+    if (maskProgram) glDeleteProgram(maskProgram);
+    if (resolveProgram) glDeleteProgram(resolveProgram);
+    if (resolvedFramebuffers[0]) glDeleteFramebuffers(2, resolvedFramebuffers);
+    if (resolvedTextures[0]) glDeleteTextures(2, resolvedTextures);
+    maskProgram = resolveProgram = 0;
+    resolvedFramebuffers[0] = resolvedFramebuffers[1] = 0;
+    resolvedTextures[0] = resolvedTextures[1] = 0;
+    maskedFramebuffer = 0;
+}
@@ -0,0 +1,237 @@
+#include "../include/FuzzyCubeApp.h"
+#include "../include/VertexFormat.h"
+#include "../include/HeadlessContext.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+
+// VertexPacking implementation
+uint16_t VertexPacking::floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    uint32_t sign = (bits >> 16) & 0x8000u;
+    uint32_t exponent = (bits >> 23) & 0xffu;
+    uint32_t mantissa = bits & 0x7fffffu;
+
+    if (exponent == 0xffu) {
+        return (uint16_t)(sign | 0x7c00u | (mantissa ? 0x200u : 0u));  // Inf / NaN
+    }
+    int halfExponent = (int)exponent - 127 + 15;
+    if (halfExponent >= 31) {
+        return (uint16_t)(sign | 0x7c00u);  // Overflow to infinity
+    }
+    if (halfExponent <= 0) {
+        // Half denormal (or zero): shift in the implicit leading one
+        if (halfExponent < -10) return (uint16_t)sign;
+        mantissa |= 0x800000u;
+        int shift = 14 - halfExponent;
+        uint32_t half = mantissa >> shift;
+        uint32_t remainder = mantissa & ((1u << shift) - 1u);
+        uint32_t halfway = 1u << (shift - 1);
+        if (remainder > halfway || (remainder == halfway && (half & 1u))) half++;
+        return (uint16_t)(sign | half);
+    }
+
+    uint32_t half = ((uint32_t)halfExponent << 10) | (mantissa >> 13);
+    uint32_t remainder = mantissa & 0x1fffu;
+    // Round to nearest even; a carry into the exponent is the correct result
+    if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) half++;
+    return (uint16_t)(sign | half);
+}
+
+float VertexPacking::halfToFloat(uint16_t value) {
+    uint32_t sign = (uint32_t)(value & 0x8000u) << 16;
+    uint32_t exponent = (value >> 10) & 0x1fu;
+    uint32_t mantissa = value & 0x3ffu;
+    uint32_t bits;
+
+    if (exponent == 0) {
+        if (mantissa == 0) {
+            bits = sign;
+        } else {
+            // Renormalize the denormal
+            exponent = 127 - 15 + 1;
+            while (!(mantissa & 0x400u)) {
+                mantissa <<= 1;
+                exponent--;
+            }
+            bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+        }
+    } else if (exponent == 31) {
+        bits = sign | 0x7f800000u | (mantissa << 13);
+    } else {
+        bits = sign | ((exponent - 15 + 127) << 23) | (mantissa << 13);
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+uint32_t VertexPacking::packSnorm2101010(const glm::vec3& normal) {
+    auto component = [](float v) {
+        float clamped = std::min(std::max(v, -1.0f), 1.0f);
+        return (uint32_t)((int32_t)std::round(clamped * 511.0f) & 0x3ff);
+    };
+    // x in the low bits (the _REV ordering); w stays 0
+    return component(normal.x) | (component(normal.y) << 10) | (component(normal.z) << 20);
+}
+
+void VertexPacking::packUnorm8x4(const glm::vec3& color, float alpha, uint8_t out[4]) {
+    const float channels[4] = {color.x, color.y, color.z, alpha};
+    for (int i = 0; i < 4; i++) {
+        out[i] = (uint8_t)std::round(std::min(std::max(channels[i], 0.0f), 1.0f) * 255.0f);
+    }
+}
+
+PackedVertex VertexPacking::pack(const glm::vec3& position, const glm::vec3& normal, const glm::vec3& color) {
+    PackedVertex vertex;
+    vertex.position[0] = floatToHalf(position.x);
+    vertex.position[1] = floatToHalf(position.y);
+    vertex.position[2] = floatToHalf(position.z);
+    vertex.position[3] = floatToHalf(1.0f);
+    vertex.normal = packSnorm2101010(normal);
+    packUnorm8x4(color, 1.0f, vertex.color);
+    return vertex;
+}
+
+std::vector<PackedVertex> VertexPacking::packInterleaved(const float* data, size_t vertexCount) {
+    std::vector<PackedVertex> packed(vertexCount);
+    for (size_t i = 0; i < vertexCount; i++) {
+        const float* v = data + i * 9;
+        packed[i] = pack(glm::vec3(v[0], v[1], v[2]), glm::vec3(v[3], v[4], v[5]), glm::vec3(v[6], v[7], v[8]));
+    }
+    return packed;
+}
+
+std::vector<PackedVertex> VertexPacking::packMesh(const std::vector<MeshVertex>& vertices) {
+    std::vector<PackedVertex> packed(vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        packed[i] = pack(vertices[i].position, vertices[i].normal, vertices[i].color);
+    }
+    return packed;
+}
+
+void VertexPacking::setupPackedAttributes() {
+    // Position attribute
+    glVertexAttribPointer(0, 3, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, position));
+    glEnableVertexAttribArray(0);
+    // Normal attribute (packed formats must be fetched with size 4; the shaders ignore w)
+    glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, normal));
+    glEnableVertexAttribArray(1);
+    // Color attribute
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(PackedVertex), (void*)offsetof(PackedVertex, color));
+    glEnableVertexAttribArray(2);
+}
+
+void VertexPacking::setupFloatAttributes() {
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, 9 * sizeof(float), (void*)(6 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+}
+
+int VertexPacking::runBandwidthBenchmark(int instanceCount) {
+    const int kWarmupFrames = 3;
+    const int kFrames = 20;
+    const int kTargetSize = 64;
+
+    std::cout << "[BENCH] Vertex format bandwidth: rounded cube x " << instanceCount << " instances" << std::endl;
+    HeadlessContext context;
+    if (!context.create("Vertex format benchmark", "[BENCH]")) return 1;
+
+    // Same preparation as the LOD chain's full-detail level
+    MeshData mesh = MeshBuilder::generateRoundedCube(48, 0.3f);
+    MeshOptimizer::optimizeVertexCache(mesh.indices, mesh.vertices.size());
+    std::vector<PackedVertex> packed = packMesh(mesh.vertices);
+
+    float maxPositionError = 0.0f, maxNormalError = 0.0f;
+    for (size_t i = 0; i < mesh.vertices.size(); i++) {
+        for (int k = 0; k < 3; k++) {
+            maxPositionError = std::max(maxPositionError,
+                std::abs(halfToFloat(packed[i].position[k]) - mesh.vertices[i].position[k]));
+        }
+        glm::vec3 normal;
+        for (int k = 0; k < 3; k++) {
+            int32_t component = (int32_t)((packed[i].normal >> (10 * k)) & 0x3ffu);
+            if (component & 0x200) component -= 0x400;  // Sign-extend 10 bits
+            normal[k] = std::max(component / 511.0f, -1.0f);
+        }
+        float cosine = glm::dot(glm::normalize(normal), mesh.vertices[i].normal);
+        maxNormalError = std::max(maxNormalError, std::acos(std::min(cosine, 1.0f)));
+    }
+    std::cout << "[BENCH] Quantization: max position error " << maxPositionError
+              << ", max normal error " << glm::degrees(maxNormalError) << " deg" << std::endl;
+
+    // A tiny target keeps fragment work negligible so vertex fetch + shading dominates
+    context.createTarget(kTargetSize);
+
+    std::vector<InstanceData> instances = InstanceTransforms::build(CubeData::generateInstanceField(instanceCount, 1337u), true);
+    GLuint instanceBuffer, indexBuffer;
+    glGenBuffers(1, &instanceBuffer);
+    glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+    glBufferData(GL_ARRAY_BUFFER, instances.size() * sizeof(InstanceData), instances.data(), GL_STATIC_DRAW);
+    glGenBuffers(1, &indexBuffer);
+
+    GLuint program = ShaderManager::createShaderProgram("shaders/cube.vert", "shaders/cube.frag",
+        ShaderFeature::toDefines(ShaderFeature::VertexColors | ShaderFeature::Instanced));
+    glUseProgram(program);
+    glm::mat4 model(1.0f);
+    glm::mat4 view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.0f), glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    glm::mat4 projection = glm::perspective(glm::radians(45.0f), 1.0f, 0.1f, 100.0f);
+    glUniformMatrix4fv(glGetUniformLocation(program, "model"), 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(glGetUniformLocation(program, "view"), 1, GL_FALSE, glm::value_ptr(view));
+    glUniformMatrix4fv(glGetUniformLocation(program, "projection"), 1, GL_FALSE, glm::value_ptr(projection));
+
+    struct Variant { const char* name; const void* data; size_t stride; bool packedLayout; };
+    const Variant variants[] = {
+        {"9 x float", mesh.vertices.data(), sizeof(MeshVertex), false},
+        {"packed   ", packed.data(), sizeof(PackedVertex), true},
+    };
+
+    double baselineMs = 0.0;
+    for (const Variant& variant : variants) {
+        GLuint vao, vbo;
+        glGenVertexArrays(1, &vao);
+        glBindVertexArray(vao);
+        glGenBuffers(1, &vbo);
+        glBindBuffer(GL_ARRAY_BUFFER, vbo);
+        glBufferData(GL_ARRAY_BUFFER, mesh.vertices.size() * variant.stride, variant.data, GL_STATIC_DRAW);
+        if (variant.packedLayout) {
+            setupPackedAttributes();
+        } else {
+            setupFloatAttributes();
+        }
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.indices.size() * sizeof(uint32_t), mesh.indices.data(), GL_STATIC_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, instanceBuffer);
+        InstanceTransforms::setupAttributes();
+
+        double medianMs = context.timeMedianMs([&]() {
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            glDrawElementsInstanced(GL_TRIANGLES, (GLsizei)mesh.indices.size(), GL_UNSIGNED_INT, 0, instanceCount);
+        }, kWarmupFrames, kFrames);
+        checkGLError("Vertex format benchmark draw");
+        if (baselineMs == 0.0) baselineMs = medianMs;
+
+        // Every instance re-reads the whole vertex buffer (post-transform cache hits aside)
+        double bytesPerFrame = (double)mesh.vertices.size() * variant.stride * instanceCount;
+        std::cout << "[BENCH]   " << variant.name << " (" << variant.stride << " B/vertex): "
+                  << std::fixed << std::setprecision(3) << medianMs << " ms/frame GPU, "
+                  << std::setprecision(1) << bytesPerFrame / (1024.0 * 1024.0) << " MiB vertex data/frame, "
+                  << std::setprecision(2) << (bytesPerFrame / 1.0e9) / (medianMs / 1000.0) << " GB/s, "
+                  << std::setprecision(0) << 100.0 * medianMs / baselineMs << "% of float time" << std::endl;
+
+        glBindVertexArray(0);
+        glDeleteVertexArrays(1, &vao);
+        glDeleteBuffers(1, &vbo);
+    }
+
+    glDeleteProgram(program);
+    glDeleteBuffers(1, &instanceBuffer);
+    glDeleteBuffers(1, &indexBuffer);
+    return 0;
+}
@@ -1,7 +1,35 @@
 #include "../include/FuzzyCubeApp.h"
 #include <cstring>
+#include <cstdlib>
+#include <cctype>
+#include <climits>
+
+// Reads the optional count after the option at argv[i] into 'count' (which holds the
+// default). A '-' followed by a digit is taken as a (negative) count rather than the next
+// option, so it is rejected instead of ignored. Prints a usage error unless the count is a
+// positive integer.
+static bool parseCount(int argc, char* argv[], int& i, int& count) {
+    const char* option = argv[i];
+    const char* text = nullptr;
+    if (i + 1 < argc && (argv[i + 1][0] != '-' || std::isdigit((unsigned char)argv[i + 1][1]))) {
+        text = argv[++i];
+        char* end = nullptr;
+        long value = std::strtol(text, &end, 10);
+        count = end != text && *end == '\0' && value <= INT_MAX ? (int)value : 0;
+    }
+    if (count > 0) return true;
+    std::cerr << option << " needs a positive count" << (text ? std::string(", got '") + text + "'" : "") << std::endl;
+    std::cerr << "Use --help for usage information" << std::endl;
+    return false;
+}
 
 int main(int argc, char* argv[]) {
+    FuzzyCubeApp app;
+    std::string goldenDirectory;  // Non-empty: run the golden-image tests instead of the app
+    bool goldenUpdate = false;
+    bool calibrateOnly = false;  // Measure the quality knob costs, save them and exit
+    bool benchTierSwitch = false;  // Tier switch spikes without and with the startup warm-up
+    
     // Parse command-line arguments
     for (int i = 1; i < argc; i++) {
         if (std::strcmp(argv[i], "--verbose") == 0 || std::strcmp(argv[i], "-v") == 0) {
@@ -12,14 +40,142 @@ int main(int argc, char* argv[]) {
             std::cout << "Usage: " << argv[0] << " [OPTIONS]\n\n";
             std::cout << "Options:\n";
             std::cout << "  -v, --verbose    Enable verbose debug output\n";
-            std::cout << "  -h, --help       Show this help message\n\n";
+            std::cout << "  -h, --help       Show this help message\n";
+            std::cout << "  --bench-cull [N] Run the frustum culling microbenchmark on N instances and exit\n";
+            std::cout << "  --verify-gpu-cull [N]  Compare compute-shader culling with the CPU culler and exit\n";
+            std::cout << "  --gl33           Force a 3.3 context (disables the GL 4.3 GPU culling path)\n";
+            std::cout << "  --mesh <file>    Load an OBJ as the LOD mesh instead of the generated rounded cube\n";
+            std::cout << "  --bench-vertex [N]  Compare float vs packed vertex fetch on N mesh instances and exit\n";
+            std::cout << "  --bench-normal-matrix [N]  Time CPU normal matrices and the vertex-stage savings on N instances, then exit\n";
+            std::cout << "  --upscale           Present with the spatial upscaler + CAS instead of pixelation\n";
+            std::cout << "  --tiers <file>      Read the quality tiers from file (default quality_tiers.cfg)\n";
+            std::cout << "  --temporal          Enable temporal upsampling on every tier below full resolution\n";
+            std::cout << "  --msaa              Render each tier into its multisampled FBO (the tier's msaa samples)\n";
+            std::cout << "  --no-checkerboard   Render the medium tier at full density instead of checkerboarded\n";
+            std::cout << "  --quality-vector [power|frametime]  Solve independent quality knobs within the controller's budget (default power)\n";
+            std::cout << "  --calibrate         Measure this GPU's quality knob costs at startup (saved to quality_costs.txt)\n";
+            std::cout << "  --calibrate-only    Measure and save the knob costs headless, then exit\n";
+            std::cout << "  --fps <N>           Frame rate target of the pacer (0 = unlimited, default 60)\n";
+            std::cout << "  --vsync <mode>      Swap interval: off (default), on or adaptive\n";
+            std::cout << "  --frames-in-flight <N>  Frames the CPU may queue ahead of the GPU (1-4, default 2)\n";
+            std::cout << "  --golden [dir]      Render the golden scenarios headless and compare with dir (default golden/)\n";
+            std::cout << "  --golden-update [dir]  Re-record the golden images\n";
+            std::cout << "  --bench-image-diff [N]  Time N image comparisons per diff variant and exit\n";
+            std::cout << "  --capture <path>    Record frames: a directory of PNGs, or a .y4m file\n";
+            std::cout << "  --capture-source <s>  presented (default) or a tier name (that tier's FBO)\n";
+            std::cout << "  --on-demand [Hz]    Only redraw on input or state changes; wake Hz times a second (default 4) for the controller\n";
+            std::cout << "  --no-shader-cache   Always compile shaders from source (skip .shader_cache/)\n";
+            std::cout << "  --no-hot-reload     Do not watch shaders/ for edits\n";
+            std::cout << "  --bench-shader-cache  Time program creation with the binary cache off, cold and warm, and exit\n";
+            std::cout << "  --no-shadows        Skip the shadow-map pass on every tier\n";
+            std::cout << "  --no-post           Skip the post-processing chain on every tier\n";
+            std::cout << "  --no-prewarm        Skip drawing every tier's pipeline states once at startup\n";
+            std::cout << "  --bench-tier-switch  Measure the worst frame spike on forced tier switches without and with warm-up, and exit\n\n";
             std::cout << "Controls:\n";
             std::cout << "  0  - Auto quality mode (fuzzy logic)\n";
-            std::cout << "  1  - Force low quality\n";
-            std::cout << "  2  - Force medium quality\n";
-            std::cout << "  3  - Force high quality\n";
+            std::cout << "  1-9 - Force quality tier N, lowest first (or that tier's budget with --quality-vector)\n";
+            std::cout << "  M  - Toggle MSAA on the quality FBOs\n";
             std::cout << "  ESC - Exit application\n";
             return 0;
+        } else if (std::strcmp(argv[i], "--bench-cull") == 0) {
+            // CPU-only benchmark: no Python, window or GL context needed
+            int count = 1000000;
+            if (!parseCount(argc, argv, i, count)) return 1;
+            return FrustumCuller::runBenchmark(CubeData::generateInstanceField(count, 1337u));
+        } else if (std::strcmp(argv[i], "--verify-gpu-cull") == 0) {
+            // Headless; run with LIBGL_ALWAYS_SOFTWARE=1 to validate on Mesa llvmpipe
+            int count = 100000;
+            if (!parseCount(argc, argv, i, count)) return 1;
+            return GpuCuller::runSelfTest(count);
+        } else if (std::strcmp(argv[i], "--bench-vertex") == 0) {
+            // Headless GPU benchmark, like --verify-gpu-cull
+            int count = 200;
+            if (!parseCount(argc, argv, i, count)) return 1;
+            return VertexPacking::runBandwidthBenchmark(count);
+        } else if (std::strcmp(argv[i], "--bench-normal-matrix") == 0) {
+            // Headless, like --bench-vertex
+            int count = 200;
+            if (!parseCount(argc, argv, i, count)) return 1;
+            return InstanceTransforms::runBenchmark(count);
+        } else if (std::strcmp(argv[i], "--upscale") == 0) {
+            app.setPresentMode(PresentMode::SpatialUpscale);
+        } else if (std::strcmp(argv[i], "--temporal") == 0) {
+            app.setTemporalUpsampling(true);
+        } else if (std::strcmp(argv[i], "--tiers") == 0 && i + 1 < argc) {
+            app.setTiersPath(argv[++i]);
+        } else if (std::strcmp(argv[i], "--msaa") == 0) {
+            app.setMsaaEnabled(true);
+        } else if (std::strcmp(argv[i], "--quality-vector") == 0) {
+            BudgetMode mode = BudgetMode::Power;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                mode = std::strcmp(argv[++i], "frametime") == 0 ? BudgetMode::FrameTime : BudgetMode::Power;
+            }
+            app.setQualityVector(true, mode);
+        } else if (std::strcmp(argv[i], "--calibrate") == 0) {
+            app.setCalibrateOnStartup(true);
+        } else if (std::strcmp(argv[i], "--calibrate-only") == 0) {
+            calibrateOnly = true;
+            app.setHeadless(true);
+        } else if (std::strcmp(argv[i], "--no-checkerboard") == 0) {
+            app.setCheckerboardRendering(false);
+        } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            app.setTargetFps((float)std::atof(argv[++i]));
+        } else if (std::strcmp(argv[i], "--vsync") == 0 && i + 1 < argc) {
+            const char* mode = argv[++i];
+            if (std::strcmp(mode, "on") == 0) {
+                app.setSwapMode(FramePacer::SwapMode::VSync);
+            } else if (std::strcmp(mode, "adaptive") == 0) {
+                app.setSwapMode(FramePacer::SwapMode::Adaptive);
+            } else {
+                app.setSwapMode(FramePacer::SwapMode::Off);
+            }
+        } else if (std::strcmp(argv[i], "--frames-in-flight") == 0 && i + 1 < argc) {
+            app.setFramesInFlight(std::atoi(argv[++i]));
+        } else if (std::strcmp(argv[i], "--golden") == 0 || std::strcmp(argv[i], "--golden-update") == 0) {
+            goldenUpdate = std::strcmp(argv[i], "--golden-update") == 0;
+            goldenDirectory = "golden";
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                goldenDirectory = argv[++i];
+            }
+            app.setHeadless(true);
+        } else if (std::strcmp(argv[i], "--bench-image-diff") == 0) {
+            // Headless, like --bench-cull
+            int count = 1000;
+            if (!parseCount(argc, argv, i, count)) return 1;
+            return ImageDiff::runBenchmark(count);
+        } else if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            app.setCapturePath(argv[++i]);
+        } else if (std::strcmp(argv[i], "--capture-source") == 0 && i + 1 < argc) {
+            // Resolved against the tier registry once it is loaded
+            app.setCaptureSource(argv[++i]);
+        } else if (std::strcmp(argv[i], "--on-demand") == 0) {
+            float wakeRate = 4.0f;
+            if (i + 1 < argc && argv[i + 1][0] != '-') {
+                wakeRate = (float)std::atof(argv[++i]);
+            }
+            app.setRenderOnDemand(true, wakeRate);
+        } else if (std::strcmp(argv[i], "--no-shader-cache") == 0) {
+            ShaderManager::setProgramCacheEnabled(false);
+        } else if (std::strcmp(argv[i], "--no-hot-reload") == 0) {
+            app.setShaderHotReload(false);
+        } else if (std::strcmp(argv[i], "--no-shadows") == 0) {
+            app.setShadows(false);
+        } else if (std::strcmp(argv[i], "--no-post") == 0) {
+            app.setPostEffects(false);
+        } else if (std::strcmp(argv[i], "--no-prewarm") == 0) {
+            app.setPrewarm(false);
+        } else if (std::strcmp(argv[i], "--bench-tier-switch") == 0) {
+            // Needs the whole app, so it runs after initialize (which must not warm up first)
+            benchTierSwitch = true;
+            app.setPrewarm(false);
+            app.setShaderHotReload(false);
+            app.setHeadless(true);
+        } else if (std::strcmp(argv[i], "--bench-shader-cache") == 0) {
+            return FuzzyCubeApp::runShaderCacheBenchmark();
+        } else if (std::strcmp(argv[i], "--gl33") == 0) {
+            app.setPreferGL43(false);
+        } else if (std::strcmp(argv[i], "--mesh") == 0 && i + 1 < argc) {
+            app.setMeshPath(argv[++i]);
         } else {
             std::cerr << "Unknown option: " << argv[i] << std::endl;
             std::cerr << "Use --help for usage information" << std::endl;
@@ -27,13 +183,29 @@ int main(int argc, char* argv[]) {
         }
     }
     
-    FuzzyCubeApp app;
-    
     if (!app.initialize()) {
         std::cerr << "Failed to initialize application" << std::endl;
         return -1;
     }
     
+    if (benchTierSwitch) {
+        int result = app.runTierSwitchBenchmark();
+        app.cleanup();
+        return result;
+    }
+    
+    if (calibrateOnly) {
+        bool calibrated = app.calibrateQualityCosts();
+        app.cleanup();
+        return calibrated ? 0 : 1;
+    }
+    
+    if (!goldenDirectory.empty()) {
+        int failures = app.runGoldenTests(goldenDirectory, goldenUpdate);
+        app.cleanup();
+        return failures ? 1 : 0;
+    }
+    
     app.run();
     app.cleanup();
     